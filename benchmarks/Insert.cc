@@ -1,5 +1,8 @@
 #include <benchmark/benchmark.h>
 
+#include <filesystem>
+#include <mutex>
+#include <thread>
 #include <unordered_set>
 
 #include "Utils.h"
@@ -42,6 +45,11 @@ public:
         return m_spaceBoxList;
     }
 
+    static space::Rect<TCrt> SpaceWorldExtent() noexcept
+    {
+        return space::Rect<TCrt> {{0, 0}, s_maxPos + s_maxRectWidth, s_maxPos + s_maxRectHeight};
+    }
+
 private:
 
     DataStorage()
@@ -74,14 +82,16 @@ static void BoostSpaceIndexInsert(benchmark::State& state)
     const auto& boxList = DataStorage::Instance().BoostBoxList();
     const auto count = state.range(0);
 
-    boost::geometry::index::rtree<value, boost::geometry::index::quadratic<16>> rtree;
     for (auto _ : state)
     {
+        boost::geometry::index::rtree<value, boost::geometry::index::quadratic<16>> rtree;
         for (int i = 0; i < count; ++i)
         {
             rtree.insert(std::make_pair(boxList[i], 0));
         }
+        benchmark::DoNotOptimize(rtree.size());
     }
+    state.SetItemsProcessed(state.iterations() * count);
 }
 // Register the function as a benchmark
 BENCHMARK(BoostSpaceIndexInsert)->Range(512, s_testCount);
@@ -91,19 +101,252 @@ static void SpaceQuadTreeInsert(benchmark::State& state)
     const auto& boxList = DataStorage::Instance().SpaceBoxList();
     const auto count = state.range(0);
 
-    space::QuadTree<space::Rect<TCrt>> quadTree;
     for (auto _ : state)
     {
+        space::QuadTree<space::Rect<TCrt>> quadTree;
         for (int i = 0; i < count; ++i)
         {
             quadTree.insert(boxList[i]);
         }
+        benchmark::DoNotOptimize(quadTree.size());
     }
+    state.SetItemsProcessed(state.iterations() * count);
 }
 // Register the function as a benchmark
 BENCHMARK(SpaceQuadTreeInsert)->Range(512, s_testCount);
 
+static void SpaceLooseQuadTreeInsert(benchmark::State& state)
+{
+    const auto& boxList = DataStorage::Instance().SpaceBoxList();
+    const auto count = state.range(0);
+
+    for (auto _ : state)
+    {
+        space::QuadTree<space::Rect<TCrt>, space::LooseQuadTreePolicy> quadTree;
+        for (int i = 0; i < count; ++i)
+        {
+            quadTree.insert(boxList[i]);
+        }
+        benchmark::DoNotOptimize(quadTree.size());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+// Register the function as a benchmark
+BENCHMARK(SpaceLooseQuadTreeInsert)->Range(512, s_testCount);
+
+static void SpaceQuadTreeBulkLoad(benchmark::State& state)
+{
+    const auto& boxList = DataStorage::Instance().SpaceBoxList();
+    const auto count = static_cast<size_t>(state.range(0));
+
+    for (auto _ : state)
+    {
+        space::QuadTree<space::Rect<TCrt>> quadTree;
+        quadTree.bulkLoad(std::span {boxList}.first(count));
+        benchmark::DoNotOptimize(quadTree.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(SpaceQuadTreeBulkLoad)->Range(512, s_testCount);
+
+#ifdef SPACE_HAS_MMAP
+static void SpaceQuadTreeOpenMapped(benchmark::State& state)
+{
+    const auto& boxList = DataStorage::Instance().SpaceBoxList();
+    const auto count = static_cast<size_t>(state.range(0));
+    const auto path = std::filesystem::temp_directory_path() / "space_quadtree_benchmark.snapshot";
+    space::QuadTree<space::Rect<TCrt>> {std::span {boxList}.first(count)}.save(path);
+
+    for (auto _ : state)
+    {
+        const auto quadTree = space::QuadTree<space::Rect<TCrt>>::openMapped(path);
+        benchmark::DoNotOptimize(quadTree.size());
+    }
+    std::filesystem::remove(path);
+}
+// Register the function as a benchmark
+BENCHMARK(SpaceQuadTreeOpenMapped)->Range(512, s_testCount);
+#endif // SPACE_HAS_MMAP
+
+
+
+static std::vector<std::pair<space::Rect<TCrt>, space::Rect<TCrt>>> getMoves(size_t count)
+{
+    const auto& boxList = DataStorage::Instance().SpaceBoxList();
+    std::vector<std::pair<space::Rect<TCrt>, space::Rect<TCrt>>> moves;
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto moved = boxList[i];
+        moved.pos() = space::Point<TCrt> {moved.pos().x() + test_util::rand(-50, 50), moved.pos().y() + test_util::rand(-50, 50)};
+        moves.emplace_back(boxList[i], moved);
+    }
+    return moves;
+}
+
+static void SpaceQuadTreeRemoveInsert(benchmark::State& state)
+{
+    space::QuadTree<space::Rect<TCrt>> quadTree {DataStorage::Instance().SpaceBoxList()};
+    auto moves = getMoves(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        for (auto& [from, to] : moves)
+        {
+            quadTree.remove(from);
+            quadTree.insert(to);
+            std::swap(from, to);
+        }
+    }
+    benchmark::DoNotOptimize(quadTree.size());
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(SpaceQuadTreeRemoveInsert)->Range(512, s_testCount / 8);
 
+static void SpaceQuadTreeUpdate(benchmark::State& state)
+{
+    space::QuadTree<space::Rect<TCrt>> quadTree {DataStorage::Instance().SpaceBoxList()};
+    auto moves = getMoves(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        for (auto& [from, to] : moves)
+        {
+            quadTree.update(from, to);
+            std::swap(from, to);
+        }
+    }
+    benchmark::DoNotOptimize(quadTree.size());
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(SpaceQuadTreeUpdate)->Range(512, s_testCount / 8);
+
+static void SpaceQuadTreeApplyUpdates(benchmark::State& state)
+{
+    space::QuadTree<space::Rect<TCrt>> quadTree {DataStorage::Instance().SpaceBoxList()};
+    auto moves = getMoves(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        quadTree.applyUpdates(moves);
+        for (auto& [from, to] : moves)
+        {
+            std::swap(from, to);
+        }
+    }
+    benchmark::DoNotOptimize(quadTree.size());
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(SpaceQuadTreeApplyUpdates)->Range(512, s_testCount / 8);
+
+static void SpaceQuadTreeCompact(benchmark::State& state)
+{
+    const auto& boxList = DataStorage::Instance().SpaceBoxList();
+    const auto removedCount = static_cast<size_t>(state.range(0));
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        space::QuadTree<space::Rect<TCrt>> quadTree {boxList};
+        for (size_t i = 0; i < removedCount; ++i)
+        {
+            quadTree.remove(boxList[i]);
+        }
+        state.ResumeTiming();
+        quadTree.compact();
+        benchmark::DoNotOptimize(quadTree.nodeCount());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(std::size(boxList) - removedCount));
+}
+// Register the function as a benchmark
+BENCHMARK(SpaceQuadTreeCompact)->Arg(s_testCount / 8)->Arg(s_testCount / 2);
+
+/**
+ * @brief   Inserts the keys by the given number of producer threads, every producer inserts
+ *          the keys of its own part of space (the row of the grid).
+ */
+template <typename TInsert>
+void insertByProducers(const std::vector<space::Rect<TCrt>>& boxList, size_t producerCount, TInsert&& insert)
+{
+    const auto worldHeight = DataStorage::SpaceWorldExtent().height();
+    std::vector<std::thread> producers;
+    for (size_t producer = 0; producer < producerCount; ++producer)
+    {
+        producers.emplace_back([&boxList, &insert, producer, producerCount, worldHeight]()
+        {
+            for (const auto& box : boxList)
+            {
+                if (static_cast<size_t>(box.pos().y()) * producerCount / static_cast<size_t>(worldHeight) == producer)
+                {
+                    insert(box);
+                }
+            }
+        });
+    }
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+}
+
+static void SpaceQuadTreeMutexParallelInsert(benchmark::State& state)
+{
+    const auto& boxList = DataStorage::Instance().SpaceBoxList();
+    const auto producerCount = static_cast<size_t>(state.range(0));
+
+    for (auto _ : state)
+    {
+        space::QuadTree<space::Rect<TCrt>> quadTree {DataStorage::SpaceWorldExtent()};
+        std::mutex mutex;
+        insertByProducers(boxList, producerCount, [&quadTree, &mutex](const auto& box)
+        {
+            const std::lock_guard lock {mutex};
+            quadTree.insert(box);
+        });
+        benchmark::DoNotOptimize(quadTree.size());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(std::size(boxList)));
+}
+// Register the function as a benchmark
+BENCHMARK(SpaceQuadTreeMutexParallelInsert)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+
+static void SpaceShardedQuadTreeParallelInsert(benchmark::State& state)
+{
+    const auto& boxList = DataStorage::Instance().SpaceBoxList();
+    const auto producerCount = static_cast<size_t>(state.range(0));
+
+    for (auto _ : state)
+    {
+        space::ShardedQuadTree<space::Rect<TCrt>, 16> quadTree {DataStorage::SpaceWorldExtent()};
+        insertByProducers(boxList, producerCount, [&quadTree](const auto& box)
+        {
+            quadTree.insert(box);
+        });
+        benchmark::DoNotOptimize(quadTree.size());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(std::size(boxList)));
+}
+// Register the function as a benchmark
+BENCHMARK(SpaceShardedQuadTreeParallelInsert)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+
+static void SpaceShardedQuadTreeBulkLoad(benchmark::State& state)
+{
+    const auto& boxList = DataStorage::Instance().SpaceBoxList();
+    const auto count = static_cast<size_t>(state.range(0));
+
+    for (auto _ : state)
+    {
+        space::ShardedQuadTree<space::Rect<TCrt>, 16> quadTree {DataStorage::SpaceWorldExtent()};
+        quadTree.bulkLoad(std::span {boxList}.first(count));
+        benchmark::DoNotOptimize(quadTree.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Register the function as a benchmark
+BENCHMARK(SpaceShardedQuadTreeBulkLoad)->Range(512, s_testCount)->UseRealTime();
 
 int main(int argc, char** argv)
 {
@@ -0,0 +1,372 @@
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <execution>
+#include <numbers>
+
+#include "Utils.h"
+#include "PolygonLayer.h"
+#include "PreparedPolygon.h"
+
+constexpr auto s_polygonCount = 8 << 13;
+constexpr auto s_queryCount = 8 << 10;
+
+using TCrt = int32_t;
+
+class DataStorage
+{
+    static constexpr auto s_maxPos = 1'000'000;
+    static constexpr auto s_maxRadius = 2'000;
+public:
+    static DataStorage& Instance()
+    {
+        static DataStorage s_instance;
+        return s_instance;
+    }
+
+    DataStorage(DataStorage&&) = delete;
+    DataStorage(const DataStorage&) = delete;
+    DataStorage operator=(DataStorage&&) = delete;
+    DataStorage operator=(const DataStorage&) = delete;
+
+public:
+
+    const auto& Layer() const noexcept
+    {
+        return m_layer;
+    }
+
+    const auto& BoxIndex() const noexcept
+    {
+        return m_boxIndex;
+    }
+
+    const auto& QueryList() const noexcept
+    {
+        return m_queryList;
+    }
+
+private:
+
+    DataStorage()
+    {
+        for (uint32_t id = 0; id < s_polygonCount; ++id)
+        {
+            auto polygon = getRandConvexPolygon();
+            m_boxIndex.insert(space::util::makeIndexable(polygon, id));
+            m_layer.add(std::move(polygon));
+        }
+        for (int i = 0; i < s_queryCount; ++i)
+        {
+            m_queryList.push_back(getRandConvexPolygon());
+        }
+    }
+
+    static space::SimplePolygon<TCrt> getRandConvexPolygon()
+    {
+        const auto center = test_util::getRandPoint(s_maxPos);
+        const auto radius = test_util::rand(100, s_maxRadius);
+        constexpr auto vertexCount = 8;
+
+        space::SimplePolygon<TCrt>::TPiecewiseLinearCurve curve;
+        for (int i = vertexCount; i > 0; --i)
+        {
+            const auto angle = 2 * std::numbers::pi * i / vertexCount;
+            curve.push_back({center.x() + static_cast<TCrt>(radius * std::cos(angle))
+                             , center.y() + static_cast<TCrt>(radius * std::sin(angle))});
+        }
+        return space::SimplePolygon<TCrt> {curve};
+    }
+
+private:
+    space::PolygonLayer<TCrt> m_layer;
+    space::QuadTree<std::pair<space::Rect<TCrt>, uint32_t>> m_boxIndex;
+    std::vector<space::SimplePolygon<TCrt>> m_queryList;
+};
+
+static void NaivePolygonJoin(benchmark::State& state)
+{
+    const auto& layer = DataStorage::Instance().Layer();
+    const auto& index = DataStorage::Instance().BoxIndex();
+    const auto& queryList = DataStorage::Instance().QueryList();
+
+    const auto count = state.range(0);
+
+    size_t matched = 0;
+    for (auto _ : state)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            for (const auto& [box, id] : index.queryRange(space::util::boundaryBoxOf(queryList[i])))
+            {
+                matched += space::util::hasIntersect(queryList[i], layer.polygon(id));
+            }
+        }
+    }
+    benchmark::DoNotOptimize(matched);
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+BENCHMARK(NaivePolygonJoin)->Range(512, s_queryCount);
+
+static void PolygonLayerJoin(benchmark::State& state)
+{
+    const auto& layer = DataStorage::Instance().Layer();
+    const auto& queryList = DataStorage::Instance().QueryList();
+
+    const auto count = state.range(0);
+
+    space::PolygonLayer<TCrt>::QueryStats stats;
+    std::vector<uint32_t> ids;
+    for (auto _ : state)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            stats += layer.queryIntersecting(queryList[i], std::back_inserter(ids));
+            ids.clear();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+    state.counters["filtered"] = benchmark::Counter(static_cast<double>(stats.filtered), benchmark::Counter::kAvgIterations);
+    state.counters["matched"] = benchmark::Counter(static_cast<double>(stats.matched), benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK(PolygonLayerJoin)->Range(512, s_queryCount);
+
+static void PolygonLayerBatchJoin(benchmark::State& state)
+{
+    const auto& layer = DataStorage::Instance().Layer();
+    const auto& queryList = DataStorage::Instance().QueryList();
+
+    const auto count = static_cast<size_t>(state.range(0));
+
+    for (auto _ : state)
+    {
+        auto result = layer.queryIntersectingBatch(std::span {queryList}.first(count));
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+}
+
+BENCHMARK(PolygonLayerBatchJoin)->Range(512, s_queryCount);
+
+static space::SimplePolygon<TCrt> getLargeStarPolygon(int64_t vertexCount)
+{
+    constexpr TCrt center = 500'000;
+    constexpr TCrt maxRadius = 400'000;
+
+    space::SimplePolygon<TCrt>::TPiecewiseLinearCurve curve;
+    for (auto i = vertexCount; i > 0; --i)
+    {
+        const auto angle = 2 * std::numbers::pi * static_cast<double>(i) / static_cast<double>(vertexCount);
+        const auto radius = maxRadius * (0.75 + 0.2 * std::sin(17 * angle)) + test_util::rand(0, maxRadius / 1'000);
+        curve.push_back({center + static_cast<TCrt>(radius * std::cos(angle))
+                         , center + static_cast<TCrt>(radius * std::sin(angle))});
+    }
+    return space::SimplePolygon<TCrt> {curve};
+}
+
+static void SimplePolygonContains(benchmark::State& state)
+{
+    const auto polygon = getLargeStarPolygon(state.range(0));
+
+    size_t matched = 0;
+    for (auto _ : state)
+    {
+        matched += space::util::contains(polygon, test_util::getRandPoint(1'000'000));
+    }
+    benchmark::DoNotOptimize(matched);
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(SimplePolygonContains)->RangeMultiplier(10)->Range(1'000, 100'000);
+
+static void PreparedSimplePolygonPrepare(benchmark::State& state)
+{
+    const auto polygon = getLargeStarPolygon(state.range(0));
+
+    for (auto _ : state)
+    {
+        space::PreparedSimplePolygon<TCrt> prepared {polygon};
+        benchmark::DoNotOptimize(prepared);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(PreparedSimplePolygonPrepare)->RangeMultiplier(10)->Range(1'000, 100'000)->Arg(500'000);
+
+static void PreparedSimplePolygonContains(benchmark::State& state)
+{
+    const space::PreparedSimplePolygon<TCrt> prepared {getLargeStarPolygon(state.range(0))};
+
+    size_t matched = 0;
+    for (auto _ : state)
+    {
+        matched += space::util::contains(prepared, test_util::getRandPoint(1'000'000));
+    }
+    benchmark::DoNotOptimize(matched);
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(PreparedSimplePolygonContains)->RangeMultiplier(10)->Range(1'000, 100'000)->Arg(500'000);
+
+static void SimplePolygonContainsStream(benchmark::State& state)
+{
+    const auto polygon = getLargeStarPolygon(state.range(0));
+    std::vector<space::Point<TCrt>> points;
+    for (int i = 0; i < 4'096; ++i)
+    {
+        points.push_back(test_util::getRandPoint(1'000'000));
+    }
+    std::vector<std::uint8_t> results(std::size(points));
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < std::size(points); ++i)
+        {
+            results[i] = space::util::contains(polygon, points[i]);
+        }
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * std::size(points)));
+}
+
+BENCHMARK(SimplePolygonContainsStream)->RangeMultiplier(8)->Range(8, 512);
+
+static void SimplePolygonContainsBatch(benchmark::State& state)
+{
+    const auto polygon = getLargeStarPolygon(state.range(0));
+    std::vector<space::Point<TCrt>> points;
+    for (int i = 0; i < 4'096; ++i)
+    {
+        points.push_back(test_util::getRandPoint(1'000'000));
+    }
+    std::vector<std::uint8_t> results(std::size(points));
+
+    for (auto _ : state)
+    {
+        space::util::containsBatch<TCrt>(polygon, points, results);
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * std::size(points)));
+}
+
+BENCHMARK(SimplePolygonContainsBatch)->RangeMultiplier(8)->Range(8, 512);
+
+static std::vector<space::SimplePolygon<TCrt>> getNearbyPolygons()
+{
+    auto nearbyList = DataStorage::Instance().QueryList();
+    for (auto& polygon : nearbyList)
+    {
+        space::util::move(polygon, test_util::rand(-3'000, 3'000), test_util::rand(-3'000, 3'000));
+    }
+    return nearbyList;
+}
+
+static void SatPolygonIntersect(benchmark::State& state)
+{
+    const auto& queryList = DataStorage::Instance().QueryList();
+    const auto nearbyList = getNearbyPolygons();
+
+    size_t matched = 0;
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < std::size(queryList); ++i)
+        {
+            matched += space::util::impl::polygonEdgesProjectionsOverlaps(queryList[i], nearbyList[i])
+                && space::util::impl::polygonEdgesProjectionsOverlaps(nearbyList[i], queryList[i]);
+        }
+    }
+    benchmark::DoNotOptimize(matched);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * std::size(queryList)));
+}
+
+BENCHMARK(SatPolygonIntersect);
+
+static void PreparedPolygonIntersect(benchmark::State& state)
+{
+    const auto& queryList = DataStorage::Instance().QueryList();
+    const auto nearbyList = getNearbyPolygons();
+    const std::vector<space::PreparedSimplePolygon<TCrt>> preparedList(queryList.begin(), queryList.end());
+    const std::vector<space::PreparedSimplePolygon<TCrt>> preparedNearbyList(nearbyList.begin(), nearbyList.end());
+
+    size_t matched = 0;
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < std::size(preparedList); ++i)
+        {
+            matched += space::util::hasIntersect(preparedList[i], preparedNearbyList[i]);
+        }
+    }
+    benchmark::DoNotOptimize(matched);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * std::size(preparedList)));
+}
+
+BENCHMARK(PreparedPolygonIntersect);
+
+static std::vector<space::Segment<TCrt>> getShortSegments(int64_t segmentCount)
+{
+    std::vector<space::Segment<TCrt>> segments;
+    for (int64_t i = 0; i < segmentCount; ++i)
+    {
+        const auto point = test_util::getRandPoint(1'000'000);
+        segments.emplace_back(point, space::Point<TCrt> {point.x() + test_util::rand(-2'000, 2'000)
+                                                         , point.y() + test_util::rand(-2'000, 2'000)});
+    }
+    return segments;
+}
+
+static void SegmentIntersectingPairs(benchmark::State& state)
+{
+    const auto segments = getShortSegments(state.range(0));
+
+    for (auto _ : state)
+    {
+        std::vector<std::pair<std::size_t, std::size_t>> pairs;
+        space::util::intersectingPairs(space::collections::Span<const space::Segment<TCrt>> {segments}, std::back_inserter(pairs));
+        benchmark::DoNotOptimize(pairs);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(SegmentIntersectingPairs)->RangeMultiplier(10)->Range(1'000, 100'000);
+
+static void SegmentIntersectingPairsParallel(benchmark::State& state)
+{
+    const auto segments = getShortSegments(state.range(0));
+
+    for (auto _ : state)
+    {
+        auto pairs = space::util::intersectingPairs(std::execution::par, space::collections::Span<const space::Segment<TCrt>> {segments});
+        benchmark::DoNotOptimize(pairs);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(SegmentIntersectingPairsParallel)->RangeMultiplier(10)->Range(1'000, 100'000);
+
+static void SimplePolygonIsSimple(benchmark::State& state)
+{
+    const auto polygon = getLargeStarPolygon(state.range(0));
+
+    size_t matched = 0;
+    for (auto _ : state)
+    {
+        matched += space::util::isSimple(polygon);
+    }
+    benchmark::DoNotOptimize(matched);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(SimplePolygonIsSimple)->RangeMultiplier(10)->Range(1'000, 100'000);
+
+int main(int argc, char** argv)
+{
+    auto& dataStorage = DataStorage::Instance();
+    ::benchmark::Initialize(&argc, argv);
+    if (::benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+    ::benchmark::RunSpecifiedBenchmarks();
+}
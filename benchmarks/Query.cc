@@ -1,7 +1,19 @@
 #include <benchmark/benchmark.h>
 
+#include <atomic>
+#include <cstdlib>
+#include <filesystem>
+#include <mutex>
+#include <new>
+#include <shared_mutex>
 #include <unordered_set>
 
+#include <boost/geometry/strategies/strategies.hpp>
+#include <tbb/global_control.h>
+
+#include "ConcurrentQuadTree.h"
+#include "LinearQuadTree.h"
+#include "SpatialJoin.h"
 #include "Utils.h"
 
 constexpr auto s_shapeCount = 8 << 13;
@@ -12,6 +24,42 @@ using point = boost::geometry::model::point<TCrt, 2, boost::geometry::cs::cartes
 using box = boost::geometry::model::box<point>;
 using value = std::pair<box, bool>;
 
+namespace
+{
+
+/**
+ * @brief   The number of calls of global operator new, used for counting allocations per query.
+ */
+std::atomic<std::size_t> s_allocationCount {0};
+
+void setAllocationsPerQuery(benchmark::State& state, std::size_t allocationCount, std::int64_t count)
+{
+    state.counters["allocs_per_query"] = benchmark::Counter(
+        static_cast<double>(allocationCount) / static_cast<double>(state.iterations() * count));
+}
+
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    s_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc {};
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
 class DataStorage
 {
     static constexpr auto s_maxPos = 1'000'000;
@@ -41,6 +89,26 @@ public:
         return m_spaceIndex;
     }
 
+    const auto& SpaceLooseIndex() const noexcept
+    {
+        return m_spaceLooseIndex;
+    }
+
+    const auto& SpaceColumnarIndex() const noexcept
+    {
+        return m_spaceColumnarIndex;
+    }
+
+    const auto& SpaceLinearIndex() const noexcept
+    {
+        return m_spaceLinearIndex;
+    }
+
+    const auto& SpaceRectList() const noexcept
+    {
+        return m_spaceRectList;
+    }
+
     const auto& BoostQueryBoxList() const noexcept
     {
         return m_boostQueryBoxList;
@@ -56,14 +124,19 @@ private:
     DataStorage()
     {
         const auto initialRects = getRandomRectList(s_shapeCount);
+        m_spaceRectList.assign(initialRects.begin(), initialRects.end());
 
         for (auto&& rect : initialRects)
         {
             m_spaceIndex.insert(rect);
+            m_spaceLooseIndex.insert(rect);
+            m_spaceColumnarIndex.insert(rect);
             const auto boostRect = test_util::spaceToBoostRect(rect);
             m_boostIndex.insert(std::make_pair(boostRect, false));
         }
 
+        m_spaceLinearIndex = space::LinearQuadTree<space::Rect<TCrt>> {m_spaceIndex};
+
         m_spaceQueryBoxList.reserve(s_testCount);
         m_boostQueryBoxList.reserve(s_testCount);
 
@@ -91,6 +164,10 @@ private:
 private:
     boost::geometry::index::rtree<value, boost::geometry::index::quadratic<16>> m_boostIndex;
     space::QuadTree<space::Rect<TCrt>> m_spaceIndex;
+    space::QuadTree<space::Rect<TCrt>, space::LooseQuadTreePolicy> m_spaceLooseIndex;
+    space::QuadTree<space::Rect<TCrt>, space::ColumnarQuadTreePolicy> m_spaceColumnarIndex;
+    space::LinearQuadTree<space::Rect<TCrt>> m_spaceLinearIndex;
+    std::vector<space::Rect<TCrt>> m_spaceRectList;
     std::vector<box> m_boostQueryBoxList;
     std::vector<space::Rect<TCrt>> m_spaceQueryBoxList;
 };
@@ -105,16 +182,17 @@ static void BoostSpaceIndexQuery(benchmark::State& state)
     std::vector<value> rTreeQueryRes;
     rTreeQueryRes.reserve(s_shapeCount);
 
+    const auto allocationCount = s_allocationCount.load();
     for (auto _ : state)
     {
         for (int i = 0; i < count; ++i)
         {
             index.query(boost::geometry::index::intersects(queryList[i]), std::back_inserter(rTreeQueryRes));
-            state.PauseTiming();
             rTreeQueryRes.clear();
-            state.ResumeTiming();
         }
     }
+    setAllocationsPerQuery(state, s_allocationCount.load() - allocationCount, count);
+    state.SetItemsProcessed(state.iterations() * count);
     benchmark::DoNotOptimize(rTreeQueryRes);
 }
 
@@ -130,21 +208,393 @@ static void SpaceQuadTreeQuery(benchmark::State& state)
     std::vector<space::Rect<TCrt>> quadTreeQueryRes;
     quadTreeQueryRes.reserve(s_shapeCount);
 
+    const auto allocationCount = s_allocationCount.load();
     for (auto _ : state)
     {
         for (int i = 0; i < count; ++i)
         {
             index.query(queryList[i], std::back_inserter(quadTreeQueryRes));
-            state.PauseTiming();
             quadTreeQueryRes.clear();
-            state.ResumeTiming();
         }
     }
+    setAllocationsPerQuery(state, s_allocationCount.load() - allocationCount, count);
+    state.SetItemsProcessed(state.iterations() * count);
     benchmark::DoNotOptimize(quadTreeQueryRes);
 }
 
 BENCHMARK(SpaceQuadTreeQuery)->Range(512, s_testCount);
 
+static void SpaceStatsQuadTreeQuery(benchmark::State& state)
+{
+    static const space::QuadTree<space::Rect<TCrt>, space::StatsQuadTreePolicy> s_index {
+        DataStorage::Instance().SpaceRectList()};
+    const auto& queryList = DataStorage::Instance().SpaceQueryBoxList();
+
+    const auto count = state.range(0);
+
+    std::vector<space::Rect<TCrt>> quadTreeQueryRes;
+    quadTreeQueryRes.reserve(s_shapeCount);
+
+    for (auto _ : state)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            s_index.query(queryList[i], std::back_inserter(quadTreeQueryRes));
+            quadTreeQueryRes.clear();
+        }
+    }
+    const auto counters = s_index.stats().counters;
+    state.counters["nodesPerQuery"] = static_cast<double>(counters.nodesVisited) / static_cast<double>(counters.queries);
+    state.counters["testedPerQuery"] = static_cast<double>(counters.valuesTested) / static_cast<double>(counters.queries);
+    state.SetItemsProcessed(state.iterations() * count);
+    benchmark::DoNotOptimize(quadTreeQueryRes);
+}
+
+BENCHMARK(SpaceStatsQuadTreeQuery)->Range(512, s_testCount);
+
+static void SpaceLinearQuadTreeQuery(benchmark::State& state)
+{
+    const auto& index = DataStorage::Instance().SpaceLinearIndex();
+    const auto& queryList = DataStorage::Instance().SpaceQueryBoxList();
+
+    const auto count = state.range(0);
+
+    std::vector<space::Rect<TCrt>> quadTreeQueryRes;
+    quadTreeQueryRes.reserve(s_shapeCount);
+
+    const auto allocationCount = s_allocationCount.load();
+    for (auto _ : state)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            index.query(queryList[i], std::back_inserter(quadTreeQueryRes));
+            quadTreeQueryRes.clear();
+        }
+    }
+    setAllocationsPerQuery(state, s_allocationCount.load() - allocationCount, count);
+    state.SetItemsProcessed(state.iterations() * count);
+    benchmark::DoNotOptimize(quadTreeQueryRes);
+}
+
+BENCHMARK(SpaceLinearQuadTreeQuery)->Range(512, s_testCount);
+
+#ifdef SPACE_HAS_MMAP
+static void SpaceMappedQuadTreeQuery(benchmark::State& state)
+{
+    const auto path = std::filesystem::temp_directory_path() / "space_quadtree_query_benchmark.snapshot";
+    DataStorage::Instance().SpaceIndex().save(path);
+    const auto index = space::QuadTree<space::Rect<TCrt>>::openMapped(path);
+    const auto& queryList = DataStorage::Instance().SpaceQueryBoxList();
+
+    const auto count = state.range(0);
+
+    std::vector<space::Rect<TCrt>> quadTreeQueryRes;
+    quadTreeQueryRes.reserve(s_shapeCount);
+
+    const auto allocationCount = s_allocationCount.load();
+    for (auto _ : state)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            index.query(queryList[i], std::back_inserter(quadTreeQueryRes));
+            quadTreeQueryRes.clear();
+        }
+    }
+    setAllocationsPerQuery(state, s_allocationCount.load() - allocationCount, count);
+    state.SetItemsProcessed(state.iterations() * count);
+    benchmark::DoNotOptimize(quadTreeQueryRes);
+    std::filesystem::remove(path);
+}
+
+BENCHMARK(SpaceMappedQuadTreeQuery)->Range(512, s_testCount);
+#endif // SPACE_HAS_MMAP
+
+static void SpaceLooseQuadTreeQuery(benchmark::State& state)
+{
+    const auto& index = DataStorage::Instance().SpaceLooseIndex();
+    const auto& queryList = DataStorage::Instance().SpaceQueryBoxList();
+
+    const auto count = state.range(0);
+
+    std::vector<space::Rect<TCrt>> quadTreeQueryRes;
+    quadTreeQueryRes.reserve(s_shapeCount);
+
+    for (auto _ : state)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            index.query(queryList[i], std::back_inserter(quadTreeQueryRes));
+            benchmark::DoNotOptimize(quadTreeQueryRes);
+            quadTreeQueryRes.clear();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+BENCHMARK(SpaceLooseQuadTreeQuery)->Range(512, s_testCount);
+
+static void SpaceColumnarQuadTreeQuery(benchmark::State& state)
+{
+    const auto& index = DataStorage::Instance().SpaceColumnarIndex();
+    const auto& queryList = DataStorage::Instance().SpaceQueryBoxList();
+
+    const auto count = state.range(0);
+
+    std::vector<space::Rect<TCrt>> quadTreeQueryRes;
+    quadTreeQueryRes.reserve(s_shapeCount);
+
+    for (auto _ : state)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            index.query(queryList[i], std::back_inserter(quadTreeQueryRes));
+            benchmark::DoNotOptimize(quadTreeQueryRes);
+            quadTreeQueryRes.clear();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+BENCHMARK(SpaceColumnarQuadTreeQuery)->Range(512, s_testCount);
+
+static void SpaceQuadTreeBatchQuery(benchmark::State& state)
+{
+    const auto& index = DataStorage::Instance().SpaceIndex();
+    const auto& queryList = DataStorage::Instance().SpaceQueryBoxList();
+
+    const auto count = static_cast<size_t>(state.range(0));
+    const auto threadCount = static_cast<size_t>(state.range(1));
+    tbb::global_control threadLimit(tbb::global_control::max_allowed_parallelism, threadCount);
+
+    for (auto _ : state)
+    {
+        auto result = index.queryBatch(std::span {queryList}.first(count));
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+}
+
+BENCHMARK(SpaceQuadTreeBatchQuery)->ArgsProduct({benchmark::CreateRange(512, s_testCount, 8), {1, 2, 4, 8}});
+
+static void BoostSpaceIndexNearest(benchmark::State& state)
+{
+    const auto& index = DataStorage::Instance().BoostIndex();
+    const auto& queryList = DataStorage::Instance().BoostQueryBoxList();
+
+    const auto count = state.range(0);
+    const auto k = static_cast<unsigned>(state.range(1));
+
+    std::vector<value> rTreeQueryRes;
+    rTreeQueryRes.reserve(k);
+
+    for (auto _ : state)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            index.query(boost::geometry::index::nearest(queryList[i].min_corner(), k), std::back_inserter(rTreeQueryRes));
+            benchmark::DoNotOptimize(rTreeQueryRes);
+            rTreeQueryRes.clear();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+BENCHMARK(BoostSpaceIndexNearest)->ArgsProduct({benchmark::CreateRange(512, 1 << 15, 8), {1, 16}});
+
+static void SpaceQuadTreeNearest(benchmark::State& state)
+{
+    const auto& index = DataStorage::Instance().SpaceIndex();
+    const auto& queryList = DataStorage::Instance().SpaceQueryBoxList();
+
+    const auto count = state.range(0);
+    const auto k = static_cast<size_t>(state.range(1));
+
+    std::vector<space::Rect<TCrt>> quadTreeQueryRes;
+    quadTreeQueryRes.reserve(k);
+
+    for (auto _ : state)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            index.nearest(queryList[i].pos(), k, std::back_inserter(quadTreeQueryRes));
+            benchmark::DoNotOptimize(quadTreeQueryRes);
+            quadTreeQueryRes.clear();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+BENCHMARK(SpaceQuadTreeNearest)->ArgsProduct({benchmark::CreateRange(512, 1 << 15, 8), {1, 16}});
+
+constexpr auto s_joinCount = 1 << 16;
+
+static void BoostSpaceIndexJoin(benchmark::State& state)
+{
+    const auto& index = DataStorage::Instance().BoostIndex();
+    const auto& queryList = DataStorage::Instance().BoostQueryBoxList();
+    const auto count = state.range(0);
+
+    std::vector<value> rTreeQueryRes;
+    std::size_t pairCount = 0;
+    for (auto _ : state)
+    {
+        pairCount = 0;
+        for (int i = 0; i < count; ++i)
+        {
+            index.query(boost::geometry::index::intersects(queryList[i]), std::back_inserter(rTreeQueryRes));
+            pairCount += std::size(rTreeQueryRes);
+            rTreeQueryRes.clear();
+        }
+    }
+    state.counters["pairs"] = static_cast<double>(pairCount);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    benchmark::DoNotOptimize(pairCount);
+}
+
+BENCHMARK(BoostSpaceIndexJoin)->Range(512, s_joinCount);
+
+static void SpaceQuadTreeQueryJoin(benchmark::State& state)
+{
+    const auto& index = DataStorage::Instance().SpaceIndex();
+    const auto& queryList = DataStorage::Instance().SpaceQueryBoxList();
+    const auto count = state.range(0);
+
+    std::vector<space::Rect<TCrt>> quadTreeQueryRes;
+    std::size_t pairCount = 0;
+    for (auto _ : state)
+    {
+        pairCount = 0;
+        for (int i = 0; i < count; ++i)
+        {
+            index.query(queryList[i], std::back_inserter(quadTreeQueryRes));
+            pairCount += std::size(quadTreeQueryRes);
+            quadTreeQueryRes.clear();
+        }
+    }
+    state.counters["pairs"] = static_cast<double>(pairCount);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    benchmark::DoNotOptimize(pairCount);
+}
+
+BENCHMARK(SpaceQuadTreeQueryJoin)->Range(512, s_joinCount);
+
+static void SpaceQuadTreeSpatialJoin(benchmark::State& state)
+{
+    const auto& index = DataStorage::Instance().SpaceIndex();
+    const auto& queryList = DataStorage::Instance().SpaceQueryBoxList();
+    const space::QuadTree<space::Rect<TCrt>> queryIndex {std::span {queryList}.first(state.range(0))};
+
+    std::size_t pairCount = 0;
+    for (auto _ : state)
+    {
+        pairCount = 0;
+        space::spatialJoin(queryIndex, index, [&pairCount](const auto&, const auto&)
+        {
+            ++pairCount;
+        });
+    }
+    state.counters["pairs"] = static_cast<double>(pairCount);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    benchmark::DoNotOptimize(pairCount);
+}
+
+BENCHMARK(SpaceQuadTreeSpatialJoin)->Range(512, s_joinCount);
+
+static void SpaceQuadTreeParallelSpatialJoin(benchmark::State& state)
+{
+    const auto& index = DataStorage::Instance().SpaceIndex();
+    const auto& queryList = DataStorage::Instance().SpaceQueryBoxList();
+    const space::QuadTree<space::Rect<TCrt>> queryIndex {std::span {queryList}.first(state.range(0))};
+
+    std::size_t pairCount = 0;
+    for (auto _ : state)
+    {
+        const auto pairs = space::spatialJoin(std::execution::par, queryIndex, index);
+        pairCount = std::size(pairs);
+    }
+    state.counters["pairs"] = static_cast<double>(pairCount);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    benchmark::DoNotOptimize(pairCount);
+}
+
+BENCHMARK(SpaceQuadTreeParallelSpatialJoin)->Range(512, s_joinCount)->UseRealTime();
+
+/**
+ * @brief   Returns the key which moves the given one for the mixed read/write benchmarks.
+ */
+space::Rect<TCrt> movedRect(const space::Rect<TCrt>& rect, size_t iteration, size_t count)
+{
+    const TCrt offset = (0 == (iteration / count) % 2) ? 1 : 0;
+    return space::Rect<TCrt> {{rect.pos().x() + offset, rect.pos().y()}, rect.width(), rect.height()};
+}
+
+static void SpaceQuadTreeSharedMutexMixed(benchmark::State& state)
+{
+    static space::QuadTree<space::Rect<TCrt>> s_index {DataStorage::Instance().SpaceRectList()};
+    static std::shared_mutex s_mutex;
+    const auto& rectList = DataStorage::Instance().SpaceRectList();
+    const auto& queryList = DataStorage::Instance().SpaceQueryBoxList();
+    const bool isWriter = 0 == state.thread_index();
+
+    // The first thread moves the keys back and forth, the others query.
+    size_t i = static_cast<size_t>(state.thread_index()) * 7919;
+    for (auto _ : state)
+    {
+        if (isWriter)
+        {
+            const auto& rect = rectList[i % std::size(rectList)];
+            const std::unique_lock lock {s_mutex};
+            s_index.remove(movedRect(rect, i + std::size(rectList), std::size(rectList)));
+            s_index.insert(movedRect(rect, i, std::size(rectList)));
+        }
+        else
+        {
+            const std::shared_lock lock {s_mutex};
+            benchmark::DoNotOptimize(s_index.queryCount(queryList[i % std::size(queryList)]));
+        }
+        ++i;
+    }
+    state.SetItemsProcessed(isWriter ? 0 : state.iterations());
+}
+
+BENCHMARK(SpaceQuadTreeSharedMutexMixed)->ThreadRange(2, 16)->UseRealTime();
+
+static void SpaceConcurrentQuadTreeMixed(benchmark::State& state)
+{
+    static const auto s_index = []()
+    {
+        auto index = std::make_unique<space::ConcurrentQuadTree<space::Rect<TCrt>>>();
+        for (const auto& rect : DataStorage::Instance().SpaceRectList())
+        {
+            index->insert(rect);
+        }
+        return index;
+    }();
+    const auto& rectList = DataStorage::Instance().SpaceRectList();
+    const auto& queryList = DataStorage::Instance().SpaceQueryBoxList();
+    const bool isWriter = 0 == state.thread_index();
+
+    // The first thread moves the keys back and forth, the others query.
+    size_t i = static_cast<size_t>(state.thread_index()) * 7919;
+    for (auto _ : state)
+    {
+        if (isWriter)
+        {
+            const auto& rect = rectList[i % std::size(rectList)];
+            s_index->remove(movedRect(rect, i + std::size(rectList), std::size(rectList)));
+            s_index->insert(movedRect(rect, i, std::size(rectList)));
+        }
+        else
+        {
+            benchmark::DoNotOptimize(s_index->queryCount(queryList[i % std::size(queryList)]));
+        }
+        ++i;
+    }
+    state.SetItemsProcessed(isWriter ? 0 : state.iterations());
+}
+
+BENCHMARK(SpaceConcurrentQuadTreeMixed)->ThreadRange(2, 16)->UseRealTime();
+
 int main(int argc, char** argv)
 {
     auto& dataStorage = DataStorage::Instance();
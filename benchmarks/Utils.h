@@ -9,6 +9,7 @@
 #include "Rect.h"
 #include "Square.h"
 #include "QuadTree.h"
+#include "ShardedQuadTree.h"
 #include "Utility.h"
 
 
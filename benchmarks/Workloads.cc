@@ -0,0 +1,576 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <new>
+
+#include <boost/geometry.hpp>
+
+#include "QuadTreeBuilder.h"
+#include "QueryCache.h"
+#include "Utils.h"
+#include "Workloads.h"
+
+using TCrt = workload::TCrt;
+using point = boost::geometry::model::point<TCrt, 2, boost::geometry::cs::cartesian>;
+using box = boost::geometry::model::box<point>;
+using value = std::pair<box, bool>;
+using TRTree = boost::geometry::index::rtree<value, boost::geometry::index::quadratic<16>>;
+
+/**
+ * @brief   The number of shapes of every workload, the trees of both libraries have this size.
+ */
+constexpr auto s_shapeCount = 1 << 17;
+constexpr auto s_queryCount = 1 << 14;
+constexpr auto s_moveCount = 1 << 14;
+
+namespace
+{
+
+/**
+ * @brief   The bytes allocated by global operator new and not deleted yet.
+ */
+std::atomic<std::int64_t> s_liveBytes {0};
+
+/**
+ * @brief   The size header of every allocation, keeps the default new alignment.
+ */
+constexpr std::size_t s_headerSize = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+/**
+ * @brief   Reports the memory footprint of the index measured by the live bytes.
+ */
+void setMemoryFootprint(benchmark::State& state, std::int64_t bytes, std::int64_t count)
+{
+    state.counters["bytes"] = static_cast<double>(bytes);
+    state.counters["bytes_per_item"] = static_cast<double>(bytes) / static_cast<double>(count);
+}
+
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    auto* block = static_cast<unsigned char*>(std::malloc(size + s_headerSize));
+    if (nullptr == block)
+    {
+        throw std::bad_alloc {};
+    }
+    *reinterpret_cast<std::size_t*>(block) = size;
+    s_liveBytes.fetch_add(static_cast<std::int64_t>(size), std::memory_order_relaxed);
+    return block + s_headerSize;
+}
+
+void operator delete(void* ptr) noexcept
+{
+    if (nullptr == ptr)
+    {
+        return;
+    }
+    auto* block = static_cast<unsigned char*>(ptr) - s_headerSize;
+    s_liveBytes.fetch_sub(static_cast<std::int64_t>(*reinterpret_cast<std::size_t*>(block)), std::memory_order_relaxed);
+    std::free(block);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    operator delete(ptr);
+}
+
+/**
+ * @brief   The shapes, queries and moves of one workload with the indexes built from them.
+ */
+struct Workload
+{
+    std::vector<space::Rect<TCrt>> rects;
+    std::vector<box> boostRects;
+    std::vector<space::Rect<TCrt>> queries;
+    std::vector<box> boostQueries;
+    std::vector<std::pair<space::Rect<TCrt>, space::Rect<TCrt>>> moves;
+    space::QuadTree<space::Rect<TCrt>> quadTree;
+    TRTree rtree;
+};
+
+/**
+ * @brief   Gets the workload of the benchmark arguments (distribution, shape size), the
+ *          workloads are generated once.
+ */
+static const Workload& workloadOf(benchmark::State& state)
+{
+    static std::map<std::pair<std::int64_t, std::int64_t>, std::unique_ptr<Workload>> s_workloads;
+
+    const auto distribution = static_cast<workload::Distribution>(state.range(0));
+    const auto size = static_cast<workload::ShapeSize>(state.range(1));
+    state.SetLabel(workload::nameOf(distribution) + "/" + workload::nameOf(size));
+
+    auto& cached = s_workloads[{state.range(0), state.range(1)}];
+    if (nullptr == cached)
+    {
+        cached = std::make_unique<Workload>();
+        workload::Generator generator {distribution, size, 42};
+        cached->rects = generator.uniqueRects(s_shapeCount);
+
+        // The query windows follow the shapes distribution with the small size.
+        workload::Generator queryGenerator {distribution, workload::ShapeSize::Small, 7};
+        for (int i = 0; i < s_queryCount; ++i)
+        {
+            cached->queries.push_back(queryGenerator.next());
+        }
+        for (int i = 0; i < s_moveCount; ++i)
+        {
+            const auto& rect = cached->rects[static_cast<std::size_t>(i)];
+            cached->moves.emplace_back(rect, generator.moved(rect, 50));
+        }
+
+        for (const auto& rect : cached->rects)
+        {
+            cached->boostRects.push_back(test_util::spaceToBoostRect(rect));
+        }
+        for (const auto& rect : cached->queries)
+        {
+            cached->boostQueries.push_back(test_util::spaceToBoostRect(rect));
+        }
+        for (const auto& rect : cached->rects)
+        {
+            cached->quadTree.insert(rect);
+            cached->rtree.insert(std::make_pair(test_util::spaceToBoostRect(rect), false));
+        }
+    }
+    return *cached;
+}
+
+static void allWorkloads(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->ArgsProduct({{0, 1, 2, 3}, {0, 1, 2}})->ArgNames({"distribution", "size"});
+}
+
+static void BoostRTreeInsert(benchmark::State& state)
+{
+    const auto& data = workloadOf(state);
+
+    std::int64_t bytes = 0;
+    for (auto _ : state)
+    {
+        const auto liveBytes = s_liveBytes.load();
+        TRTree rtree;
+        for (const auto& rect : data.boostRects)
+        {
+            rtree.insert(std::make_pair(rect, false));
+        }
+        bytes = s_liveBytes.load() - liveBytes;
+        benchmark::DoNotOptimize(rtree.size());
+    }
+    setMemoryFootprint(state, bytes, s_shapeCount);
+    state.SetItemsProcessed(state.iterations() * s_shapeCount);
+}
+
+BENCHMARK(BoostRTreeInsert)->Apply(allWorkloads);
+
+static void SpaceQuadTreeInsert(benchmark::State& state)
+{
+    const auto& data = workloadOf(state);
+
+    std::int64_t bytes = 0;
+    for (auto _ : state)
+    {
+        const auto liveBytes = s_liveBytes.load();
+        space::QuadTree<space::Rect<TCrt>> quadTree;
+        for (const auto& rect : data.rects)
+        {
+            quadTree.insert(rect);
+        }
+        bytes = s_liveBytes.load() - liveBytes;
+        benchmark::DoNotOptimize(quadTree.size());
+    }
+    setMemoryFootprint(state, bytes, s_shapeCount);
+    state.SetItemsProcessed(state.iterations() * s_shapeCount);
+}
+
+BENCHMARK(SpaceQuadTreeInsert)->Apply(allWorkloads);
+
+static void BoostRTreePack(benchmark::State& state)
+{
+    const auto& data = workloadOf(state);
+    std::vector<value> values;
+    for (const auto& rect : data.boostRects)
+    {
+        values.emplace_back(rect, false);
+    }
+
+    std::int64_t bytes = 0;
+    for (auto _ : state)
+    {
+        const auto liveBytes = s_liveBytes.load();
+        const TRTree rtree {values.begin(), values.end()};
+        bytes = s_liveBytes.load() - liveBytes;
+        benchmark::DoNotOptimize(rtree.size());
+    }
+    setMemoryFootprint(state, bytes, s_shapeCount);
+    state.SetItemsProcessed(state.iterations() * s_shapeCount);
+}
+
+BENCHMARK(BoostRTreePack)->Apply(allWorkloads);
+
+static void SpaceQuadTreeBulkLoad(benchmark::State& state)
+{
+    const auto& data = workloadOf(state);
+
+    std::int64_t bytes = 0;
+    for (auto _ : state)
+    {
+        const auto liveBytes = s_liveBytes.load();
+        const space::QuadTree<space::Rect<TCrt>> quadTree {data.rects};
+        bytes = s_liveBytes.load() - liveBytes;
+        benchmark::DoNotOptimize(quadTree.size());
+    }
+    setMemoryFootprint(state, bytes, s_shapeCount);
+    state.SetItemsProcessed(state.iterations() * s_shapeCount);
+}
+
+BENCHMARK(SpaceQuadTreeBulkLoad)->Apply(allWorkloads);
+
+static void SpaceQuadTreeStreamingIngest(benchmark::State& state)
+{
+    constexpr std::size_t chunkSize = 4'096;
+    const auto& data = workloadOf(state);
+    const std::span<const space::Rect<TCrt>> rects {data.rects};
+
+    for (auto _ : state)
+    {
+        space::QuadTreeBuilder<space::Rect<TCrt>> builder {{}, 4 * chunkSize};
+        for (std::size_t first = 0; first < std::size(rects); first += chunkSize)
+        {
+            builder.push(rects.subspan(first, std::min(chunkSize, std::size(rects) - first)));
+        }
+        const auto quadTree = builder.finalize();
+        benchmark::DoNotOptimize(quadTree.size());
+    }
+    state.SetItemsProcessed(state.iterations() * s_shapeCount);
+}
+
+BENCHMARK(SpaceQuadTreeStreamingIngest)->Apply(allWorkloads)->UseRealTime();
+
+static void BoostRTreeQuery(benchmark::State& state)
+{
+    const auto& data = workloadOf(state);
+
+    std::vector<value> found;
+    std::size_t foundCount = 0;
+    for (auto _ : state)
+    {
+        foundCount = 0;
+        for (const auto& query : data.boostQueries)
+        {
+            data.rtree.query(boost::geometry::index::intersects(query), std::back_inserter(found));
+            foundCount += std::size(found);
+            found.clear();
+        }
+    }
+    state.counters["found_per_query"] = static_cast<double>(foundCount) / s_queryCount;
+    state.SetItemsProcessed(state.iterations() * s_queryCount);
+}
+
+BENCHMARK(BoostRTreeQuery)->Apply(allWorkloads);
+
+static void SpaceQuadTreeQuery(benchmark::State& state)
+{
+    const auto& data = workloadOf(state);
+
+    std::vector<space::Rect<TCrt>> found;
+    std::size_t foundCount = 0;
+    for (auto _ : state)
+    {
+        foundCount = 0;
+        for (const auto& query : data.queries)
+        {
+            data.quadTree.query(query, std::back_inserter(found));
+            foundCount += std::size(found);
+            found.clear();
+        }
+    }
+    state.counters["found_per_query"] = static_cast<double>(foundCount) / s_queryCount;
+    state.SetItemsProcessed(state.iterations() * s_queryCount);
+}
+
+BENCHMARK(SpaceQuadTreeQuery)->Apply(allWorkloads);
+
+/**
+ * @brief   The number of distinct windows of the tile server workload, every query is one of them
+ *          shifted inside its tile.
+ */
+static constexpr std::size_t s_hotWindowCount = 256;
+static constexpr TCrt s_tileSize = 4'096;
+
+static auto hotWindowOf(const Workload& data, std::size_t i)
+{
+    const auto& window = data.queries[i % s_hotWindowCount];
+    const auto shift = static_cast<TCrt>(i % 7);
+    return space::Rect<TCrt> {{window.pos().x() + shift, window.pos().y() + shift}, window.width(), window.height()};
+}
+
+template <bool IsCached>
+static void SpaceQuadTreeHotQuery(benchmark::State& state)
+{
+    const auto& data = workloadOf(state);
+    space::QueryCache<space::Rect<TCrt>> cache {data.quadTree, std::size_t {64} << 20, s_tileSize};
+
+    std::vector<space::Rect<TCrt>> found;
+    std::size_t foundCount = 0;
+    for (auto _ : state)
+    {
+        foundCount = 0;
+        for (std::size_t i = 0; i < static_cast<std::size_t>(s_queryCount); ++i)
+        {
+            if constexpr (IsCached)
+            {
+                cache.query(hotWindowOf(data, i), std::back_inserter(found));
+            }
+            else
+            {
+                data.quadTree.query(hotWindowOf(data, i), std::back_inserter(found));
+            }
+            foundCount += std::size(found);
+            found.clear();
+        }
+    }
+    const auto stats = cache.stats();
+    state.counters["found_per_query"] = static_cast<double>(foundCount) / s_queryCount;
+    state.counters["hit_rate"] = static_cast<double>(stats.hits) / static_cast<double>(std::max<std::uint64_t>(stats.hits + stats.misses, 1));
+    state.counters["cache_bytes"] = static_cast<double>(stats.bytesUsed);
+    state.SetItemsProcessed(state.iterations() * s_queryCount);
+}
+
+BENCHMARK_TEMPLATE(SpaceQuadTreeHotQuery, false)->Apply(allWorkloads);
+BENCHMARK_TEMPLATE(SpaceQuadTreeHotQuery, true)->Apply(allWorkloads);
+
+template <typename TPolicy>
+static void SpaceBucketQuadTreeInsert(benchmark::State& state)
+{
+    const auto& data = workloadOf(state);
+
+    std::int64_t bytes = 0;
+    for (auto _ : state)
+    {
+        const auto liveBytes = s_liveBytes.load();
+        space::QuadTree<space::Rect<TCrt>, TPolicy> quadTree;
+        for (const auto& rect : data.rects)
+        {
+            quadTree.insert(rect);
+        }
+        bytes = s_liveBytes.load() - liveBytes;
+        benchmark::DoNotOptimize(quadTree.size());
+    }
+    setMemoryFootprint(state, bytes, s_shapeCount);
+    state.SetItemsProcessed(state.iterations() * s_shapeCount);
+}
+
+BENCHMARK_TEMPLATE(SpaceBucketQuadTreeInsert, space::BucketQuadTreePolicy<16>)->Apply(allWorkloads);
+BENCHMARK_TEMPLATE(SpaceBucketQuadTreeInsert, space::BucketQuadTreePolicy<0, 20>)->Apply(allWorkloads);
+
+template <typename TPolicy>
+static void SpaceBucketQuadTreeQuery(benchmark::State& state)
+{
+    const auto& data = workloadOf(state);
+    space::QuadTree<space::Rect<TCrt>, TPolicy> quadTree;
+    for (const auto& rect : data.rects)
+    {
+        quadTree.insert(rect);
+    }
+
+    std::vector<space::Rect<TCrt>> found;
+    std::size_t foundCount = 0;
+    for (auto _ : state)
+    {
+        foundCount = 0;
+        for (const auto& query : data.queries)
+        {
+            quadTree.query(query, std::back_inserter(found));
+            foundCount += std::size(found);
+            found.clear();
+        }
+    }
+    state.counters["found_per_query"] = static_cast<double>(foundCount) / s_queryCount;
+    state.SetItemsProcessed(state.iterations() * s_queryCount);
+}
+
+BENCHMARK_TEMPLATE(SpaceBucketQuadTreeQuery, space::BucketQuadTreePolicy<16>)->Apply(allWorkloads);
+BENCHMARK_TEMPLATE(SpaceBucketQuadTreeQuery, space::BucketQuadTreePolicy<0, 20>)->Apply(allWorkloads);
+
+template <typename TFloating>
+static auto floatingRectOf(const space::Rect<TCrt>& rect)
+{
+    return space::Rect<TFloating> {{static_cast<TFloating>(rect.pos().x()), static_cast<TFloating>(rect.pos().y())}
+                                   , static_cast<TFloating>(rect.width()), static_cast<TFloating>(rect.height())};
+}
+
+template <typename TFloating>
+static void SpaceFloatingQuadTreeInsert(benchmark::State& state)
+{
+    const auto& data = workloadOf(state);
+    std::vector<space::Rect<TFloating>> rects;
+    std::ranges::transform(data.rects, std::back_inserter(rects), floatingRectOf<TFloating>);
+
+    std::int64_t bytes = 0;
+    for (auto _ : state)
+    {
+        const auto liveBytes = s_liveBytes.load();
+        space::QuadTree<space::Rect<TFloating>> quadTree;
+        for (const auto& rect : rects)
+        {
+            quadTree.insert(rect);
+        }
+        bytes = s_liveBytes.load() - liveBytes;
+        benchmark::DoNotOptimize(quadTree.size());
+    }
+    setMemoryFootprint(state, bytes, s_shapeCount);
+    state.SetItemsProcessed(state.iterations() * s_shapeCount);
+}
+
+BENCHMARK_TEMPLATE(SpaceFloatingQuadTreeInsert, float)->Apply(allWorkloads);
+BENCHMARK_TEMPLATE(SpaceFloatingQuadTreeInsert, double)->Apply(allWorkloads);
+
+template <typename TFloating>
+static void SpaceFloatingQuadTreeQuery(benchmark::State& state)
+{
+    const auto& data = workloadOf(state);
+    space::QuadTree<space::Rect<TFloating>> quadTree;
+    for (const auto& rect : data.rects)
+    {
+        quadTree.insert(floatingRectOf<TFloating>(rect));
+    }
+    std::vector<space::Rect<TFloating>> queries;
+    std::ranges::transform(data.queries, std::back_inserter(queries), floatingRectOf<TFloating>);
+
+    std::vector<space::Rect<TFloating>> found;
+    std::size_t foundCount = 0;
+    for (auto _ : state)
+    {
+        foundCount = 0;
+        for (const auto& query : queries)
+        {
+            quadTree.query(query, std::back_inserter(found));
+            foundCount += std::size(found);
+            found.clear();
+        }
+    }
+    state.counters["found_per_query"] = static_cast<double>(foundCount) / s_queryCount;
+    state.SetItemsProcessed(state.iterations() * s_queryCount);
+}
+
+BENCHMARK_TEMPLATE(SpaceFloatingQuadTreeQuery, float)->Apply(allWorkloads);
+BENCHMARK_TEMPLATE(SpaceFloatingQuadTreeQuery, double)->Apply(allWorkloads);
+
+static void BoostRTreeChurn(benchmark::State& state)
+{
+    const auto& data = workloadOf(state);
+    TRTree rtree;
+    for (const auto& rect : data.boostRects)
+    {
+        rtree.insert(std::make_pair(rect, false));
+    }
+    std::vector<std::pair<box, box>> moves;
+    for (const auto& [from, to] : data.moves)
+    {
+        moves.emplace_back(test_util::spaceToBoostRect(from), test_util::spaceToBoostRect(to));
+    }
+
+    for (auto _ : state)
+    {
+        for (auto& [from, to] : moves)
+        {
+            rtree.remove(std::make_pair(from, false));
+            rtree.insert(std::make_pair(to, false));
+            std::swap(from, to);
+        }
+    }
+    benchmark::DoNotOptimize(rtree.size());
+    state.SetItemsProcessed(state.iterations() * s_moveCount);
+}
+
+BENCHMARK(BoostRTreeChurn)->Apply(allWorkloads);
+
+static void SpaceQuadTreeChurn(benchmark::State& state)
+{
+    const auto& data = workloadOf(state);
+    space::QuadTree<space::Rect<TCrt>> quadTree {data.rects};
+    auto moves = data.moves;
+
+    for (auto _ : state)
+    {
+        for (auto& [from, to] : moves)
+        {
+            quadTree.update(from, to);
+            std::swap(from, to);
+        }
+    }
+    benchmark::DoNotOptimize(quadTree.size());
+    state.SetItemsProcessed(state.iterations() * s_moveCount);
+}
+
+BENCHMARK(SpaceQuadTreeChurn)->Apply(allWorkloads);
+
+static void SimplePolygonContainsWorkload(benchmark::State& state)
+{
+    const auto distribution = static_cast<workload::Distribution>(state.range(0));
+    state.SetLabel(workload::nameOf(distribution));
+    const auto polygon = workload::Generator::starPolygonOf(
+        space::Rect<TCrt> {{0, 0}, workload::s_worldSize, workload::s_worldSize}, static_cast<std::size_t>(state.range(1)));
+    workload::Generator generator {distribution, workload::ShapeSize::Point, 42};
+    std::vector<space::Point<TCrt>> points;
+    for (int i = 0; i < s_queryCount; ++i)
+    {
+        points.push_back(generator.next().pos());
+    }
+
+    std::size_t matched = 0;
+    for (auto _ : state)
+    {
+        for (const auto& point : points)
+        {
+            matched += space::util::contains(polygon, point);
+        }
+    }
+    benchmark::DoNotOptimize(matched);
+    state.SetItemsProcessed(state.iterations() * s_queryCount);
+}
+
+BENCHMARK(SimplePolygonContainsWorkload)->ArgsProduct({{0, 1, 2, 3}, {16, 256}})->ArgNames({"distribution", "vertices"});
+
+static void SimplePolygonIntersectWorkload(benchmark::State& state)
+{
+    const auto distribution = static_cast<workload::Distribution>(state.range(0));
+    state.SetLabel(workload::nameOf(distribution));
+    const auto vertexCount = static_cast<std::size_t>(state.range(1));
+    workload::Generator generator {distribution, workload::ShapeSize::Small, 42};
+    std::vector<std::pair<space::SimplePolygon<TCrt>, space::SimplePolygon<TCrt>>> pairs;
+    for (int i = 0; i < s_queryCount; ++i)
+    {
+        const auto rect = generator.next();
+        pairs.emplace_back(workload::Generator::starPolygonOf(rect, vertexCount)
+                           , workload::Generator::starPolygonOf(generator.moved(rect, 500), vertexCount));
+    }
+
+    std::size_t matched = 0;
+    for (auto _ : state)
+    {
+        for (const auto& [first, second] : pairs)
+        {
+            matched += space::util::hasIntersect(first, second);
+        }
+    }
+    benchmark::DoNotOptimize(matched);
+    state.SetItemsProcessed(state.iterations() * s_queryCount);
+}
+
+BENCHMARK(SimplePolygonIntersectWorkload)->ArgsProduct({{0, 1, 2, 3}, {4, 16}})->ArgNames({"distribution", "vertices"});
+
+int main(int argc, char** argv)
+{
+    ::benchmark::Initialize(&argc, argv);
+    if (::benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+    ::benchmark::RunSpecifiedBenchmarks();
+}
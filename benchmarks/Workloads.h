@@ -0,0 +1,258 @@
+/**
+ * @file        Workloads.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaring the generators of benchmark workloads.
+ * @date        14-10-2026
+ * @copyright   Copyright (c) 2026
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "Rect.h"
+#include "SimplePolygon.h"
+
+namespace workload
+{
+
+using TCrt = int32_t;
+
+/**
+ * @brief   The size of the square world, all generated shapes are inside of it.
+ */
+inline constexpr TCrt s_worldSize = 1'000'000;
+
+/**
+ * @brief   The distribution of shape positions.
+ */
+enum class Distribution
+{
+    Uniform = 0     // The uniform positions over the world.
+    , Clustered = 1 // The normal distributions around the random cluster centers, like cities.
+    , Skewed = 2    // The power law toward the world origin, the density grows 16 times per halving.
+    , Streets = 3   // The thin shapes along the random grid lines, like the bounding boxes of roads.
+};
+
+/**
+ * @brief   The size of shapes.
+ */
+enum class ShapeSize
+{
+    Point = 0       // The shapes of zero width and height.
+    , Small = 1     // The shapes up to 1'000 units, 0.1% of the world.
+    , Large = 2     // The shapes from 10'000 to 100'000 units, up to 10% of the world.
+};
+
+[[nodiscard]]
+inline std::string nameOf(Distribution distribution)
+{
+    constexpr const char* names[] {"uniform", "clustered", "skewed", "streets"};
+    return names[static_cast<std::size_t>(distribution)];
+}
+
+[[nodiscard]]
+inline std::string nameOf(ShapeSize size)
+{
+    constexpr const char* names[] {"point", "small", "large"};
+    return names[static_cast<std::size_t>(size)];
+}
+
+/**
+ * @brief   The generator of rectangles with the given distribution and size.
+ *
+ * @details The generator is seeded, so the workloads are the same on every run and every
+ *          machine (unlike the std::rand based helpers).
+ */
+class Generator
+{
+    static constexpr std::size_t s_clusterCount = 64;
+    static constexpr double s_clusterSigma = s_worldSize / 200.0;
+    static constexpr std::size_t s_streetCount = 512;
+
+public:
+    Generator(Distribution distribution, ShapeSize size, std::uint64_t seed)
+        : m_distribution {distribution}
+        , m_size {size}
+        , m_engine {seed}
+    {
+        for (std::size_t i = 0; i < s_clusterCount; ++i)
+        {
+            m_clusters.push_back(space::Point<TCrt> {uniform(0, s_worldSize), uniform(0, s_worldSize)});
+        }
+        for (std::size_t i = 0; i < s_streetCount; ++i)
+        {
+            m_streets.push_back(uniform(0, s_worldSize));
+        }
+    }
+
+    /**
+     * @brief   Generates the next rectangle.
+     *
+     * @return  The rectangle inside of the world.
+     */
+    [[nodiscard]]
+    space::Rect<TCrt> next()
+    {
+        auto [width, height] = nextExtent();
+        TCrt x = 0;
+        TCrt y = 0;
+        switch (m_distribution)
+        {
+            case Distribution::Uniform:
+                x = uniform(0, s_worldSize);
+                y = uniform(0, s_worldSize);
+                break;
+            case Distribution::Clustered:
+            {
+                const auto& center = m_clusters[static_cast<std::size_t>(uniform(0, static_cast<TCrt>(s_clusterCount - 1)))];
+                std::normal_distribution<double> offset {0.0, s_clusterSigma};
+                x = clamp(center.x() + offset(m_engine));
+                y = clamp(center.y() + offset(m_engine));
+                break;
+            }
+            case Distribution::Skewed:
+            {
+                std::uniform_real_distribution<double> unit {0.0, 1.0};
+                x = clamp(s_worldSize * std::pow(unit(m_engine), 4.0));
+                y = clamp(s_worldSize * std::pow(unit(m_engine), 4.0));
+                break;
+            }
+            case Distribution::Streets:
+            {
+                // The street is horizontal or vertical, the shape is stretched along it.
+                const auto street = m_streets[static_cast<std::size_t>(uniform(0, static_cast<TCrt>(s_streetCount - 1)))];
+                const auto along = uniform(0, s_worldSize);
+                height = (0 == width) ? 0 : std::max<TCrt>(width / 16, 1);
+                if (0 == uniform(0, 1))
+                {
+                    x = along;
+                    y = street;
+                }
+                else
+                {
+                    std::swap(width, height);
+                    x = street;
+                    y = along;
+                }
+                break;
+            }
+        }
+        x = std::min(x, s_worldSize - width);
+        y = std::min(y, s_worldSize - height);
+        return space::Rect<TCrt> {{x, y}, width, height};
+    }
+
+    /**
+     * @brief   Generates the given number of unique rectangles.
+     *
+     * @param   count The number of rectangles.
+     * @return  The rectangles.
+     */
+    [[nodiscard]]
+    std::vector<space::Rect<TCrt>> uniqueRects(std::size_t count)
+    {
+        const auto hash = [](const space::Rect<TCrt>& rect)
+        {
+            const auto position = static_cast<std::uint64_t>(static_cast<std::uint32_t>(rect.pos().x())) << 32
+                | static_cast<std::uint32_t>(rect.pos().y());
+            return std::hash<std::uint64_t> {}(position * 31 + static_cast<std::uint64_t>(rect.width()) * 7
+                                               + static_cast<std::uint64_t>(rect.height()));
+        };
+        std::unordered_set<space::Rect<TCrt>, decltype(hash)> seen(count, hash);
+        std::vector<space::Rect<TCrt>> rects;
+        rects.reserve(count);
+        while (std::size(rects) != count)
+        {
+            const auto rect = next();
+            if (seen.insert(rect).second)
+            {
+                rects.push_back(rect);
+            }
+        }
+        return rects;
+    }
+
+    /**
+     * @brief   Generates the rectangle moved by the local step, stays inside the world.
+     *
+     * @param   rect The rectangle.
+     * @param   maxStep The maximum step by every axis.
+     * @return  The moved rectangle.
+     */
+    [[nodiscard]]
+    space::Rect<TCrt> moved(const space::Rect<TCrt>& rect, TCrt maxStep)
+    {
+        const auto x = std::clamp(rect.pos().x() + uniform(-maxStep, maxStep), 0, s_worldSize - rect.width());
+        const auto y = std::clamp(rect.pos().y() + uniform(-maxStep, maxStep), 0, s_worldSize - rect.height());
+        return space::Rect<TCrt> {{x, y}, rect.width(), rect.height()};
+    }
+
+    /**
+     * @brief   Generates the regular star polygon around the center of the given rectangle.
+     *
+     * @param   rect The rectangle, the outer radius is the half of its bigger side.
+     * @param   vertexCount The number of vertices, the even vertices are on the inner radius.
+     * @return  The simple polygon, concave if vertexCount is at least 6.
+     */
+    [[nodiscard]]
+    static space::SimplePolygon<TCrt> starPolygonOf(const space::Rect<TCrt>& rect, std::size_t vertexCount)
+    {
+        const auto radius = std::max<double>(std::max(rect.width(), rect.height()) / 2.0, 8.0);
+        const auto centerX = rect.pos().x() + rect.width() / 2.0;
+        const auto centerY = rect.pos().y() + rect.height() / 2.0;
+        space::SimplePolygon<TCrt>::TPiecewiseLinearCurve curve;
+        for (auto i = vertexCount; i > 0; --i)
+        {
+            const auto angle = 2 * std::numbers::pi * static_cast<double>(i) / static_cast<double>(vertexCount);
+            const auto vertexRadius = (0 == i % 2) ? radius / 2 : radius;
+            curve.push_back({static_cast<TCrt>(centerX + vertexRadius * std::cos(angle))
+                             , static_cast<TCrt>(centerY + vertexRadius * std::sin(angle))});
+        }
+        return space::SimplePolygon<TCrt> {curve};
+    }
+
+private:
+    [[nodiscard]]
+    std::pair<TCrt, TCrt> nextExtent()
+    {
+        switch (m_size)
+        {
+            case ShapeSize::Point:
+                return {0, 0};
+            case ShapeSize::Small:
+                return {uniform(1, 1'000), uniform(1, 1'000)};
+            case ShapeSize::Large:
+                return {uniform(10'000, 100'000), uniform(10'000, 100'000)};
+        }
+        return {0, 0};
+    }
+
+    [[nodiscard]]
+    TCrt uniform(TCrt from, TCrt to)
+    {
+        return std::uniform_int_distribution<TCrt> {from, to}(m_engine);
+    }
+
+    [[nodiscard]]
+    static TCrt clamp(double value) noexcept
+    {
+        return static_cast<TCrt>(std::clamp(value, 0.0, static_cast<double>(s_worldSize)));
+    }
+
+private:
+    Distribution m_distribution;
+    ShapeSize m_size;
+    std::mt19937_64 m_engine;
+    std::vector<space::Point<TCrt>> m_clusters {};
+    std::vector<TCrt> m_streets {};
+};
+
+} // namespace workload
@@ -0,0 +1,156 @@
+/**
+ * @file        Accumulator.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaring the AccumulatorTraits and the overflow-safe predicates.
+ * @date        14-10-2026
+ * @copyright   Copyright (c) 2026
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "Point.h"
+
+namespace space
+{
+
+#ifdef __SIZEOF_INT128__
+/**
+ * @brief   The 128-bit signed integer, the accumulator of 64-bit coordinates.
+ */
+__extension__ typedef __int128 TInt128;
+#endif
+
+/**
+ * @brief   The traits selecting the type for the products and sums of coordinates.
+ *
+ * @details The products of two coordinate differences are calculated in the accumulator type,
+ *          so the predicates on the coordinates don't overflow. The integers up to 32 bits are
+ *          accumulated in 64 bits, the 64-bit integers in 128 bits (if the compiler supports it),
+ *          the floating point coordinates in double or wider. The orientation determinant of
+ *          integer coordinates is exact while the absolute values of coordinates are less than
+ *          a quarter of the integer range (2^30 for int32_t).
+ *
+ * @tparam  TCrt The type of coordinates.
+ */
+template <typename TCrt>
+struct AccumulatorTraits
+{
+    using TAccumulator = TCrt;
+};
+
+template <typename TCrt>
+    requires (std::is_integral_v<TCrt> && sizeof(TCrt) <= sizeof(std::int32_t))
+struct AccumulatorTraits<TCrt>
+{
+    using TAccumulator = std::int64_t;
+};
+
+#ifdef __SIZEOF_INT128__
+template <typename TCrt>
+    requires (std::is_integral_v<TCrt> && sizeof(TCrt) == sizeof(std::int64_t))
+struct AccumulatorTraits<TCrt>
+{
+    using TAccumulator = space::TInt128;
+};
+#endif
+
+template <typename TCrt>
+    requires (std::is_floating_point_v<TCrt> && sizeof(TCrt) <= sizeof(double))
+struct AccumulatorTraits<TCrt>
+{
+    using TAccumulator = double;
+};
+
+/**
+ * @brief   The accumulator type for the given type of coordinates.
+ *
+ * @tparam  TCrt The type of coordinates.
+ */
+template <typename TCrt>
+using TAccumulatorOf = typename AccumulatorTraits<TCrt>::TAccumulator;
+
+namespace util::impl
+{
+
+/**
+ * @internal
+ * @brief       Returns the sign of a * b - c * d calculated in the type of arguments.
+ *
+ * @details     For integers the result is exact while the products and their difference fit
+ *              the type. For floating point numbers the result is accepted if its absolute
+ *              value exceeds the forward error bound, otherwise (nearly equal products) the
+ *              products are recalculated with the error terms from std::fma in long double.
+ *
+ * @tparam T    The type of arguments, usually the accumulator type of coordinates.
+ * @return      1 if the difference is positive, -1 if negative, otherwise 0.
+ */
+template <typename T>
+[[nodiscard]]
+constexpr int productDifferenceSign(T a, T b, T c, T d) noexcept
+{
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        // The error bound of orient2d from J. R. Shewchuk, "Adaptive Precision Floating-Point
+        // Arithmetic and Fast Robust Geometric Predicates".
+        constexpr auto epsilon = std::numeric_limits<T>::epsilon() / 2;
+        constexpr auto errorBound = (3 + 16 * epsilon) * epsilon;
+
+        const auto left = a * b;
+        const auto right = c * d;
+        const auto difference = left - right;
+        const auto bound = errorBound * (std::abs(left) + std::abs(right));
+        if (difference > bound)
+        {
+            return 1;
+        }
+        if (-difference > bound)
+        {
+            return -1;
+        }
+
+        const auto leftError = std::fma(a, b, -left);
+        const auto rightError = std::fma(c, d, -right);
+        const auto exact = (static_cast<long double>(left) - static_cast<long double>(right))
+            + (static_cast<long double>(leftError) - static_cast<long double>(rightError));
+        return (exact > 0) - (exact < 0);
+    }
+    else
+    {
+        const auto difference = a * b - c * d;
+        return (difference > 0) - (difference < 0);
+    }
+}
+
+/**
+ * @internal
+ * @brief       Returns the sign of the orientation determinant of ordered triplet (p, q, r).
+ *
+ * @details     The determinant is (q.y - p.y) * (r.x - q.x) - (q.x - p.x) * (r.y - q.y),
+ *              it is calculated in the accumulator type by productDifferenceSign.
+ *
+ * @tparam TCrt The type of coordinates.
+ * @param p     The given point.
+ * @param q     The given point.
+ * @param r     The given point.
+ * @return      1 if the determinant is positive, -1 if negative, otherwise 0.
+ */
+template <typename TCrt>
+[[nodiscard]]
+constexpr int orientationSign(const Point<TCrt>& p, const Point<TCrt>& q, const Point<TCrt>& r) noexcept
+{
+    using TAccumulator = TAccumulatorOf<TCrt>;
+
+    return productDifferenceSign(static_cast<TAccumulator>(q.y()) - static_cast<TAccumulator>(p.y())
+                                 , static_cast<TAccumulator>(r.x()) - static_cast<TAccumulator>(q.x())
+                                 , static_cast<TAccumulator>(q.x()) - static_cast<TAccumulator>(p.x())
+                                 , static_cast<TAccumulator>(r.y()) - static_cast<TAccumulator>(q.y()));
+}
+
+} // namespace util::impl
+
+} // namespace space
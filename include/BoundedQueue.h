@@ -0,0 +1,176 @@
+/**
+ * @file        BoundedQueue.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaring the BoundedQueue class.
+ * @date        14-10-2026
+ * @copyright   Copyright (c) 2026
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+#include "Definitions.h"
+
+namespace space::collections
+{
+
+/**
+ * @brief   The bounded lock-free queue for many producers and many consumers.
+ *
+ * @details The ring of cells, every cell has the sequence number which tells whether the cell
+ *          is free for the push of the given position or full for the pop of it. The producers
+ *          and the consumers claim the positions by the CAS of their own counter, so the push
+ *          and the pop touch only one cell and one counter (D. Vyukov's bounded MPMC queue).
+ *          The operations never wait, the full or empty queue is reported to the caller.
+ *
+ * @tparam  T The type of values, must be move constructible.
+ */
+template <typename T>
+class BoundedQueue
+{
+    /**
+     * @brief   The cell of the ring, the sequence is the position of the next push to the cell,
+     *          or the position plus one if the cell is full.
+     */
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence;
+        std::optional<T> value;
+    };
+
+public:
+    using size_type = std::size_t;
+
+    /**
+     * @brief   Initializes the empty queue of the given capacity.
+     *
+     * @details The ring has at least two cells, the sequence of the full cell must differ from
+     *          the position of the next push to the cell.
+     *
+     * @param   capacity The maximum number of values, rounded up to the power of two.
+     * @throw   std::invalid_argument if the capacity is zero.
+     */
+    explicit BoundedQueue(size_type capacity)
+        : m_mask {std::bit_ceil(std::max(capacity, size_type {2})) - 1}
+        , m_cells {std::make_unique<Cell[]>(m_mask + 1)}
+    {
+        if (0 == capacity)
+        {
+            throw std::invalid_argument {"The capacity of queue must not be zero."};
+        }
+        for (size_type i = 0; i <= m_mask; ++i)
+        {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    BoundedQueue(const BoundedQueue&) = delete;
+
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    /**
+     * @brief   Pushes the value to the queue if the queue is not full.
+     *
+     * @param   value The value, moved from only if pushed.
+     * @return  true if pushed, false if the queue is full.
+     */
+    bool tryPush(T& value)
+    {
+        auto position = m_pushPosition.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            auto& cell = m_cells[position & m_mask];
+            const auto sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<std::ptrdiff_t>(sequence - position);
+            if (0 == difference)
+            {
+                if (m_pushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    cell.value.emplace(std::move(value));
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (difference < 0)
+            {
+                return false;
+            }
+            else
+            {
+                position = m_pushPosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief   Pops the oldest value of the queue if the queue is not empty.
+     *
+     * @return  The value, or nullopt if the queue is empty.
+     */
+    std::optional<T> tryPop()
+    {
+        auto position = m_popPosition.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            auto& cell = m_cells[position & m_mask];
+            const auto sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<std::ptrdiff_t>(sequence - (position + 1));
+            if (0 == difference)
+            {
+                if (m_popPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    std::optional<T> value {std::move(cell.value)};
+                    cell.value.reset();
+                    cell.sequence.store(position + m_mask + 1, std::memory_order_release);
+                    return value;
+                }
+            }
+            else if (difference < 0)
+            {
+                return std::nullopt;
+            }
+            else
+            {
+                position = m_popPosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief   Gets the maximum number of values.
+     *
+     * @return  The capacity.
+     */
+    [[nodiscard]]
+    size_type capacity() const noexcept
+    {
+        return m_mask + 1;
+    }
+
+private:
+    /**
+     * @brief   The mask of ring positions, the capacity minus one.
+     */
+    size_type m_mask;
+
+    /**
+     * @brief   The ring of cells.
+     */
+    std::unique_ptr<Cell[]> m_cells;
+
+    /**
+     * @brief   The positions of the next push and the next pop, on separate cache lines.
+     */
+    alignas(64) std::atomic<size_type> m_pushPosition {0};
+    alignas(64) std::atomic<size_type> m_popPosition {0};
+}; // class BoundedQueue
+
+} // namespace space::collections
@@ -0,0 +1,213 @@
+/**
+ * @file        BoxColumns.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaring the BoxColumns class.
+ * @date        14-10-2026
+ * @copyright   Copyright (c) 2026
+ */
+
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <iterator>
+
+#if __has_include(<experimental/simd>)
+#include <experimental/simd>
+#define SPACE_HAS_EXPERIMENTAL_SIMD 1
+#endif
+
+#include "Definitions.h"
+#include "Point.h"
+#include "Rect.h"
+#include "Square.h"
+
+namespace space::collections
+{
+
+/**
+ * @brief   The structure of arrays for the boxes, the corners are stored in separate columns.
+ *
+ * @details The layout allows testing several boxes per instruction, std::experimental::simd
+ *          is used if it is available, otherwise the test is scalar.
+ *
+ * @tparam  TCrt The type of coordinates.
+ */
+template <typename TCrt>
+class BoxColumns
+{
+public:
+    using size_type = std::size_t;
+
+    /**
+     * @brief   Inserts the box before the given position.
+     *
+     * @tparam  TOrthogonalShape The type of orthogonal shape.
+     * @param   index The position.
+     * @param   box The box.
+     */
+    template <typename TOrthogonalShape>
+    void insert(size_type index, const TOrthogonalShape& box)
+    {
+        const auto[x1, y1] = space::util::bottomLeftOf(box);
+        const auto[x2, y2] = space::util::topRightOf(box);
+        const auto offset = static_cast<std::ptrdiff_t>(index);
+        m_minX.insert(m_minX.begin() + offset, x1);
+        m_minY.insert(m_minY.begin() + offset, y1);
+        m_maxX.insert(m_maxX.begin() + offset, x2);
+        m_maxY.insert(m_maxY.begin() + offset, y2);
+    }
+
+    /**
+     * @brief   Removes the box at the given position.
+     *
+     * @param   index The position.
+     */
+    void erase(size_type index)
+    {
+        const auto offset = static_cast<std::ptrdiff_t>(index);
+        m_minX.erase(m_minX.begin() + offset);
+        m_minY.erase(m_minY.begin() + offset);
+        m_maxX.erase(m_maxX.begin() + offset);
+        m_maxY.erase(m_maxY.begin() + offset);
+    }
+
+    /**
+     * @brief   Replaces the content by the given boxes.
+     *
+     * @tparam  TRange The type of range of boxes.
+     * @param   boxes The boxes.
+     */
+    template <typename TRange>
+    void assign(const TRange& boxes)
+    {
+        clear();
+        for (const auto& box : boxes)
+        {
+            insert(size(), box);
+        }
+    }
+
+    /**
+     * @brief   Removes all boxes.
+     */
+    void clear() noexcept
+    {
+        m_minX.clear();
+        m_minY.clear();
+        m_maxX.clear();
+        m_maxY.clear();
+    }
+
+    /**
+     * @brief   Releases the unused capacity of the columns.
+     */
+    void shrink_to_fit()
+    {
+        m_minX.shrink_to_fit();
+        m_minY.shrink_to_fit();
+        m_maxX.shrink_to_fit();
+        m_maxY.shrink_to_fit();
+    }
+
+    /**
+     * @brief   Gets the number of boxes.
+     *
+     * @return  The number of boxes.
+     */
+    [[nodiscard]]
+    size_type size() const noexcept
+    {
+        return std::size(m_minX);
+    }
+
+    /**
+     * @brief   Gets the number of boxes the columns can hold without reallocation.
+     *
+     * @return  The capacity.
+     */
+    [[nodiscard]]
+    size_type capacity() const noexcept
+    {
+        return m_minX.capacity();
+    }
+
+    /**
+     * @brief   Calls the function for the position of every box intersecting the given shape.
+     *
+     * @details The boxes are tested by blocks, every block gives the mask of matches which
+     *          is walked by the set bits, so the function is called in the order of positions.
+     *
+     * @tparam  TOrthogonalShape The type of orthogonal shape.
+     * @tparam  TFunction The type of function, gets the position and returns false to stop.
+     * @param   shape The shape.
+     * @param   function The function.
+     * @return  false if the function stopped the walk, otherwise true.
+     */
+    template <typename TOrthogonalShape, typename TFunction>
+    bool forEachIntersecting(const TOrthogonalShape& shape, TFunction&& function) const
+    {
+        const auto[x1, y1] = space::util::bottomLeftOf(shape);
+        const auto[x2, y2] = space::util::topRightOf(shape);
+        const auto count = size();
+        size_type index = 0;
+
+#ifdef SPACE_HAS_EXPERIMENTAL_SIMD
+        namespace stdx = std::experimental;
+        using TSimd = stdx::native_simd<TCrt>;
+        constexpr auto blockSize = TSimd::size();
+        static_assert(blockSize <= 64, "The mask of block must fit to 64 bits.");
+
+        const TSimd keyMinX {x1};
+        const TSimd keyMinY {y1};
+        const TSimd keyMaxX {x2};
+        const TSimd keyMaxY {y2};
+        for (; index + blockSize <= count; index += blockSize)
+        {
+            const TSimd minX {m_minX.data() + index, stdx::element_aligned};
+            const TSimd minY {m_minY.data() + index, stdx::element_aligned};
+            const TSimd maxX {m_maxX.data() + index, stdx::element_aligned};
+            const TSimd maxY {m_maxY.data() + index, stdx::element_aligned};
+            const auto matches = (maxX >= keyMinX) && (keyMaxX >= minX) && (maxY >= keyMinY) && (keyMaxY >= minY);
+            if (stdx::none_of(matches))
+            {
+                continue;
+            }
+            std::uint64_t mask = 0;
+            for (size_type i = 0; i < blockSize; ++i)
+            {
+                mask |= static_cast<std::uint64_t>(matches[i]) << i;
+            }
+            for (; 0 != mask; mask &= mask - 1)
+            {
+                if (!function(index + static_cast<size_type>(std::countr_zero(mask))))
+                {
+                    return false;
+                }
+            }
+        }
+#endif
+
+        for (; index < count; ++index)
+        {
+            if (m_maxX[index] >= x1 && x2 >= m_minX[index] && m_maxY[index] >= y1 && y2 >= m_minY[index]
+                && !function(index))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+
+    /**
+     * @brief   The columns of the bottom-left and top-right corners coordinates.
+     */
+    space::collections::Vector<TCrt> m_minX {};
+    space::collections::Vector<TCrt> m_minY {};
+    space::collections::Vector<TCrt> m_maxX {};
+    space::collections::Vector<TCrt> m_maxY {};
+}; // class BoxColumns
+
+} // namespace space::collections
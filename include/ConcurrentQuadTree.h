@@ -0,0 +1,468 @@
+/**
+ * @file        ConcurrentQuadTree.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaring the ConcurrentQuadTree class.
+ * @date        14-10-2026
+ * @copyright   Copyright (c) 2026
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "Definitions.h"
+#include "EpochDomain.h"
+#include "InlineStack.h"
+#include "QuadTree.h"
+
+namespace space
+{
+
+/**
+ * @brief   The quadtree which is queried concurrently with the modifications.
+ *
+ * @details The published nodes are immutable. The readers pin the epoch and traverse the
+ *          current version without locks. The writers are serialized by a mutex, every write
+ *          copies only the nodes of the root-to-node path of the key (the values of the other
+ *          path nodes are shared between the versions) and publishes the new root atomically.
+ *          The replaced nodes are deleted by the epoch-based reclamation, once no reader can
+ *          see them. The layout of regions is the same as for QuadTree with the same policy,
+ *          the values are not mirrored to the columns.
+ *
+ * @tparam  TKey The type of values, must be ordered and have the IndexableTraits specialization.
+ * @tparam  TPolicy The policy of quadtree, see DefaultQuadTreePolicy.
+ */
+template <typename TKey, typename TPolicy = DefaultQuadTreePolicy>
+class ConcurrentQuadTree
+{
+    using TLayout = QuadTree<TKey, TPolicy>;
+    using TRegion = typename TLayout::TRegion;
+    using TValueContainer = space::collections::FlatSet<TKey>;
+
+public:
+    using TBox = typename TLayout::TBox;
+    using TCoordinate = typename TLayout::TCoordinate;
+    using size_type = std::size_t;
+
+private:
+    /**
+     * @brief   The node of quadtree, immutable after publishing.
+     */
+    struct Node
+    {
+        TRegion region {};
+        space::collections::Array<const Node*, 4> children {nullptr, nullptr, nullptr, nullptr};
+
+        /**
+         * @brief   The values of node, null if the node has no values.
+         */
+        std::shared_ptr<const TValueContainer> values {};
+
+        [[nodiscard]]
+        bool empty() const noexcept
+        {
+            return (nullptr == values || values->empty())
+                && std::ranges::all_of(children, [](const auto* child) { return nullptr == child; });
+        }
+    };
+
+    /**
+     * @brief   The stack for the depth-first traversal, see QuadTree::TTraversalStack.
+     */
+    using TTraversalStack = space::collections::InlineStack<const Node*, 3 * TLayout::s_maxDepth + 4>;
+
+    /**
+     * @brief   The nodes on the path from the root.
+     */
+    using TNodePath = space::collections::Array<const Node*, TLayout::s_maxDepth + 1>;
+
+    /**
+     * @brief   The nodes created by the write, owned by the write until publishing.
+     */
+    using TDraft = space::collections::Vector<std::unique_ptr<Node>>;
+
+public:
+    ConcurrentQuadTree() = default;
+
+    ConcurrentQuadTree(const ConcurrentQuadTree&) = delete;
+
+    ConcurrentQuadTree& operator=(const ConcurrentQuadTree&) = delete;
+
+    /**
+     * @brief   Destroys the tree, there must be no concurrent readers and writers.
+     */
+    ~ConcurrentQuadTree()
+    {
+        deleteSubtree(m_root.load());
+    }
+
+    /**
+     * @brief   Inserts the given key, the concurrent queries see either the old or the new version.
+     *
+     * @details The path nodes are copied and the missing nodes are created, the tree grows up
+     *          if the key is outside of the root region.
+     *
+     * @param   key The key.
+     * @return  true if the key is inserted, false if it is already stored.
+     */
+    bool insert(const TKey& key)
+    {
+        const auto& box = TLayout::indexableOf(key);
+        std::lock_guard lock {m_writerMutex};
+        const auto* root = m_root.load();
+        if (nullptr != root && containsIn(root, key))
+        {
+            return false;
+        }
+
+        TDraft draft;
+        space::collections::Vector<const Node*> replaced;
+        const auto makeNode = [&draft](Node node)
+        {
+            draft.push_back(std::make_unique<Node>(std::move(node)));
+            return draft.back().get();
+        };
+        const auto own = [&draft, &replaced, &makeNode](const Node* node)
+        {
+            const auto it = std::ranges::find(draft, node, &std::unique_ptr<Node>::get);
+            if (draft.end() != it)
+            {
+                return it->get();
+            }
+            replaced.push_back(node);
+            return makeNode(*node);
+        };
+
+        Node* current = nullptr;
+        if (nullptr == root)
+        {
+            current = makeNode(Node {TLayout::makeRegionFor(box)});
+        }
+        else
+        {
+            const Node* top = root;
+            while (!TLayout::isInside(box, top->region))
+            {
+                const auto[region, oldRootPos] = TLayout::grownRegionOf(top->region, box);
+                auto* grown = makeNode(Node {region});
+                grown->children[static_cast<std::size_t>(oldRootPos)] = top;
+                top = grown;
+            }
+            current = own(top);
+        }
+        const auto* newRoot = current;
+        while (!TLayout::isTerminal(box, current->region))
+        {
+            const auto zOrderPos = TLayout::getZOrderPos(current->region, box);
+            auto& child = current->children[static_cast<std::size_t>(zOrderPos)];
+            auto* next = (nullptr == child) ? makeNode(Node {TLayout::makeChildRegion(current->region, zOrderPos)})
+                                            : own(child);
+            child = next;
+            current = next;
+        }
+        auto values = (nullptr == current->values) ? std::make_shared<TValueContainer>()
+                                                   : std::make_shared<TValueContainer>(*current->values);
+        values->insert(key);
+        current->values = std::move(values);
+
+        publish(newRoot, draft, replaced);
+        m_size.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief   Removes the given key, the concurrent queries see either the old or the new version.
+     *
+     * @details The path nodes are copied, the nodes which became empty are dropped.
+     *
+     * @param   key The key.
+     * @return  true if the key is removed, false if it is not stored.
+     */
+    bool remove(const TKey& key)
+    {
+        const auto& box = TLayout::indexableOf(key);
+        std::lock_guard lock {m_writerMutex};
+        const auto* root = m_root.load();
+        if (nullptr == root)
+        {
+            return false;
+        }
+        TNodePath path;
+        std::size_t depth = 0;
+        path[0] = root;
+        while (!TLayout::isTerminal(box, path[depth]->region))
+        {
+            const auto* child = path[depth]->children[static_cast<std::size_t>(TLayout::getZOrderPos(path[depth]->region, box))];
+            if (nullptr == child)
+            {
+                return false;
+            }
+            path[++depth] = child;
+        }
+        const auto& oldValues = path[depth]->values;
+        if (nullptr == oldValues || oldValues->end() == oldValues->find(key))
+        {
+            return false;
+        }
+
+        TDraft draft;
+        const auto makeNode = [&draft](Node node) -> const Node*
+        {
+            if (node.empty())
+            {
+                return nullptr;
+            }
+            draft.push_back(std::make_unique<Node>(std::move(node)));
+            return draft.back().get();
+        };
+        auto values = std::make_shared<TValueContainer>(*oldValues);
+        values->erase(key);
+        Node node {*path[depth]};
+        node.values = values->empty() ? nullptr : std::move(values);
+        const auto* replacement = makeNode(std::move(node));
+        for (auto level = depth; level-- > 0;)
+        {
+            Node parent {*path[level]};
+            *std::ranges::find(parent.children, path[level + 1]) = replacement;
+            replacement = makeNode(std::move(parent));
+        }
+
+        space::collections::Vector<const Node*> replaced {path.begin(), path.begin() + static_cast<std::ptrdiff_t>(depth + 1)};
+        publish(replacement, draft, replaced);
+        m_size.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief   Finds values intersecting the given rectangle in the current version.
+     *
+     * @tparam  TOutIt The type of output iterator.
+     * @param   key The rectangle for query.
+     * @param   outIt The output iterator.
+     */
+    template <typename TOutIt>
+    void query(const TBox& key, TOutIt outIt) const
+    {
+        const auto guard = m_epochs.pin();
+        visitIntersecting(m_root.load(), key, [&outIt](const TKey& value)
+        {
+            *outIt++ = value;
+            return true;
+        });
+    }
+
+    /**
+     * @brief   Checks if any value intersects the given rectangle in the current version.
+     *
+     * @param   key The rectangle for query.
+     * @return  true if there is an intersecting value, otherwise false.
+     */
+    [[nodiscard]]
+    bool queryAny(const TBox& key) const
+    {
+        const auto guard = m_epochs.pin();
+        return !visitIntersecting(m_root.load(), key, [](const TKey&)
+        {
+            return false;
+        });
+    }
+
+    /**
+     * @brief   Counts values intersecting the given rectangle in the current version.
+     *
+     * @param   key The rectangle for query.
+     * @return  The number of intersecting values.
+     */
+    [[nodiscard]]
+    size_type queryCount(const TBox& key) const
+    {
+        const auto guard = m_epochs.pin();
+        size_type count = 0;
+        visitIntersecting(m_root.load(), key, [&count](const TKey&)
+        {
+            ++count;
+            return true;
+        });
+        return count;
+    }
+
+    /**
+     * @brief   Determines whether the current version contains the specified key.
+     *
+     * @param   key The key to locate.
+     * @return  true if the key is stored, otherwise false.
+     */
+    [[nodiscard]]
+    bool contains(const TKey& key) const
+    {
+        const auto guard = m_epochs.pin();
+        const auto* root = m_root.load();
+        return nullptr != root && containsIn(root, key);
+    }
+
+    /**
+     * @brief   Get the number of values stored in the index.
+     *
+     * @return  The number of values, which may be outdated for the concurrent writes.
+     */
+    [[nodiscard]]
+    size_type size() const noexcept
+    {
+        return m_size.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief   Checks the container empty or not.
+     *
+     * @return  true if the container is empty, otherwise false.
+     */
+    [[nodiscard]]
+    bool empty() const noexcept
+    {
+        return 0 == size();
+    }
+
+private:
+    /**
+     * @internal
+     * @brief   Checks if the version with the given root contains the key.
+     *
+     * @param   root The root of version, not null.
+     * @param   key The key.
+     * @return  true if the key is stored, otherwise false.
+     */
+    static bool containsIn(const Node* root, const TKey& key)
+    {
+        const auto& box = TLayout::indexableOf(key);
+        const auto* current = root;
+        while (!TLayout::isTerminal(box, current->region))
+        {
+            current = current->children[static_cast<std::size_t>(TLayout::getZOrderPos(current->region, box))];
+            if (nullptr == current)
+            {
+                return false;
+            }
+        }
+        return nullptr != current->values && current->values->end() != current->values->find(key);
+    }
+
+    /**
+     * @internal
+     * @brief   Visits values intersecting the given rectangle, see QuadTree::visitIntersecting.
+     *
+     * @tparam  TVisitor The type of visitor, returns false to stop the traversal.
+     * @param   root The root of version, the epoch must be pinned.
+     * @param   key The rectangle.
+     * @param   visitor The visitor.
+     * @return  false if the visitor stopped the traversal, otherwise true.
+     */
+    template <typename TVisitor>
+    static bool visitIntersecting(const Node* root, const TBox& key, TVisitor&& visitor)
+    {
+        if (nullptr == root)
+        {
+            return true;
+        }
+        TTraversalStack nodeStack;
+        nodeStack.push(root);
+
+        while (!nodeStack.empty())
+        {
+            const Node& currentNode = *nodeStack.top();
+            nodeStack.pop();
+            const auto bounds = TLayout::boundsOf(currentNode.region);
+            if (!space::util::hasIntersect(key, bounds))
+            {
+                continue;
+            }
+            for (const auto* child : currentNode.children)
+            {
+                if (nullptr != child)
+                {
+                    nodeStack.push(child);
+                }
+            }
+            if (nullptr == currentNode.values)
+            {
+                continue;
+            }
+            const bool isCovered = space::util::contains(key, bounds);
+            for (const auto& value : *currentNode.values)
+            {
+                if ((isCovered || space::util::hasIntersect(key, TLayout::indexableOf(value))) && !visitor(value))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @internal
+     * @brief   Publishes the new version and retires the replaced nodes.
+     *
+     * @param   root The root of new version.
+     * @param   draft The nodes created for the new version.
+     * @param   replaced The nodes which are not reachable from the new root.
+     */
+    void publish(const Node* root, TDraft& draft, space::collections::Span<const Node* const> replaced)
+    {
+        for (auto& node : draft)
+        {
+            static_cast<void>(node.release());
+        }
+        m_root.store(root);
+        for (const auto* node : replaced)
+        {
+            m_epochs.retire(std::unique_ptr<const Node> {node});
+        }
+        m_epochs.reclaim();
+    }
+
+    /**
+     * @internal
+     * @brief   Deletes the nodes of the given subtree.
+     *
+     * @param   node The root of subtree.
+     */
+    static void deleteSubtree(const Node* node)
+    {
+        if (nullptr == node)
+        {
+            return;
+        }
+        for (const auto* child : node->children)
+        {
+            deleteSubtree(child);
+        }
+        delete node;
+    }
+
+private:
+    /**
+     * @brief   The root of the current version.
+     */
+    std::atomic<const Node*> m_root {nullptr};
+
+    /**
+     * @brief   The number of values of the current version.
+     */
+    std::atomic<size_type> m_size {0};
+
+    /**
+     * @brief   Serializes the writers.
+     */
+    std::mutex m_writerMutex {};
+
+    /**
+     * @brief   The reclamation of the replaced nodes.
+     */
+    mutable space::collections::EpochDomain<const Node> m_epochs {};
+}; // class ConcurrentQuadTree
+
+} // namespace space
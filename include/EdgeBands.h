@@ -0,0 +1,260 @@
+/**
+ * @file        EdgeBands.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaring the EdgeBands class.
+ * @date        14-10-2026
+ * @copyright   Copyright (c) 2026
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+
+#include "Definitions.h"
+#include "Point.h"
+#include "Rect.h"
+#include "SimplePolygon.h"
+#include "Utility.h"
+
+namespace space
+{
+
+/**
+ * @class   EdgeBands
+ * @brief   The point location acceleration structure for large simple polygons.
+ *
+ * @details The y-axis range of the polygon is split into the horizontal bands of equal height,
+ *          the number of bands is up to the number of edges. Every edge is stored in all
+ *          bands overlapped by its y-axis range, the edges of one band are stored contiguously.
+ *          The point test finds the band of point in O(1) and runs the crossing number test
+ *          only on the edges of this band, so for polygons with short edges the average cost
+ *          is proportional to the number of edges crossing a horizontal line, not to the
+ *          number of vertices. The number of bands is reduced for polygons with long edges,
+ *          so the memory stays O(n). The points on the boundary are inside, as for
+ *          space::util::contains.
+ *
+ * @tparam  TCrt The type of coordinate.
+ */
+template <typename TCrt>
+class EdgeBands
+{
+public:
+    /**
+     * @brief   The type of coordinate.
+     */
+    using TCoordinate = TCrt;
+
+    /**
+     * @brief   The type of points.
+     */
+    using TPoint = space::Point<TCoordinate>;
+
+    /**
+     * @brief   The edge of the polygon stored in bands.
+     */
+    struct Edge
+    {
+        TPoint first;
+        TPoint second;
+    };
+
+    /**
+     * @brief   The upper bound of the average number of bands storing one edge.
+     */
+    static constexpr std::size_t s_maxEdgeCopies = 4;
+
+public:
+    EdgeBands() = delete;
+
+    /**
+     * @brief   Builds the bands for the boundary of the given simple polygon.
+     *
+     * @details The complexity is O(n + k), where k is the total number of edge and band pairs.
+     *
+     * @throws  std::out_of_range if the polygon is empty.
+     *
+     * @param   polygon The simple polygon.
+     */
+    explicit EdgeBands(const space::SimplePolygon<TCoordinate>& polygon)
+        : m_boundaryBox {space::util::boundaryBoxOf(polygon)}
+    {
+        const auto& curve = polygon.boundaryCurve();
+        const auto edgeCount = std::size(curve);
+        const auto height = static_cast<double>(m_boundaryBox.height());
+
+        // An edge is stored in about (its height / band height + 1) bands, the number of bands
+        // is limited so that the total number of stored edges is at most s_maxEdgeCopies times
+        // the number of edges.
+        double totalEdgeHeight = 0.0;
+        for (std::size_t edge = 0; edge < edgeCount; ++edge)
+        {
+            const auto& first = curve[edge];
+            const auto& second = curve[(edge + 1) % edgeCount];
+            totalEdgeHeight += std::abs(static_cast<double>(second.y()) - static_cast<double>(first.y()));
+        }
+        const auto maxBandCount = totalEdgeHeight > 0
+            ? (s_maxEdgeCopies - 1) * height * static_cast<double>(edgeCount) / totalEdgeHeight
+            : static_cast<double>(edgeCount);
+        m_bandCount = std::clamp<std::size_t>(static_cast<std::size_t>(std::min(maxBandCount, static_cast<double>(edgeCount)))
+                                              , 1, std::max<std::size_t>(edgeCount, 1));
+        m_bandScale = height > 0 ? static_cast<double>(m_bandCount) / height : 0.0;
+
+        m_bandOffsets.assign(m_bandCount + 1, 0);
+        forEachEdgeBand(curve, [this](std::size_t, std::size_t band)
+        {
+            ++m_bandOffsets[band + 1];
+        });
+        std::partial_sum(m_bandOffsets.begin(), m_bandOffsets.end(), m_bandOffsets.begin());
+
+        m_edges.resize(m_bandOffsets.back());
+        auto cursors = m_bandOffsets;
+        forEachEdgeBand(curve, [this, &curve, &cursors](std::size_t edge, std::size_t band)
+        {
+            m_edges[cursors[band]++] = Edge {curve[edge], curve[(edge + 1) % std::size(curve)]};
+        });
+        m_vertexCount = edgeCount;
+    }
+
+    /**
+     * @brief   Gets the boundary box of the polygon.
+     *
+     * @return  The const reference to the boundary box.
+     */
+    [[nodiscard]]
+    const space::Rect<TCoordinate>& boundaryBox() const noexcept
+    {
+        return m_boundaryBox;
+    }
+
+    /**
+     * @brief   Gets the number of bands.
+     *
+     * @return  The number of bands.
+     */
+    [[nodiscard]]
+    std::size_t bandCount() const noexcept
+    {
+        return m_bandCount;
+    }
+
+    /**
+     * @brief   Gets the edges stored in the band containing the given y-axis coordinate.
+     *
+     * @param   y The y-axis coordinate inside the boundary box.
+     * @return  The span on the edges of the band.
+     */
+    [[nodiscard]]
+    space::collections::Span<const Edge> bandOf(TCoordinate y) const noexcept
+    {
+        const auto band = bandIndexOf(y);
+        return space::collections::Span<const Edge> {m_edges}.subspan(m_bandOffsets[band]
+            , m_bandOffsets[band + 1] - m_bandOffsets[band]);
+    }
+
+    /**
+     * @brief   Checks the given point is inside or on the boundary of the polygon.
+     *
+     * @param   point The point.
+     * @return  true if contains, otherwise false.
+     */
+    [[nodiscard]]
+    bool contains(const TPoint& point) const noexcept
+    {
+        if (m_vertexCount < 3 || !space::util::hasIntersect(m_boundaryBox, space::Rect<TCoordinate> {point, point}))
+        {
+            return false;
+        }
+
+        bool isInside = false;
+        for (const auto& [first, second] : bandOf(point.y()))
+        {
+            const auto crossing = space::util::impl::rayCrossingOf(first, second, point);
+            if (space::util::impl::ERayCrossing::boundary == crossing)
+            {
+                return true;
+            }
+            isInside ^= (space::util::impl::ERayCrossing::crossing == crossing);
+        }
+        return isInside;
+    }
+
+private:
+
+    /**
+     * @internal
+     * @brief       Gets the index of band containing the given y-axis coordinate.
+     *
+     * @param y     The y-axis coordinate.
+     * @return      The band index.
+     */
+    [[nodiscard]]
+    std::size_t bandIndexOf(TCoordinate y) const noexcept
+    {
+        const auto offset = (static_cast<double>(y) - static_cast<double>(m_boundaryBox.pos().y())) * m_bandScale;
+        if (offset <= 0)
+        {
+            return 0;
+        }
+        return std::min(static_cast<std::size_t>(offset), m_bandCount - 1);
+    }
+
+    /**
+     * @internal
+     * @brief       Calls the given function for every pair of edge and band overlapped by the edge.
+     *
+     * @param curve The boundary curve.
+     * @param fn    The function accepting the edge index and the band index.
+     */
+    template <typename TFn>
+    void forEachEdgeBand(const typename space::SimplePolygon<TCoordinate>::TPiecewiseLinearCurve& curve, TFn fn) const
+    {
+        const auto edgeCount = std::size(curve);
+        for (std::size_t edge = 0; edge < edgeCount; ++edge)
+        {
+            const auto& first = curve[edge];
+            const auto& second = curve[(edge + 1) % edgeCount];
+            const auto lastBand = bandIndexOf(std::max(first.y(), second.y()));
+            for (auto band = bandIndexOf(std::min(first.y(), second.y())); band <= lastBand; ++band)
+            {
+                fn(edge, band);
+            }
+        }
+    }
+
+private:
+
+    /**
+     * @brief   The boundary box of the polygon.
+     */
+    space::Rect<TCoordinate> m_boundaryBox;
+
+    /**
+     * @brief   The number of polygon vertices.
+     */
+    std::size_t m_vertexCount {0};
+
+    /**
+     * @brief   The number of bands.
+     */
+    std::size_t m_bandCount {1};
+
+    /**
+     * @brief   The number of bands per unit of y-axis.
+     */
+    double m_bandScale {0.0};
+
+    /**
+     * @brief   The edges of the band i are stored in [m_bandOffsets[i], m_bandOffsets[i + 1]).
+     */
+    space::collections::Vector<std::size_t> m_bandOffsets {};
+
+    /**
+     * @brief   The edges grouped by bands.
+     */
+    space::collections::Vector<Edge> m_edges {};
+}; // class EdgeBands
+
+} // namespace space
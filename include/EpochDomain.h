@@ -0,0 +1,200 @@
+/**
+ * @file        EpochDomain.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaring the EpochDomain class.
+ * @date        14-10-2026
+ * @copyright   Copyright (c) 2026
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <utility>
+
+#include "Definitions.h"
+
+namespace space::collections
+{
+
+/**
+ * @brief   The epoch-based reclamation of objects which are still reachable by the readers.
+ *
+ * @details The reader pins the current epoch for the time of its access, the writer retires
+ *          unlinked objects with the current epoch and advances the epoch. The object is
+ *          deleted once all pinned epochs are greater than its retire epoch, i.e. no reader
+ *          which could see the object is active. Pinning is lock-free, every reader takes one
+ *          of the fixed slots (the slots are on separate cache lines, so the readers don't
+ *          contend). The retire and reclaim functions must be serialized by the writer.
+ *
+ * @tparam  T The type of retired objects.
+ * @tparam  SlotCount The maximum number of concurrently pinned readers, the extra readers wait.
+ */
+template <typename T, std::size_t SlotCount = 128>
+class EpochDomain
+{
+    static_assert(SlotCount != 0, "SlotCount must not be zero.");
+
+    /**
+     * @brief   The epoch of the slot which is not pinned.
+     */
+    static constexpr std::uint64_t s_freeSlot = 0;
+
+    /**
+     * @brief   The epoch pinned by one reader.
+     */
+    struct alignas(64) Slot
+    {
+        std::atomic<std::uint64_t> epoch {s_freeSlot};
+    };
+
+public:
+    using size_type = std::size_t;
+
+    /**
+     * @brief   The pin of the epoch, the objects retired after the pin are not deleted until
+     *          the guard is destroyed.
+     */
+    class Guard
+    {
+    public:
+        explicit Guard(Slot& slot) noexcept
+            : m_slot(std::addressof(slot))
+        {
+        }
+
+        Guard(Guard&& other) noexcept
+            : m_slot(std::exchange(other.m_slot, nullptr))
+        {
+        }
+
+        Guard(const Guard&) = delete;
+
+        Guard& operator=(const Guard&) = delete;
+
+        Guard& operator=(Guard&&) = delete;
+
+        ~Guard()
+        {
+            if (nullptr != m_slot)
+            {
+                m_slot->epoch.store(s_freeSlot, std::memory_order_release);
+            }
+        }
+
+    private:
+        Slot* m_slot;
+    };
+
+    EpochDomain() = default;
+
+    EpochDomain(const EpochDomain&) = delete;
+
+    EpochDomain& operator=(const EpochDomain&) = delete;
+
+    /**
+     * @brief   Deletes all retired objects, there must be no pinned readers.
+     */
+    ~EpochDomain() = default;
+
+    /**
+     * @brief   Pins the current epoch for the calling reader.
+     *
+     * @details The slot search starts from the slot of the calling thread, the thread waits
+     *          if all slots are pinned.
+     *
+     * @return  The guard of the pin.
+     */
+    [[nodiscard]]
+    Guard pin() noexcept
+    {
+        const auto start = std::hash<std::thread::id> {}(std::this_thread::get_id());
+        for (;;)
+        {
+            for (size_type i = 0; i < SlotCount; ++i)
+            {
+                auto& slot = m_slots[(start + i) % SlotCount];
+                auto expected = s_freeSlot;
+                if (slot.epoch.compare_exchange_strong(expected, m_epoch.load()))
+                {
+                    return Guard {slot};
+                }
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    /**
+     * @brief   Retires the object which is not reachable for the new readers.
+     *
+     * @param   object The object.
+     */
+    void retire(std::unique_ptr<T> object)
+    {
+        m_retired.emplace_back(m_epoch.load(), std::move(object));
+    }
+
+    /**
+     * @brief   Advances the epoch and deletes the retired objects which are not reachable
+     *          for the pinned readers.
+     *
+     * @details The scan of slots is skipped while the number of retired objects is less than
+     *          the given threshold, so the cost is amortized over several writes.
+     *
+     * @param   threshold The number of retired objects to start the scan.
+     */
+    void reclaim(size_type threshold = 64)
+    {
+        const auto epoch = m_epoch.fetch_add(1) + 1;
+        if (std::size(m_retired) < threshold)
+        {
+            return;
+        }
+        auto minEpoch = epoch;
+        for (const auto& slot : m_slots)
+        {
+            const auto slotEpoch = slot.epoch.load();
+            if (s_freeSlot != slotEpoch)
+            {
+                minEpoch = std::min(minEpoch, slotEpoch);
+            }
+        }
+        std::erase_if(m_retired, [minEpoch](const auto& retired)
+        {
+            return retired.first < minEpoch;
+        });
+    }
+
+    /**
+     * @brief   Gets the number of retired objects which are not deleted yet.
+     *
+     * @return  The number of retired objects.
+     */
+    [[nodiscard]]
+    size_type retiredCount() const noexcept
+    {
+        return std::size(m_retired);
+    }
+
+private:
+    /**
+     * @brief   The current epoch, starts from one since zero marks the free slots.
+     */
+    std::atomic<std::uint64_t> m_epoch {1};
+
+    /**
+     * @brief   The pinned epochs of readers.
+     */
+    space::collections::Array<Slot, SlotCount> m_slots {};
+
+    /**
+     * @brief   The retired objects with their retire epochs, accessed only by the writer.
+     */
+    space::collections::Vector<std::pair<std::uint64_t, std::unique_ptr<T>>> m_retired {};
+}; // class EpochDomain
+
+} // namespace space::collections
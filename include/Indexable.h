@@ -0,0 +1,93 @@
+/**
+ * @file        Indexable.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaring the customisation point for values of spatial indexes.
+ * @date        14-10-2026
+ * @copyright   Copyright (c) 2026
+ */
+
+#pragma once
+
+#include <utility>
+
+#include "Rect.h"
+#include "SimplePolygon.h"
+#include "Polygon.h"
+
+namespace space
+{
+
+/**
+ * @brief   The customisation point which gives the bounding box of the value stored in
+ *          a spatial index.
+ *
+ * @details The specialization must define the TBox type (space::Rect) and the static function
+ *          indexableOf(value) which returns the box for the value. The box must not change
+ *          while the value is stored in the index.
+ *
+ * @tparam  TValue The type of values.
+ */
+template <typename TValue>
+struct IndexableTraits;
+
+/**
+ * @brief   The rectangle is the box itself.
+ *
+ * @tparam  TCrt The type of coordinates.
+ */
+template <typename TCrt>
+struct IndexableTraits<space::Rect<TCrt>>
+{
+    using TBox = space::Rect<TCrt>;
+
+    [[nodiscard]]
+    static constexpr const TBox& indexableOf(const space::Rect<TCrt>& value) noexcept
+    {
+        return value;
+    }
+};
+
+/**
+ * @brief   The pair of box and payload (i.e. the feature id), the box is the first.
+ *
+ * @tparam  TCrt The type of coordinates.
+ * @tparam  TPayload The type of payload.
+ */
+template <typename TCrt, typename TPayload>
+struct IndexableTraits<std::pair<space::Rect<TCrt>, TPayload>>
+{
+    using TBox = space::Rect<TCrt>;
+
+    [[nodiscard]]
+    static constexpr const TBox& indexableOf(const std::pair<space::Rect<TCrt>, TPayload>& value) noexcept
+    {
+        return value.first;
+    }
+};
+
+namespace util
+{
+
+/**
+ * @brief   Makes the compact value for a spatial index, the boundary box of the shape with
+ *          the payload.
+ *
+ * @details The box is computed once, so the index stores and compares only the box and
+ *          the payload instead of the whole shape.
+ *
+ * @tparam  TShape The type of shape, must have the boundaryBoxOf overload.
+ * @tparam  TPayload The type of payload.
+ * @param   shape The shape.
+ * @param   payload The payload (i.e. the feature id).
+ * @return  The pair of boundary box and payload.
+ */
+template <typename TShape, typename TPayload>
+[[nodiscard]]
+constexpr auto makeIndexable(const TShape& shape, TPayload payload)
+{
+    return std::pair {boundaryBoxOf(shape), std::move(payload)};
+}
+
+} // namespace util
+
+} // namespace space
@@ -0,0 +1,113 @@
+/**
+ * @file        InlineStack.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaring the InlineStack class.
+ * @date        14-10-2026
+ * @copyright   Copyright (c) 2026
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+
+#include "Definitions.h"
+
+namespace space::collections
+{
+
+/**
+ * @brief   The stack with fixed capacity which keeps elements inline.
+ *
+ * @details The stack never allocates memory, so it is suitable for the traversals
+ *          with known bounded depth. Pushing to the full stack is undefined behavior.
+ *
+ * @tparam  T The type of elements, must be default constructible.
+ * @tparam  Capacity The maximum number of elements.
+ */
+template <typename T, std::size_t Capacity>
+class InlineStack
+{
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    /**
+     * @brief   Inserts element at the top.
+     *
+     * @param   value The element.
+     */
+    constexpr void push(const T& value) noexcept
+    {
+        assert(m_size < Capacity && "InlineStack overflow");
+        m_data[m_size++] = value;
+    }
+
+    /**
+     * @brief   Removes the top element.
+     */
+    constexpr void pop() noexcept
+    {
+        assert(0 != m_size);
+        --m_size;
+    }
+
+    /**
+     * @brief   Gets the top element.
+     *
+     * @return  The reference to the top element.
+     */
+    [[nodiscard]]
+    constexpr const T& top() const noexcept
+    {
+        assert(0 != m_size);
+        return m_data[m_size - 1];
+    }
+
+    /**
+     * @brief   Checks the stack empty or not.
+     *
+     * @return  true if the stack is empty, otherwise false.
+     */
+    [[nodiscard]]
+    constexpr bool empty() const noexcept
+    {
+        return 0 == m_size;
+    }
+
+    /**
+     * @brief   Gets the number of elements.
+     *
+     * @return  The number of elements.
+     */
+    [[nodiscard]]
+    constexpr size_type size() const noexcept
+    {
+        return m_size;
+    }
+
+    /**
+     * @brief   Gets the maximum number of elements.
+     *
+     * @return  The capacity.
+     */
+    [[nodiscard]]
+    static constexpr size_type capacity() noexcept
+    {
+        return Capacity;
+    }
+
+private:
+
+    /**
+     * @brief   The storage of elements, left uninitialized to keep construction free.
+     */
+    space::collections::Array<T, Capacity> m_data;
+
+    /**
+     * @brief   The number of elements.
+     */
+    size_type m_size {0};
+}; // class InlineStack
+
+} // namespace space::collections
@@ -0,0 +1,426 @@
+/**
+ * @file        LinearQuadTree.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaring the LinearQuadTree class.
+ * @date        14-10-2026
+ * @copyright   Copyright (c) 2026
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <numeric>
+#include <ranges>
+#include <utility>
+
+#include "Definitions.h"
+#include "QuadTree.h"
+
+namespace space
+{
+
+/**
+ * @brief   The read-only quadtree stored as the sorted array of values by z-order codes.
+ *
+ * @details Every value is keyed by the z-order code of its node in the quadtree with the same
+ *          policy, i.e. the Morton code of the node cell and its level. The codes and the values
+ *          are two contiguous arrays sorted by (code, value), so the subtree of any node is one
+ *          range of the arrays. The query descends the implicit tree, every child range is found
+ *          by the binary search in the range of its parent, the subtrees covered by the query are
+ *          scanned linearly without tests. The arrays have no pointers, so they can be written
+ *          and mapped as they are.
+ *
+ * @tparam  TKey The type of values, must be ordered and have the IndexableTraits specialization.
+ * @tparam  TPolicy The policy of quadtree, see DefaultQuadTreePolicy.
+ */
+template <typename TKey, typename TPolicy = DefaultQuadTreePolicy>
+class LinearQuadTree
+{
+    using TLayout = QuadTree<TKey, TPolicy>;
+    using TRegion = typename TLayout::TRegion;
+    using TCodedKey = typename TLayout::TCodedKey;
+
+public:
+    using TBox = typename TLayout::TBox;
+    using TCoordinate = typename TLayout::TCoordinate;
+    using ZOrderCode = typename TLayout::ZOrderCode;
+    using size_type = std::size_t;
+
+    LinearQuadTree() = default;
+
+    /**
+     * @brief   Builds the tree for the given keys, the duplicates are stored once.
+     *
+     * @details The root region is the smallest region with power of two size for the extent of keys,
+     *          the complexity is O(n * (depth + log(n))).
+     *
+     * @tparam  TRange The type of the range of keys.
+     * @param   keys The keys.
+     */
+    template <std::ranges::input_range TRange>
+        requires std::convertible_to<std::ranges::range_reference_t<TRange>, const TKey&>
+    explicit LinearQuadTree(TRange&& keys)
+    {
+        space::collections::Vector<TCodedKey> codedKeys;
+        for (const TKey& key : keys)
+        {
+            codedKeys.push_back({{}, key});
+        }
+        if (codedKeys.empty())
+        {
+            return;
+        }
+        build(TLayout::makeRegionFor(TLayout::boundaryBoxOf(codedKeys)), codedKeys);
+    }
+
+    /**
+     * @brief   Builds the tree for the values of the given quadtree with the same root region.
+     *
+     * @param   tree The quadtree.
+     */
+    explicit LinearQuadTree(const TLayout& tree)
+    {
+        if (TLayout::s_nullIndex == tree.m_root)
+        {
+            return;
+        }
+        space::collections::Vector<TCodedKey> codedKeys;
+        codedKeys.reserve(tree.size());
+        typename TLayout::TTraversalStack nodeStack;
+        nodeStack.push(tree.m_root);
+        while (!nodeStack.empty())
+        {
+            const auto& node = tree.m_nodes[nodeStack.top()];
+            nodeStack.pop();
+            for (const auto child : node.getChildren())
+            {
+                if (TLayout::s_nullIndex != child)
+                {
+                    nodeStack.push(child);
+                }
+            }
+            for (const auto& value : node.getValues())
+            {
+                codedKeys.push_back({{}, value});
+            }
+        }
+        build(tree.m_nodes[tree.m_root].region(), codedKeys);
+    }
+
+    /**
+     * @brief   Finds values intersecting the given rectangle.
+     *
+     * @tparam  TOutIt The type of output iterator.
+     * @param   key The rectangle for query.
+     * @param   outIt The output iterator.
+     */
+    template <typename TOutIt>
+    void query(const TBox& key, TOutIt outIt) const
+    {
+        visitIntersecting(key, [&outIt](const TKey& value)
+        {
+            *outIt++ = value;
+            return true;
+        });
+    }
+
+    /**
+     * @brief   Checks if any value intersects the given rectangle.
+     *
+     * @param   key The rectangle for query.
+     * @return  true if there is an intersecting value, otherwise false.
+     */
+    [[nodiscard]]
+    bool queryAny(const TBox& key) const
+    {
+        return !visitIntersecting(key, [](const TKey&)
+        {
+            return false;
+        });
+    }
+
+    /**
+     * @brief   Counts values intersecting the given rectangle.
+     *
+     * @param   key The rectangle for query.
+     * @return  The number of intersecting values.
+     */
+    [[nodiscard]]
+    size_type queryCount(const TBox& key) const
+    {
+        size_type count = 0;
+        visitIntersecting(key, [&count](const TKey&)
+        {
+            ++count;
+            return true;
+        });
+        return count;
+    }
+
+    /**
+     * @brief   Determines whether the tree contains the specified key.
+     *
+     * @details The range of the key code is found by the binary search, then the key is
+     *          searched in the range.
+     *
+     * @param   key The key to locate.
+     * @return  true if the tree contains the key, otherwise false.
+     */
+    [[nodiscard]]
+    bool contains(const TKey& key) const
+    {
+        const auto& box = TLayout::indexableOf(key);
+        if (empty() || !TLayout::isInside(box, m_region))
+        {
+            return false;
+        }
+        const auto[first, last] = std::ranges::equal_range(m_codes, TLayout::zOrderCodeOf(box, m_region));
+        const auto firstKey = m_keys.begin() + (first - m_codes.begin());
+        const auto lastKey = m_keys.begin() + (last - m_codes.begin());
+        return std::binary_search(firstKey, lastKey, key);
+    }
+
+    /**
+     * @brief   Get the number of values stored in the tree.
+     *
+     * @return  The number of values.
+     */
+    [[nodiscard]]
+    size_type size() const noexcept
+    {
+        return std::size(m_keys);
+    }
+
+    /**
+     * @brief  Checks the container empty or not.
+     *
+     * @return true if the container is empty, otherwise false.
+     */
+    [[nodiscard]]
+    bool empty() const noexcept
+    {
+        return m_keys.empty();
+    }
+
+    /**
+     * @brief   Gets the sorted z-order codes, the i-th code is the code of the i-th value.
+     *
+     * @return  The span of codes.
+     */
+    [[nodiscard]]
+    space::collections::Span<const ZOrderCode> codes() const noexcept
+    {
+        return m_codes;
+    }
+
+    /**
+     * @brief   Gets the values sorted by their codes.
+     *
+     * @return  The span of values.
+     */
+    [[nodiscard]]
+    space::collections::Span<const TKey> values() const noexcept
+    {
+        return m_keys;
+    }
+
+private:
+    /**
+     * @internal
+     * @brief   Computes the codes of keys for the given root region and fills the arrays.
+     *
+     * @param   region The root region, contains all keys.
+     * @param   codedKeys The keys, the codes are computed.
+     */
+    void build(const TRegion& region, space::collections::Vector<TCodedKey>& codedKeys)
+    {
+        m_region = region;
+        for (auto& [code, key] : codedKeys)
+        {
+            code = TLayout::zOrderCodeOf(TLayout::indexableOf(key), m_region);
+        }
+        std::ranges::sort(codedKeys);
+        const auto uniqueEnd = std::unique(codedKeys.begin(), codedKeys.end());
+        codedKeys.erase(uniqueEnd, codedKeys.end());
+        m_codes.reserve(std::size(codedKeys));
+        m_keys.reserve(std::size(codedKeys));
+        for (const auto& [code, key] : codedKeys)
+        {
+            m_codes.push_back(code);
+            m_keys.push_back(key);
+        }
+
+        // About one cell for four values, the codes are sorted, so the cells are counted in one pass.
+        m_directoryDepth = static_cast<std::uint32_t>(std::min<std::size_t>(TLayout::s_maxDepth
+            , std::max<std::size_t>(2, std::bit_width(std::size(m_keys)) / 2) - 1));
+        m_directory.assign((size_type {1} << (2 * m_directoryDepth)) + 1, 0);
+        for (const auto& code : m_codes)
+        {
+            ++m_directory[static_cast<size_type>(code.path[0] >> (64 - 2 * m_directoryDepth)) + 1];
+        }
+        std::partial_sum(m_directory.begin(), m_directory.end(), m_directory.begin());
+    }
+
+    /**
+     * @internal
+     * @brief   Visits values intersecting the given rectangle.
+     *
+     * @tparam  TVisitor The type of visitor, returns false to stop the traversal.
+     * @param   key The rectangle.
+     * @param   visitor The visitor.
+     * @return  false if the visitor stopped the traversal, otherwise true.
+     */
+    template <typename TVisitor>
+    bool visitIntersecting(const TBox& key, TVisitor&& visitor) const
+    {
+        if (empty())
+        {
+            return true;
+        }
+        return visitSubtree(key, ZOrderCode {}, m_region, 0, size(), visitor);
+    }
+
+    /**
+     * @internal
+     * @brief   Visits values of the node subtree intersecting the given rectangle.
+     *
+     * @details The node values are the first values of the subtree range (their depth is
+     *          the node depth), then the ranges of children follow in the z-order. The ranges
+     *          are searched only for the children intersecting the rectangle.
+     *
+     * @tparam  TVisitor The type of visitor, returns false to stop the traversal.
+     * @param   key The rectangle.
+     * @param   code The node code.
+     * @param   region The node region.
+     * @param   first The first value of the subtree.
+     * @param   last The end of values of the subtree, not equal to first.
+     * @param   visitor The visitor.
+     * @return  false if the visitor stopped the traversal, otherwise true.
+     */
+    template <typename TVisitor>
+    bool visitSubtree(const TBox& key, const ZOrderCode& code, const TRegion& region
+                      , size_type first, size_type last, TVisitor& visitor) const
+    {
+        const auto bounds = TLayout::boundsOf(region);
+        if (!space::util::hasIntersect(key, bounds))
+        {
+            return true;
+        }
+        if (space::util::contains(key, bounds))
+        {
+            for (auto i = first; i < last; ++i)
+            {
+                if (!visitor(m_keys[i]))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        const auto depth = code.depth;
+        for (; first < last && depth == m_codes[first].depth; ++first)
+        {
+            if (space::util::hasIntersect(key, TLayout::indexableOf(m_keys[first])) && !visitor(m_keys[first]))
+            {
+                return false;
+            }
+        }
+        for (std::size_t pos = 0; pos < 4 && first < last; ++pos)
+        {
+            const auto zOrderPos = static_cast<typename TLayout::ZOrderPos>(pos);
+            const auto childRegion = TLayout::makeChildRegion(region, zOrderPos);
+            if (!space::util::hasIntersect(key, TLayout::boundsOf(childRegion)))
+            {
+                continue;
+            }
+            const auto childCode = childCodeOf(code, pos);
+            const auto[childFirst, childLast] = childRangeOf(code, pos, first, last);
+            first = childLast;
+            if (childFirst != childLast && !visitSubtree(key, childCode, childRegion, childFirst, childLast, visitor))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @internal
+     * @brief   Returns the range of values of the child subtree.
+     *
+     * @details The range is taken from the directory for the levels it covers, otherwise
+     *          it is searched in the range of the parent subtree.
+     *
+     * @param   code The parent code.
+     * @param   pos The z-order position of child.
+     * @param   first The first value of the parent children.
+     * @param   last The end of values of the parent subtree.
+     * @return  The first value and the end of values of the child subtree.
+     */
+    std::pair<size_type, size_type> childRangeOf(const ZOrderCode& code, std::size_t pos
+                                                 , size_type first, size_type last) const
+    {
+        const auto childCode = childCodeOf(code, pos);
+        if (childCode.depth <= m_directoryDepth)
+        {
+            // The values of ancestors with the same path are before first.
+            const auto cell = static_cast<size_type>(childCode.path[0] >> (64 - 2 * m_directoryDepth));
+            const auto cellCount = size_type {1} << (2 * (m_directoryDepth - childCode.depth));
+            return {std::max(first, size_type {m_directory[cell]}), std::min(last, size_type {m_directory[cell + cellCount]})};
+        }
+        const auto codesBegin = m_codes.begin();
+        const auto childFirst = std::lower_bound(codesBegin + static_cast<std::ptrdiff_t>(first)
+                                                 , codesBegin + static_cast<std::ptrdiff_t>(last), childCode);
+        const auto childLast = (3 == pos) ? codesBegin + static_cast<std::ptrdiff_t>(last)
+            : std::lower_bound(childFirst, codesBegin + static_cast<std::ptrdiff_t>(last), childCodeOf(code, pos + 1));
+        return {static_cast<size_type>(childFirst - codesBegin), static_cast<size_type>(childLast - codesBegin)};
+    }
+
+    /**
+     * @internal
+     * @brief   Returns the code of the node child, the codes of the child subtree are not less
+     *          than it and less than the code of the next child.
+     *
+     * @param   code The node code.
+     * @param   pos The z-order position of child.
+     * @return  The child code.
+     */
+    static ZOrderCode childCodeOf(ZOrderCode code, std::size_t pos) noexcept
+    {
+        const auto depth = code.depth;
+        code.path[depth / 32] |= static_cast<std::uint64_t>(pos) << (62 - 2 * (depth % 32));
+        ++code.depth;
+        return code;
+    }
+
+private:
+    /**
+     * @brief   The region of the root.
+     */
+    TRegion m_region {};
+
+    /**
+     * @brief   The first value of every node at the directory depth, and the number of values.
+     */
+    space::collections::Vector<std::uint32_t> m_directory {};
+
+    /**
+     * @brief   The depth of nodes in the directory, at least one.
+     */
+    std::uint32_t m_directoryDepth {0};
+
+    /**
+     * @brief   The sorted z-order codes of values.
+     */
+    space::collections::Vector<ZOrderCode> m_codes {};
+
+    /**
+     * @brief   The values in the order of codes.
+     */
+    space::collections::Vector<TKey> m_keys {};
+}; // class LinearQuadTree
+
+} // namespace space
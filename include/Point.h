@@ -39,7 +39,7 @@ public:
 
     constexpr Point& operator=(const Point&) noexcept = default;
 
-    constexpr std::strong_ordering operator<=>(const Point<TCrt>&) const noexcept = default;
+    constexpr auto operator<=>(const Point<TCrt>&) const noexcept = default;
 
     /**
      * @brief   Initializes a new instance of the Point struct with the specified coordinates.
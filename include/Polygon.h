@@ -10,6 +10,7 @@
 #pragma once
 
 #include <algorithm>
+#include <cstdint>
 
 #include "Definitions.h"
 #include "Point.h"
@@ -230,6 +231,51 @@ constexpr bool contains(const Polygon<TCrt>& poly, const Point<TCrt>& point) noe
         });
 }
 
+/**
+ * @brief   Checks every given point is inside or on the edge of the Polygon and outside of holes.
+ *
+ * @details The batch version of space::util::contains with the same results. The points are
+ *          tested against the boundary by blocks, the holes are tested only for the points
+ *          inside the boundary.
+ * @throws  std::out_of_range if the polygon is empty or the output is smaller than the points.
+ * @tparam  TCrt The type of coordinates.
+ * @param   poly The given Polygon.
+ * @param   points The given points.
+ * @param   out The results, out[i] is 1 if the polygon contains points[i], otherwise 0.
+ */
+template <typename TCrt>
+void containsBatch(const Polygon<TCrt>& poly
+                   , space::collections::Span<const Point<TCrt>> points
+                   , space::collections::Span<std::uint8_t> out)
+{
+    containsBatch(poly.boundary(), points, out);
+    if (!poly.hasHoles())
+    {
+        return;
+    }
+
+    space::collections::Vector<Point<TCrt>> insidePoints;
+    space::collections::Vector<std::size_t> insideIndexes;
+    for (std::size_t i = 0; i < std::size(points); ++i)
+    {
+        if (0 != out[i])
+        {
+            insidePoints.push_back(points[i]);
+            insideIndexes.push_back(i);
+        }
+    }
+
+    space::collections::Vector<std::uint8_t> inHole(std::size(insidePoints));
+    for (const auto& hole : poly.holes())
+    {
+        containsBatch<TCrt>(hole, insidePoints, inHole);
+        for (std::size_t i = 0; i < std::size(insidePoints); ++i)
+        {
+            out[insideIndexes[i]] &= static_cast<std::uint8_t>(1 - inHole[i]);
+        }
+    }
+}
+
 } // namespace util
 
 /**
@@ -0,0 +1,277 @@
+/**
+ * @file        PolygonLayer.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaring the PolygonLayer class.
+ * @date        14-10-2026
+ * @copyright   Copyright (c) 2026
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <execution>
+#include <iterator>
+#include <numeric>
+#include <utility>
+
+#include "Definitions.h"
+#include "Indexable.h"
+#include "Point.h"
+#include "PreparedPolygon.h"
+#include "Rect.h"
+#include "SimplePolygon.h"
+#include "QuadTree.h"
+
+namespace space
+{
+
+/**
+ * @brief   The layer of simple polygons with the two-phase spatial queries.
+ *
+ * @details The polygons are indexed by their boundary boxes in the quadtree. A query first
+ *          filters the candidates by boxes through the index, then refines the candidates
+ *          by the exact predicate. The polygons are stored as PreparedSimplePolygon, so their
+ *          boxes, convexity and edge bands are computed once when the polygon is added, the query
+ *          polygon is prepared once per query and reused for all candidates.
+ *
+ * @tparam  TCrt The type of coordinates.
+ */
+template <typename TCrt>
+class PolygonLayer
+{
+public:
+    using TPolygon = space::SimplePolygon<TCrt>;
+    using TPoint = space::Point<TCrt>;
+    using TBox = space::Rect<TCrt>;
+    using TId = std::uint32_t;
+    using size_type = std::size_t;
+
+    /**
+     * @brief   The counters of two-phase query.
+     *
+     * @details filtered The number of candidates found by boxes, every candidate is checked
+     *                   by the exact predicate.
+     *          matched The number of candidates passed the exact tests.
+     */
+    struct QueryStats
+    {
+        size_type filtered {0};
+        size_type matched {0};
+
+        QueryStats& operator+=(const QueryStats& other) noexcept
+        {
+            filtered += other.filtered;
+            matched += other.matched;
+            return *this;
+        }
+    };
+
+    /**
+     * @brief   The results of batch query in the compressed sparse row format.
+     *
+     * @details The ids found for the i-th query are stored in [ids[offsets[i]], ids[offsets[i + 1]]).
+     */
+    struct BatchQueryResult
+    {
+        space::collections::Vector<size_type> offsets {};
+        space::collections::Vector<TId> ids {};
+        QueryStats stats {};
+
+        /**
+         * @brief   Gets the ids found for the given query.
+         *
+         * @param   index The index of the query.
+         * @return  The span of found ids.
+         */
+        [[nodiscard]]
+        space::collections::Span<const TId> operator[](size_type index) const noexcept
+        {
+            return space::collections::Span<const TId> {ids}.subspan(offsets[index]
+                , offsets[index + 1] - offsets[index]);
+        }
+    };
+
+private:
+    using TPreparedPolygon = space::PreparedSimplePolygon<TCrt>;
+    using TIndexValue = std::pair<TBox, TId>;
+
+public:
+
+    /**
+     * @brief   Adds the polygon to the layer.
+     *
+     * @throws  std::out_of_range if the polygon is empty.
+     *
+     * @param   polygon The polygon.
+     * @return  The id of the polygon, the ids are assigned sequentially.
+     */
+    TId add(TPolygon polygon)
+    {
+        const auto id = static_cast<TId>(std::size(m_entries));
+        const auto& prepared = m_entries.emplace_back(std::move(polygon));
+        m_index.insert({prepared.boundaryBox(), id});
+        return id;
+    }
+
+    /**
+     * @brief   Gets the polygon by id.
+     *
+     * @param   id The id of polygon.
+     * @return  The const reference to polygon.
+     */
+    [[nodiscard]]
+    const TPolygon& polygon(TId id) const noexcept
+    {
+        return m_entries[id].polygon();
+    }
+
+    /**
+     * @brief   Gets the number of polygons in the layer.
+     *
+     * @return  The number of polygons.
+     */
+    [[nodiscard]]
+    size_type size() const noexcept
+    {
+        return std::size(m_entries);
+    }
+
+    /**
+     * @brief   Finds polygons intersecting the given polygon.
+     *
+     * @details The exact test is space::util::hasIntersect for PreparedSimplePolygon, the convex
+     *          pairs are checked in linear time.
+     *
+     * @tparam  TOutIt The type of output iterator.
+     * @param   query The polygon for query.
+     * @param   outIt The output iterator for ids.
+     * @return  The counters of query.
+     */
+    template <typename TOutIt>
+    QueryStats queryIntersecting(const TPolygon& query, TOutIt outIt) const
+    {
+        QueryStats stats;
+        const TPreparedPolygon prepared {query};
+        for (const auto& [box, id] : m_index.queryRange(prepared.boundaryBox()))
+        {
+            ++stats.filtered;
+            if (space::util::hasIntersect(prepared, m_entries[id]))
+            {
+                ++stats.matched;
+                *outIt++ = id;
+            }
+        }
+        return stats;
+    }
+
+    /**
+     * @brief   Finds polygons containing the given point.
+     *
+     * @tparam  TOutIt The type of output iterator.
+     * @param   point The point.
+     * @param   outIt The output iterator for ids.
+     * @return  The counters of query.
+     */
+    template <typename TOutIt>
+    QueryStats queryContaining(const TPoint& point, TOutIt outIt) const
+    {
+        QueryStats stats;
+        for (const auto& [box, id] : m_index.queryRange(TBox {point, point}))
+        {
+            ++stats.filtered;
+            if (space::util::contains(m_entries[id], point))
+            {
+                ++stats.matched;
+                *outIt++ = id;
+            }
+        }
+        return stats;
+    }
+
+    /**
+     * @brief   Finds polygons intersecting every polygon of the given batch.
+     *
+     * @details The candidates of all queries are found by one batch query of the index,
+     *          the candidates are refined in parallel with the given execution policy.
+     *
+     * @tparam  TExecutionPolicy The type of execution policy.
+     * @param   policy The execution policy.
+     * @param   queries The polygons for query.
+     * @return  The found ids for every query and the total counters.
+     */
+    template <typename TExecutionPolicy>
+        requires std::is_execution_policy_v<std::remove_cvref_t<TExecutionPolicy>>
+    BatchQueryResult queryIntersectingBatch(TExecutionPolicy&& policy, space::collections::Span<const TPolygon> queries) const
+    {
+        const auto queryCount = std::size(queries);
+        space::collections::Vector<TBox> boxes(queryCount);
+        std::transform(policy, queries.begin(), queries.end(), boxes.begin(), [](const TPolygon& query)
+        {
+            return space::util::boundaryBoxOf(query);
+        });
+        const auto candidates = m_index.queryBatch(policy, boxes);
+
+        space::collections::Vector<size_type> queryIndexes(queryCount);
+        std::iota(queryIndexes.begin(), queryIndexes.end(), size_type {0});
+        space::collections::Vector<std::uint8_t> isMatched(std::size(candidates.values), 0);
+
+        BatchQueryResult result;
+        result.offsets.assign(queryCount + 1, 0);
+        std::for_each(policy, queryIndexes.begin(), queryIndexes.end(), [&](const size_type query)
+        {
+            const TPreparedPolygon prepared {queries[query]};
+            for (auto i = candidates.offsets[query]; i < candidates.offsets[query + 1]; ++i)
+            {
+                if (space::util::hasIntersect(prepared, m_entries[candidates.values[i].second]))
+                {
+                    isMatched[i] = 1;
+                    ++result.offsets[query + 1];
+                }
+            }
+        });
+        std::inclusive_scan(policy, result.offsets.begin(), result.offsets.end(), result.offsets.begin());
+
+        result.ids.resize(result.offsets.back());
+        std::for_each(policy, queryIndexes.begin(), queryIndexes.end(), [&](const size_type query)
+        {
+            auto cursor = result.offsets[query];
+            for (auto i = candidates.offsets[query]; i < candidates.offsets[query + 1]; ++i)
+            {
+                if (0 != isMatched[i])
+                {
+                    result.ids[cursor++] = candidates.values[i].second;
+                }
+            }
+        });
+
+        result.stats.filtered = std::size(candidates.values);
+        result.stats.matched = std::size(result.ids);
+        return result;
+    }
+
+    /**
+     * @brief   Finds polygons intersecting every polygon of the given batch in parallel.
+     *
+     * @param   queries The polygons for query.
+     * @return  The found ids for every query and the total counters.
+     */
+    BatchQueryResult queryIntersectingBatch(space::collections::Span<const TPolygon> queries) const
+    {
+        return queryIntersectingBatch(std::execution::par, queries);
+    }
+
+private:
+
+    /**
+     * @brief   The polygons with the cached data, the id is the index.
+     */
+    space::collections::Vector<TPreparedPolygon> m_entries {};
+
+    /**
+     * @brief   The index of polygon boxes.
+     */
+    space::QuadTree<TIndexValue> m_index {};
+}; // class PolygonLayer
+
+} // namespace space
@@ -0,0 +1,365 @@
+/**
+ * @file        PreparedPolygon.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaring the PreparedSimplePolygon and PreparedPolygon classes.
+ * @date        14-10-2026
+ * @copyright   Copyright (c) 2026
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <optional>
+#include <utility>
+
+#include "Definitions.h"
+#include "EdgeBands.h"
+#include "Point.h"
+#include "Rect.h"
+#include "SimplePolygon.h"
+#include "Polygon.h"
+#include "Utility.h"
+
+namespace space
+{
+
+/**
+ * @class   PreparedSimplePolygon
+ * @brief   The immutable simple polygon with the precomputed data for repeated predicates.
+ *
+ * @details The boundary box and the convexity are computed once in the constructor, the
+ *          predicates on prepared polygons do only the work depending on the other argument.
+ *          The polygons with many vertices also get the EdgeBands for the sub-linear point tests.
+ *          The preparation is linear in the number of vertices (plus the edge and band pairs
+ *          of EdgeBands).
+ *
+ * @tparam  TCrt The type of coordinate.
+ */
+template <typename TCrt>
+class PreparedSimplePolygon
+{
+public:
+    /**
+     * @brief   The type of coordinate.
+     */
+    using TCoordinate = TCrt;
+
+    /**
+     * @brief   The type of underlying simple polygon.
+     */
+    using TSimplePolygon = space::SimplePolygon<TCoordinate>;
+
+    /**
+     * @brief   The minimal number of vertices for building the edge bands.
+     */
+    static constexpr std::size_t s_edgeBandsMinVertexCount = 64;
+
+public:
+    PreparedSimplePolygon() = delete;
+
+    ~PreparedSimplePolygon() = default;
+
+    PreparedSimplePolygon(PreparedSimplePolygon&&) noexcept = default;
+
+    PreparedSimplePolygon(const PreparedSimplePolygon&) = default;
+
+    PreparedSimplePolygon& operator=(PreparedSimplePolygon&&) noexcept = default;
+
+    PreparedSimplePolygon& operator=(const PreparedSimplePolygon&) = default;
+
+    /**
+     * @brief   Initializes a new instance of the PreparedSimplePolygon from the given simple polygon.
+     *
+     * @throws  std::out_of_range if the polygon is empty.
+     *
+     * @param   polygon The simple polygon.
+     */
+    explicit PreparedSimplePolygon(TSimplePolygon polygon)
+        : m_polygon {std::move(polygon)}
+        , m_boundaryBox {space::util::boundaryBoxOf(m_polygon)}
+    {
+        const auto& curve = m_polygon.boundaryCurve();
+        m_convexWalk = space::util::impl::convexWalkOf<TCoordinate>(curve);
+        if (std::size(curve) >= s_edgeBandsMinVertexCount)
+        {
+            m_edgeBands.emplace(m_polygon);
+        }
+    }
+
+    /**
+     * @brief   Gets the const reference to the underlying simple polygon.
+     *
+     * @return  The const reference to the simple polygon.
+     */
+    [[nodiscard]]
+    const TSimplePolygon& polygon() const noexcept
+    {
+        return m_polygon;
+    }
+
+    /**
+     * @brief   Gets the boundary box of the polygon.
+     *
+     * @return  The const reference to the boundary box.
+     */
+    [[nodiscard]]
+    const space::Rect<TCoordinate>& boundaryBox() const noexcept
+    {
+        return m_boundaryBox;
+    }
+
+    /**
+     * @brief   Checks the polygon is convex or not.
+     *
+     * @return  true if the polygon is convex, otherwise false.
+     */
+    [[nodiscard]]
+    bool isConvex() const noexcept
+    {
+        return m_convexWalk.has_value();
+    }
+
+    /**
+     * @brief   Gets the counterclockwise walk over the polygon if it is convex.
+     *
+     * @return  The const reference to the optional walk.
+     */
+    [[nodiscard]]
+    const std::optional<space::util::impl::ConvexWalk>& convexWalk() const noexcept
+    {
+        return m_convexWalk;
+    }
+
+    /**
+     * @brief   Gets the edge bands, they are built only for polygons with at least
+     *          s_edgeBandsMinVertexCount vertices.
+     *
+     * @return  The const reference to the optional edge bands.
+     */
+    [[nodiscard]]
+    const std::optional<space::EdgeBands<TCoordinate>>& edgeBands() const noexcept
+    {
+        return m_edgeBands;
+    }
+
+private:
+
+    /**
+     * @brief   The underlying simple polygon.
+     */
+    TSimplePolygon m_polygon;
+
+    /**
+     * @brief   The boundary box of the polygon.
+     */
+    space::Rect<TCoordinate> m_boundaryBox;
+
+    /**
+     * @brief   The counterclockwise walk if the polygon is convex.
+     */
+    std::optional<space::util::impl::ConvexWalk> m_convexWalk {};
+
+    /**
+     * @brief   The edge bands for point tests on large polygons.
+     */
+    std::optional<space::EdgeBands<TCoordinate>> m_edgeBands {};
+}; // class PreparedSimplePolygon
+
+
+/**
+ * @class   PreparedPolygon
+ * @brief   The immutable polygon with holes with the precomputed data for repeated predicates.
+ *
+ * @details The external boundary and every hole are prepared as PreparedSimplePolygon.
+ *
+ * @tparam  TCrt The type of coordinate.
+ */
+template <typename TCrt>
+class PreparedPolygon
+{
+public:
+    /**
+     * @brief   The type of coordinate.
+     */
+    using TCoordinate = TCrt;
+
+    /**
+     * @brief   The type of prepared contours.
+     */
+    using TPreparedSimplePolygon = space::PreparedSimplePolygon<TCoordinate>;
+
+public:
+    PreparedPolygon() = delete;
+
+    ~PreparedPolygon() = default;
+
+    PreparedPolygon(PreparedPolygon&&) noexcept = default;
+
+    PreparedPolygon(const PreparedPolygon&) = default;
+
+    PreparedPolygon& operator=(PreparedPolygon&&) noexcept = default;
+
+    PreparedPolygon& operator=(const PreparedPolygon&) = default;
+
+    /**
+     * @brief   Initializes a new instance of the PreparedPolygon from the given polygon.
+     *
+     * @throws  std::out_of_range if the polygon or any of its holes is empty.
+     *
+     * @param   polygon The polygon with holes.
+     */
+    explicit PreparedPolygon(const space::Polygon<TCoordinate>& polygon)
+        : m_boundary {polygon.boundary()}
+    {
+        const auto holes = polygon.holes();
+        m_holes.reserve(std::size(holes));
+        for (const auto& hole : holes)
+        {
+            m_holes.emplace_back(hole);
+        }
+    }
+
+    /**
+     * @brief   Gets the prepared external boundary.
+     *
+     * @return  The const reference to the prepared external boundary.
+     */
+    [[nodiscard]]
+    const TPreparedSimplePolygon& boundary() const noexcept
+    {
+        return m_boundary;
+    }
+
+    /**
+     * @brief   Gets the prepared interior boundaries (holes).
+     *
+     * @return  The span on the prepared holes.
+     */
+    [[nodiscard]]
+    space::collections::Span<const TPreparedSimplePolygon> holes() const noexcept
+    {
+        return m_holes;
+    }
+
+private:
+
+    /**
+     * @brief   The prepared external boundary.
+     */
+    TPreparedSimplePolygon m_boundary;
+
+    /**
+     * @brief   The prepared holes.
+     */
+    space::collections::Vector<TPreparedSimplePolygon> m_holes {};
+}; // class PreparedPolygon
+
+
+namespace util
+{
+
+/**
+ * @brief       Gets the boundary box of the given prepared simple polygon.
+ *
+ * @details     The algorithm complexity is O(1).
+ *
+ * @tparam TCrt The type of coordinates.
+ * @param poly  The given prepared polygon.
+ * @return      The boundary box (space::Rect) of the given polygon.
+ */
+template <typename TCrt>
+constexpr space::Rect<TCrt> boundaryBoxOf(const PreparedSimplePolygon<TCrt>& poly) noexcept
+{
+    return poly.boundaryBox();
+}
+
+/**
+ * @brief       Gets the boundary box of the given prepared polygon.
+ *
+ * @details     The algorithm complexity is O(1).
+ *
+ * @tparam TCrt The type of coordinates.
+ * @param poly  The given prepared polygon.
+ * @return      The boundary box (space::Rect) of the given polygon.
+ */
+template <typename TCrt>
+constexpr space::Rect<TCrt> boundaryBoxOf(const PreparedPolygon<TCrt>& poly) noexcept
+{
+    return poly.boundary().boundaryBox();
+}
+
+/**
+ * @brief   Returns true if the given point is inside or on the edge of the prepared simple polygon,
+ *          otherwise returns false.
+ *
+ * @details The points outside of the boundary box are rejected without visiting the edges,
+ *          the others are checked by the even-odd rule as space::util::contains for SimplePolygon.
+ *          The large polygons are checked through the edge bands, visiting only the edges
+ *          of the band containing the point.
+ * @tparam  TCrt The type of coordinates.
+ * @param   poly The given prepared simple polygon.
+ * @param   point The given point.
+ * @return  true if contains, otherwise returns false.
+ */
+template <typename TCrt>
+[[nodiscard]]
+constexpr bool contains(const PreparedSimplePolygon<TCrt>& poly, const Point<TCrt>& point) noexcept
+{
+    if (poly.edgeBands())
+    {
+        return poly.edgeBands()->contains(point);
+    }
+    const auto& box = poly.boundaryBox();
+    if (!hasIntersect(box, space::Rect<TCrt> {point, point}))
+    {
+        return false;
+    }
+    return impl::curveContains(poly.polygon().boundaryCurve(), point);
+}
+
+/**
+ * @brief   Returns true if the given point is inside or on the edge of the prepared polygon,
+ *          otherwise returns false.
+ *
+ * @tparam  TCrt The type of coordinates.
+ * @param   poly The given prepared polygon.
+ * @param   point The given point.
+ * @return  true if contains, otherwise returns false.
+ */
+template <typename TCrt>
+[[nodiscard]]
+constexpr bool contains(const PreparedPolygon<TCrt>& poly, const Point<TCrt>& point) noexcept
+{
+    if (!contains(poly.boundary(), point))
+    {
+        return false;
+    }
+
+    return std::ranges::none_of(poly.holes()
+        , [point](const auto& hole)
+        {
+           return contains(hole, point);
+        });
+}
+
+/**
+ * @brief   Checks the prepared simple polygons have an intersection or not.
+ *
+ * @details The same predicate as space::util::hasIntersect for SimplePolygon, the boundary boxes
+ *          and the convexity are taken from the cache. Two convex polygons are checked in O(n + m).
+ * @tparam  TCrt The type of coordinates.
+ * @param   first The first prepared polygon.
+ * @param   second The second prepared polygon.
+ * @return  true if polygons have an intersection, otherwise false.
+ */
+template <typename TCrt>
+[[nodiscard]]
+bool hasIntersect(const PreparedSimplePolygon<TCrt>& first, const PreparedSimplePolygon<TCrt>& second)
+{
+    return impl::polygonsHaveIntersect(first.polygon(), first.boundaryBox(), first.convexWalk()
+                                       , second.polygon(), second.boundaryBox(), second.convexWalk());
+}
+
+} // namespace util
+
+} // namespace space
@@ -10,8 +10,28 @@
 
 #include <memory>
 #include <algorithm>
+#include <numeric>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <execution>
+#include <filesystem>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <queue>
+#include <ranges>
+#include <type_traits>
+#include <utility>
 
+#include "BoxColumns.h"
 #include "Definitions.h"
+#include "Indexable.h"
+#include "InlineStack.h"
+#include "QuadTreePolicy.h"
+#include "QuadTreeStats.h"
+#include "QuadTreeSnapshot.h"
+#include "SlabPool.h"
 
 #include "Point.h"
 #include "Square.h"
@@ -20,14 +40,109 @@
 namespace space
 {
 
+namespace impl
+{
+
+struct QuadTreeJoin;
+
+} // namespace impl
+
 /**
  * @brief   Implementation of quadtree.
  *
- * @tparam  TKey The type of values.
+ * @details The values are located by their boxes given by IndexableTraits, so the tree can
+ *          store the rectangles themselves or the compact (box, payload) pairs.
+ *
+ * @tparam  TKey The type of values, must be ordered and have the IndexableTraits specialization.
+ * @tparam  TPolicy The policy of quadtree, see DefaultQuadTreePolicy.
  */
-template <typename TKey>
+template <typename TKey, typename TPolicy = DefaultQuadTreePolicy>
 class QuadTree
 {
+    using TLooseness = typename TPolicy::Looseness;
+    using TIndexableTraits = space::IndexableTraits<TKey>;
+
+    /**
+     * @brief   The concurrent and linear trees use the same layout of regions.
+     */
+    template <typename TOtherKey, typename TOtherPolicy>
+    friend class ConcurrentQuadTree;
+
+    template <typename TOtherKey, typename TOtherPolicy>
+    friend class LinearQuadTree;
+
+    /**
+     * @brief   The mapped snapshot is bounded by the depth of the tree.
+     */
+    template <typename TOtherKey, typename TOtherPolicy>
+    friend class MappedQuadTree;
+
+    /**
+     * @brief   The spatial join traverses the nodes of two trees together.
+     */
+    friend struct impl::QuadTreeJoin;
+
+public:
+    /**
+     * @brief   The type of value box, the queries are done by boxes.
+     */
+    using TBox = typename TIndexableTraits::TBox;
+    using TCoordinate = typename TBox::TCoordinate;
+
+private:
+    static_assert(std::ratio_greater_equal_v<TLooseness, std::ratio<1>>, "The looseness must not be less than 1.");
+
+    /**
+     * @brief   true if the node bounds are enlarged.
+     */
+    static constexpr bool s_isLoose = std::ratio_greater_v<TLooseness, std::ratio<1>>;
+
+    /**
+     * @brief   The type of region coordinates.
+     *
+     * @details The regions of the integer trees are computed in the 64-bit integers, the root
+     *          grown toward the keys at both ends of the range is bigger than the range and
+     *          doesn't fit the narrower coordinates. The regions of the floating point trees
+     *          are computed at least in double, so the roots far from the origin keep the
+     *          precision of the float keys.
+     */
+    using TRegionCoordinate = std::conditional_t<std::is_integral_v<TCoordinate>
+                                                 , std::int64_t
+                                                 , std::common_type_t<TCoordinate, double>>;
+
+    /**
+     * @brief   true if the node values are mirrored to the box columns.
+     */
+    static constexpr bool s_hasColumns = TPolicy::ColumnarValues;
+
+    /**
+     * @brief   true if the tree counts the operations.
+     */
+    static constexpr bool s_collectStats = TPolicy::CollectStats;
+
+    /**
+     * @brief   The number of values of the leaf to split it, zero if the keys go down until
+     *          they cross the split lines.
+     */
+    static constexpr std::size_t s_leafCapacity = TPolicy::LeafCapacity;
+
+    /**
+     * @brief   true if the keys stay in the leaves until the leaf capacity is exceeded.
+     */
+    static constexpr bool s_isBucketed = 0 != s_leafCapacity;
+
+    static_assert(0 != TPolicy::MaxDepth, "The maximum depth must not be zero.");
+
+    using TCounters = std::conditional_t<s_collectStats
+                                         , impl::AtomicQuadTreeCounters
+                                         , impl::NoQuadTreeCounters>;
+
+    /**
+     * @brief   The placeholder of box columns for the trees without them.
+     */
+    struct NoColumns
+    {
+    };
 private:
 
     enum class ZOrderPos : size_t
@@ -42,11 +157,20 @@ private:
     {
     public:
         using TValue = TKey;
-        using TRegion = space::Square<typename TKey::TCoordinate>;
-        using TChildContainer = space::collections::Array<std::unique_ptr<Node>, 4>;
+        using TRegion = space::Square<TRegionCoordinate>;
+        using TNodeIndex = typename space::collections::SlabPool<Node>::index_type;
+        using TChildContainer = space::collections::Array<TNodeIndex, 4>;
         using TValueContainer = space::collections::FlatSet<TValue>;
+        using TColumns = std::conditional_t<s_hasColumns
+                                            , space::collections::BoxColumns<TCoordinate>
+                                            , NoColumns>;
+
+        /**
+         * @brief   The index of missing child.
+         */
+        static constexpr TNodeIndex s_nullIndex = space::collections::SlabPool<Node>::npos;
 
-        Node() = delete;
+        Node() = default;
 
         explicit Node(TRegion region)
             : m_region(region)
@@ -56,21 +180,135 @@ private:
         bool addValue(const TValue& box)
         {
             const auto[it, success] = m_values.insert(box);
+            if constexpr (s_hasColumns)
+            {
+                if (success)
+                {
+                    m_columns.insert(static_cast<std::size_t>(it - m_values.begin()), indexableOf(box));
+                }
+            }
             return success;
         }
 
         bool eraseValue(const TValue& box)
         {
-            return m_values.erase(box);
+            const auto it = m_values.find(box);
+            if (m_values.end() == it)
+            {
+                return false;
+            }
+            if constexpr (s_hasColumns)
+            {
+                m_columns.erase(static_cast<std::size_t>(it - m_values.begin()));
+            }
+            m_values.erase(it);
+            return true;
+        }
+
+        [[nodiscard]]
+        bool containsValue(const TValue& box) const
+        {
+            return m_values.end() != m_values.find(box);
+        }
+
+        /**
+         * @brief   Replaces the stored value by the new one, returns false if the new value
+         *          is already stored.
+         *
+         * @details The slot of the old value is moved to the position of the new one, so only
+         *          the values between the two positions are shifted.
+         */
+        bool replaceValue(const TValue& oldBox, const TValue& newBox)
+        {
+            const auto newIt = m_values.lower_bound(newBox);
+            if (m_values.end() != newIt && *newIt == newBox)
+            {
+                return false;
+            }
+            const auto oldIt = m_values.find(oldBox);
+            const auto oldIndex = static_cast<std::size_t>(oldIt - m_values.begin());
+            auto newIndex = static_cast<std::size_t>(newIt - m_values.begin());
+            if (oldIndex < newIndex)
+            {
+                std::rotate(oldIt, oldIt + 1, newIt);
+                --newIndex;
+            }
+            else
+            {
+                std::rotate(newIt, oldIt, oldIt + 1);
+            }
+            m_values.begin()[static_cast<std::ptrdiff_t>(newIndex)] = newBox;
+            if constexpr (s_hasColumns)
+            {
+                m_columns.erase(oldIndex);
+                m_columns.insert(newIndex, indexableOf(newBox));
+            }
+            return true;
+        }
+
+        /**
+         * @brief   Erases the sorted unique values in one pass, returns the number of erased values.
+         */
+        template <typename TIt>
+        std::size_t eraseValues(TIt first, TIt last)
+        {
+            auto sequence = m_values.extract_sequence();
+            auto output = sequence.begin();
+            for (auto& value : sequence)
+            {
+                while (first != last && *first < value)
+                {
+                    ++first;
+                }
+                if (first == last || !(*first == value))
+                {
+                    *output++ = std::move(value);
+                }
+            }
+            const auto erasedCount = static_cast<std::size_t>(sequence.end() - output);
+            sequence.erase(output, sequence.end());
+            m_values.adopt_sequence(boost::container::ordered_unique_range, std::move(sequence));
+            if constexpr (s_hasColumns)
+            {
+                m_columns.assign(m_values | std::views::transform(&TIndexableTraits::indexableOf));
+            }
+            return erasedCount;
+        }
+
+        /**
+         * @brief   Merges the sorted unique values, returns the number of inserted values.
+         */
+        template <typename TIt>
+        std::size_t mergeValues(TIt first, TIt last)
+        {
+            const auto oldSize = std::size(m_values);
+            m_values.insert(boost::container::ordered_unique_range, first, last);
+            if constexpr (s_hasColumns)
+            {
+                m_columns.assign(m_values | std::views::transform(&TIndexableTraits::indexableOf));
+            }
+            return std::size(m_values) - oldSize;
+        }
+
+        /**
+         * @brief   Releases the unused capacity of the values.
+         */
+        void shrinkToFit()
+        {
+            m_values.shrink_to_fit();
+            if constexpr (s_hasColumns)
+            {
+                m_columns.shrink_to_fit();
+            }
         }
 
-        void setChild(ZOrderPos pos, std::unique_ptr<Node>&& child)
+        void setChild(ZOrderPos pos, TNodeIndex child) noexcept
         {
-            m_child[static_cast<std::size_t>(pos)] = std::move(child);
+            m_child[static_cast<std::size_t>(pos)] = child;
         }
 
         [[nodiscard]]
-        std::unique_ptr<Node>& getChild(ZOrderPos pos) noexcept
+        TNodeIndex& getChild(ZOrderPos pos) noexcept
         {
             return m_child[static_cast<std::size_t>(pos)];
         }
@@ -94,9 +332,9 @@ private:
         }
 
         [[nodiscard]]
-        TValueContainer& getValues() noexcept
+        const TColumns& getColumns() const noexcept
         {
-            return m_values;
+            return m_columns;
         }
 
         [[nodiscard]]
@@ -111,285 +349,2131 @@ private:
             return m_region;
         }
 
+        [[nodiscard]]
+        bool isLeaf() const noexcept
+        {
+            return std::ranges::all_of(getChildren(), [](const auto child)
+            {
+                return s_nullIndex == child;
+            });
+        }
+
         [[nodiscard]]
         bool empty() const noexcept
         {
-            if (!getValues().empty())
+            return getValues().empty() && isLeaf();
+        }
+
+    private:
+        TRegion m_region {};
+        TChildContainer m_child {s_nullIndex, s_nullIndex, s_nullIndex, s_nullIndex};
+        TValueContainer m_values {};
+        [[no_unique_address]] TColumns m_columns {};
+    };
+
+
+    using TRegion = typename Node::TRegion;
+private:
+
+    using TNodePool = space::collections::SlabPool<Node>;
+    using TNodeIndex = typename Node::TNodeIndex;
+    static constexpr TNodeIndex s_nullIndex = Node::s_nullIndex;
+
+    /**
+     * @brief   The number of binary digits of the coordinate range, the region of the whole
+     *          range has size 2^s_rangeDigits.
+     *
+     * @details The floating point coordinates cover the range of the signed integer of the
+     *          same size, the trees of the bigger coordinates are not supported. The 64-bit
+     *          coordinates are limited to the digits of the region coordinates minus 3 (60
+     *          for the integers, 50 for double), so the root region up to eight times bigger
+     *          than the range has exact corners.
+     */
+    static constexpr std::size_t s_rangeDigits = std::min(std::is_integral_v<TCoordinate>
+        ? static_cast<std::size_t>(std::numeric_limits<TCoordinate>::digits)
+        : 8 * sizeof(TCoordinate) - 1, static_cast<std::size_t>(std::numeric_limits<TRegionCoordinate>::digits - 3));
+
+    /**
+     * @brief   The size of the smallest regions, the nodes of these regions are not split.
+     *
+     * @details The bigger of the policy MinRegionSize and the region size at the policy
+     *          MaxDepth, the depth is counted from the region of the whole range.
+     */
+    static constexpr TRegionCoordinate s_minRegionSize = []()
+    {
+        using TMinRegionSize = typename TPolicy::MinRegionSize;
+        static_assert(std::ratio_greater_v<TMinRegionSize, std::ratio<0>>, "The minimum region size must be positive.");
+        if constexpr (std::is_integral_v<TCoordinate>)
+        {
+            const auto depthSize = TPolicy::MaxDepth < s_rangeDigits
+                ? TRegionCoordinate {1} << (s_rangeDigits - TPolicy::MaxDepth)
+                : TRegionCoordinate {1};
+            const auto unitSize = static_cast<TRegionCoordinate>((TMinRegionSize::num + TMinRegionSize::den - 1) / TMinRegionSize::den);
+            return std::max(depthSize, unitSize);
+        }
+        else
+        {
+            auto depthSize = TRegionCoordinate {0};
+            if (TPolicy::MaxDepth < s_rangeDigits)
+            {
+                depthSize = TRegionCoordinate {1};
+                for (auto i = TPolicy::MaxDepth; i < s_rangeDigits; ++i)
+                {
+                    depthSize *= 2;
+                }
+            }
+            return std::max(depthSize, static_cast<TRegionCoordinate>(TMinRegionSize::num)
+                                       / static_cast<TRegionCoordinate>(TMinRegionSize::den));
+        }
+    }();
+
+    /**
+     * @brief   The maximum depth of the tree, every level halves the region size.
+     *
+     * @details The number of levels from the region twice bigger than the whole range (the
+     *          root anchored below the range) to the smallest regions. The root grows toward
+     *          the keys at both ends of the range up to the size 2^(s_rangeDigits + 2).
+     */
+    static constexpr std::size_t s_maxDepth = []()
+    {
+        if constexpr (std::is_integral_v<TCoordinate>)
+        {
+            return s_rangeDigits + 2;
+        }
+        else
+        {
+            std::size_t depth = 1;
+            auto regionSize = TRegionCoordinate {4};
+            for (std::size_t i = 0; i < s_rangeDigits; ++i)
+            {
+                regionSize *= 2;
+            }
+            for (; regionSize > s_minRegionSize; regionSize /= 2)
+            {
+                ++depth;
+            }
+            return depth;
+        }
+    }();
+
+    /**
+     * @brief   The grid of the floating point roots, the roots are anchored on it.
+     *
+     * @details The multiples of the grid up to the biggest root are exact, so the roots grown
+     *          toward any key have exact corners and the old root is exactly a child of the
+     *          new one. The grid is not bigger than the unit, the integer roots are exact on
+     *          the unit grid.
+     */
+    static constexpr TRegionCoordinate s_rootGrid = []()
+    {
+        auto grid = TRegionCoordinate {1};
+        if constexpr (!std::is_integral_v<TCoordinate>)
+        {
+            for (auto i = s_rangeDigits + 3; i < static_cast<std::size_t>(std::numeric_limits<TRegionCoordinate>::digits); ++i)
+            {
+                grid /= 2;
+            }
+        }
+        return grid;
+    }();
+
+    /**
+     * @brief   The z-order path bits, two bits per level.
+     */
+    using TZOrderBits = space::collections::Array<std::uint64_t, (s_maxDepth + 31) / 32>;
+
+    /**
+     * @brief   The z-order path of node and the node depth.
+     */
+    struct ZOrderCode
+    {
+        TZOrderBits path;
+        std::uint32_t depth;
+
+        constexpr auto operator<=>(const ZOrderCode&) const noexcept = default;
+    };
+
+    /**
+     * @brief   The nodes on the path from the root.
+     */
+    using TNodePath = space::collections::Array<TNodeIndex, s_maxDepth + 1>;
+
+    /**
+     * @brief   The nodes on the z-order path from the root.
+     */
+    struct ZOrderPath
+    {
+        TNodePath nodes;
+        std::uint32_t depth;
+        TZOrderBits code;
+    };
+
+    /**
+     * @brief   The key with the z-order code of its node.
+     */
+    using TCodedKey = std::pair<ZOrderCode, TKey>;
+
+    /**
+     * @brief   The stack for the depth-first traversal.
+     *
+     * @details Every level keeps at most 3 not visited siblings on the stack, so the
+     *          traversal never overflows it and never allocates memory.
+     */
+    using TTraversalStack = space::collections::InlineStack<TNodeIndex, 3 * s_maxDepth + 4>;
+
+    /**
+     * @brief   The number of queries sharing one traversal in queryBatch.
+     */
+    static constexpr std::size_t s_batchChunkSize = 64;
+
+    /**
+     * @brief   The node to visit with the range of active queries in the batch traversal.
+     */
+    struct BatchFrame
+    {
+        TNodeIndex node;
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    /**
+     * @brief   The query index with the found value.
+     */
+    using TBatchHit = std::pair<std::size_t, TKey>;
+
+    /**
+     * @brief   The node waiting in the best-first search queue.
+     */
+    struct NearestNode
+    {
+        double distance;
+        TNodeIndex node;
+
+        constexpr bool operator>(const NearestNode& other) const noexcept
+        {
+            return distance > other.distance;
+        }
+    };
+
+    /**
+     * @brief   The value found by the best-first search.
+     */
+    struct NearestValue
+    {
+        double distance;
+        const TKey* value;
+
+        constexpr bool operator<(const NearestValue& other) const noexcept
+        {
+            return distance < other.distance;
+        }
+    };
+public:
+
+    using size_type = std::size_t;
+
+    /**
+     * @brief   The results of queryBatch in the compressed sparse row format.
+     *
+     * @details The values found for the i-th query are stored in
+     *          [values[offsets[i]], values[offsets[i + 1]]).
+     */
+    struct BatchQueryResult
+    {
+        space::collections::Vector<size_type> offsets {};
+        space::collections::Vector<TKey> values {};
+
+        /**
+         * @brief   Gets the number of queries.
+         *
+         * @return  The number of queries.
+         */
+        [[nodiscard]]
+        size_type size() const noexcept
+        {
+            return offsets.empty() ? 0 : std::size(offsets) - 1;
+        }
+
+        /**
+         * @brief   Gets the values found for the given query.
+         *
+         * @param   index The index of the query.
+         * @return  The span of found values.
+         */
+        [[nodiscard]]
+        space::collections::Span<const TKey> operator[](size_type index) const noexcept
+        {
+            return space::collections::Span<const TKey> {values}.subspan(offsets[index]
+                , offsets[index + 1] - offsets[index]);
+        }
+    };
+
+    QuadTree()
+        : m_nodes()
+        , m_root(s_nullIndex)
+        , m_size(0)
+        , m_version(0)
+        , m_worldRegion()
+        , m_counters()
+    {
+    }
+
+    /**
+     * @brief   Initializes a new instance of the QuadTree for the given world extent.
+     *
+     * @details The root region is created to contain the whole extent, so inserting
+     *          keys inside the extent never re-roots the tree. The keys outside of
+     *          the extent are still supported, the tree grows up for them.
+     *
+     * @param   worldExtent The rectangle which contains all expected keys.
+     */
+    explicit QuadTree(const TBox& worldExtent)
+        : QuadTree()
+    {
+        m_worldRegion = makeRegionFor(worldExtent);
+    }
+
+    QuadTree(QuadTree&& other) noexcept
+        : m_nodes(std::move(other.m_nodes))
+        , m_root(std::exchange(other.m_root, s_nullIndex))
+        , m_size(std::exchange(other.m_size, 0))
+        , m_version(other.m_version++)
+        , m_worldRegion(std::exchange(other.m_worldRegion, std::nullopt))
+        , m_counters(std::move(other.m_counters))
+    {
+    }
+
+    QuadTree& operator=(QuadTree&& other) noexcept
+    {
+        m_nodes = std::move(other.m_nodes);
+        m_root = std::exchange(other.m_root, s_nullIndex);
+        m_size = std::exchange(other.m_size, 0);
+        // Both trees are changed, the new version differs from the versions of both.
+        m_version = std::max(m_version, other.m_version++) + 1;
+        m_worldRegion = std::exchange(other.m_worldRegion, std::nullopt);
+        m_counters = std::move(other.m_counters);
+        return *this;
+    }
+
+    QuadTree(const QuadTree&) = delete;
+
+    QuadTree& operator=(const QuadTree&) = delete;
+
+    /**
+     * @brief   Initializes a new instance of the QuadTree with the given keys.
+     *
+     * @details The tree is built by bulkLoad.
+     *
+     * @tparam  TRange The type of the range of keys.
+     * @param   keys The keys for loading.
+     */
+    template <std::ranges::input_range TRange>
+        requires std::convertible_to<std::ranges::range_reference_t<TRange>, const TKey&>
+    explicit QuadTree(TRange&& keys)
+        : QuadTree()
+    {
+        bulkLoad(std::forward<TRange>(keys));
+    }
+
+    /**
+     * @brief   The input iterator over values intersecting the query rectangle.
+     */
+    class QueryIterator
+    {
+        using TValueIterator = typename Node::TValueContainer::const_iterator;
+    public:
+        using iterator_concept = std::input_iterator_tag;
+        using value_type = TKey;
+        using difference_type = std::ptrdiff_t;
+        using reference = const TKey&;
+
+        QueryIterator() = default;
+
+        QueryIterator(const QuadTree& tree, const TBox& key)
+            : m_tree {std::addressof(tree)}
+            , m_key {key}
+        {
+            if (s_nullIndex != tree.m_root)
+            {
+                m_nodeStack.push(tree.m_root);
+            }
+            satisfy();
+        }
+
+        [[nodiscard]]
+        reference operator*() const noexcept
+        {
+            return *m_valueIt;
+        }
+
+        QueryIterator& operator++()
+        {
+            ++m_valueIt;
+            satisfy();
+            return *this;
+        }
+
+        void operator++(int)
+        {
+            ++*this;
+        }
+
+        [[nodiscard]]
+        friend bool operator==(const QueryIterator& it, std::default_sentinel_t) noexcept
+        {
+            return nullptr == it.m_tree;
+        }
+
+    private:
+
+        /**
+         * @brief   Moves to the next intersecting value, or to the end if there is no one.
+         */
+        void satisfy()
+        {
+            while (true)
+            {
+                for (; m_valueIt != m_valueEnd; ++m_valueIt)
+                {
+                    if (space::util::hasIntersect(m_key, indexableOf(*m_valueIt)))
+                    {
+                        return;
+                    }
+                }
+                if (m_nodeStack.empty())
+                {
+                    m_tree = nullptr;
+                    return;
+                }
+                const Node& currentNode = m_tree->m_nodes[m_nodeStack.top()];
+                m_nodeStack.pop();
+                if (!space::util::hasIntersect(m_key, boundsOf(currentNode.region())))
+                {
+                    continue;
+                }
+                for (const auto child : currentNode.getChildren())
+                {
+                    if (s_nullIndex != child)
+                    {
+                        m_nodeStack.push(child);
+                    }
+                }
+                m_valueIt = currentNode.getValues().begin();
+                m_valueEnd = currentNode.getValues().end();
+            }
+        }
+
+    private:
+        const QuadTree* m_tree {nullptr};
+        TBox m_key {};
+        TTraversalStack m_nodeStack {};
+        TValueIterator m_valueIt {};
+        TValueIterator m_valueEnd {};
+    };
+
+    /**
+     * @brief   The lazy view of values intersecting the query rectangle.
+     */
+    class QueryView : public std::ranges::view_interface<QueryView>
+    {
+    public:
+        QueryView() = default;
+
+        QueryView(const QuadTree& tree, const TBox& key)
+            : m_tree {std::addressof(tree)}
+            , m_key {key}
+        {
+        }
+
+        [[nodiscard]]
+        QueryIterator begin() const
+        {
+            return QueryIterator {*m_tree, m_key};
+        }
+
+        [[nodiscard]]
+        std::default_sentinel_t end() const noexcept
+        {
+            return std::default_sentinel;
+        }
+
+    private:
+        const QuadTree* m_tree {nullptr};
+        TBox m_key {};
+    };
+
+    /**
+     * @brief   Inserts a value to the quad tree.
+     *
+     * @param   key The new value.
+     * @return  true if value successfully inserted, otherwise false.
+     */
+    bool insert(const TKey& key)
+    {
+        const auto& box = indexableOf(key);
+        if (s_nullIndex == m_root)
+        {
+            creatRoot(box);
+        }
+
+        growUpIfNeeds(box);
+
+        auto& node = growDownIfNeedsAndReturnLastNode(box);
+        if constexpr (s_collectStats)
+        {
+            m_counters.add({.valueShifts = shiftCountOf(node.getValues(), key)});
+        }
+        if (node.addValue(key))
+        {
+            ++m_size;
+            ++m_version;
+            if constexpr (s_isBucketed)
+            {
+                splitIfNeeds(node, box);
+            }
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief   Inserts all keys of the given range to the quad tree.
+     *
+     * @details The root region is computed once for the whole range. Then every key gets
+     *          the z-order code of its node (the path of ZOrderPos from the root), the keys
+     *          are sorted by the codes, so the keys of one node become one sorted run, and
+     *          the nodes are built in a single pass with one FlatSet merge per node.
+     *          The algorithm complexity is O(n * (depth + log(n))), independently of the
+     *          number of keys stored in one node. The trees with the leaf capacity insert
+     *          the keys one by one, since the node of key depends on the keys before it.
+     *
+     * @tparam  TRange The type of the range of keys.
+     * @param   keys The keys for inserting.
+     * @return  The number of keys inserted (duplicates are not inserted).
+     */
+    template <std::ranges::input_range TRange>
+        requires std::convertible_to<std::ranges::range_reference_t<TRange>, const TKey&>
+    size_type bulkLoad(TRange&& keys)
+    {
+        return bulkLoad(std::execution::seq, std::forward<TRange>(keys));
+    }
+
+    /**
+     * @brief   Inserts all keys of the given range to the quad tree, the z-order codes are
+     *          computed and sorted by the given execution policy.
+     *
+     * @details The nodes are built in a single pass as in bulkLoad(keys), the parallel part
+     *          is the coding and sorting of keys.
+     *
+     * @tparam  TExecutionPolicy The type of execution policy.
+     * @tparam  TRange The type of the range of keys.
+     * @param   policy The execution policy.
+     * @param   keys The keys for inserting.
+     * @return  The number of keys inserted (duplicates are not inserted).
+     */
+    template <typename TExecutionPolicy, std::ranges::input_range TRange>
+        requires std::is_execution_policy_v<std::remove_cvref_t<TExecutionPolicy>>
+                 && std::convertible_to<std::ranges::range_reference_t<TRange>, const TKey&>
+    size_type bulkLoad(TExecutionPolicy&& policy, TRange&& keys)
+    {
+        if constexpr (s_isBucketed)
+        {
+            // The node of key depends on the keys inserted before it.
+            const auto oldSize = m_size;
+            for (const TKey& key : keys)
+            {
+                insert(key);
+            }
+            return m_size - oldSize;
+        }
+        space::collections::Vector<TCodedKey> codedKeys;
+        if constexpr (std::ranges::sized_range<TRange>)
+        {
+            codedKeys.reserve(std::ranges::size(keys));
+        }
+        for (const TKey& key : keys)
+        {
+            codedKeys.push_back({{}, key});
+        }
+        if (codedKeys.empty())
+        {
+            return 0;
+        }
+
+        const auto extent = boundaryBoxOf(codedKeys);
+        if (s_nullIndex == m_root)
+        {
+            creatRoot(extent);
+        }
+        growUpIfNeeds(extent);
+
+        const auto rootRegion = m_nodes[m_root].region();
+        std::for_each(policy, codedKeys.begin(), codedKeys.end(), [&rootRegion](auto& codedKey)
+        {
+            codedKey.first = zOrderCodeOf(indexableOf(codedKey.second), rootRegion);
+        });
+        std::sort(policy, codedKeys.begin(), codedKeys.end(), [](const auto& first, const auto& second)
+        {
+            return first.first < second.first;
+        });
+
+        const auto oldSize = m_size;
+        space::collections::Vector<TKey> nodeKeys;
+        ZOrderPath nodePath {{m_root}, 0, {}};
+        for (auto groupBegin = codedKeys.begin(); groupBegin != codedKeys.end();)
+        {
+            const auto& code = groupBegin->first;
+            const auto groupEnd = std::find_if(groupBegin + 1, codedKeys.end(), [&code](const auto& codedKey)
+            {
+                return codedKey.first != code;
+            });
+
+            nodeKeys.clear();
+            std::transform(groupBegin, groupEnd, std::back_inserter(nodeKeys), [](const auto& codedKey)
+            {
+                return codedKey.second;
+            });
+            std::ranges::sort(nodeKeys);
+            const auto uniqueEnd = std::unique(nodeKeys.begin(), nodeKeys.end());
+
+            m_size += growDownByCode(code, nodePath).mergeValues(nodeKeys.begin(), uniqueEnd);
+
+            groupBegin = groupEnd;
+        }
+        if (oldSize != m_size)
+        {
+            ++m_version;
+        }
+        return m_size - oldSize;
+    }
+
+    /**
+     * @brief   Finds values intersecting a given rectangle.
+     *
+     * @details The traversal stack is kept inline, so the query itself doesn't allocate memory.
+     *
+     * @tparam  TOutIt The type of output iterator.
+     * @param   key The rectangle for query.
+     * @param   outIt The output iterator.
+     */
+    template <typename TOutIt>
+    void query(const TBox& key, TOutIt outIt) const
+    {
+        visitIntersecting(key, [&outIt](const TKey& value)
+        {
+            *outIt++ = value;
+            return true;
+        });
+    }
+
+    /**
+     * @brief   Returns the lazy view of values intersecting a given rectangle.
+     *
+     * @details The nodes are traversed while the view is iterated, so the caller pays only
+     *          for the values it reads. The view refers to the tree, the modification of
+     *          the tree invalidates it.
+     *
+     * @param   key The rectangle for query.
+     * @return  The input range of found values.
+     */
+    [[nodiscard]]
+    QueryView queryRange(const TBox& key) const
+    {
+        return QueryView {*this, key};
+    }
+
+    /**
+     * @brief   Checks there is a value intersecting a given rectangle.
+     *
+     * @details The traversal stops at the first found value.
+     *
+     * @param   key The rectangle for query.
+     * @return  true if there is an intersecting value, otherwise false.
+     */
+    [[nodiscard]]
+    bool queryAny(const TBox& key) const
+    {
+        return !visitIntersecting(key, [](const TKey&)
+        {
+            return false;
+        });
+    }
+
+    /**
+     * @brief   Counts values intersecting a given rectangle.
+     *
+     * @details The values are not copied, the values of nodes covered by the rectangle are
+     *          counted without the intersection tests.
+     *
+     * @param   key The rectangle for query.
+     * @return  The number of intersecting values.
+     */
+    [[nodiscard]]
+    size_type queryCount(const TBox& key) const
+    {
+        size_type count = 0;
+        visitIntersecting(key, [&count](const TKey&)
+        {
+            ++count;
+            return true;
+        });
+        return count;
+    }
+
+    /**
+     * @brief   Finds the k nearest values to the given point.
+     *
+     * @details The best-first search, the nodes are visited in the order of the distance
+     *          from the point to the node region, which is zero for the regions containing
+     *          the point. The k best values found so far are kept in the max-heap, a value or
+     *          child is considered only if it is closer than the worst of them. The node distance
+     *          is the lower bound for its values, so the search stops at the first node which is
+     *          farther than the k-th best value.
+     *
+     * @tparam  TOutIt The type of output iterator.
+     * @param   point The point.
+     * @param   k The number of values to find.
+     * @param   outIt The output iterator, the values are written in ascending order of distance.
+     */
+    template <typename TOutIt>
+    void nearest(const space::Point<TCoordinate>& point, size_type k, TOutIt outIt) const
+    {
+        if (s_nullIndex == m_root || 0 == k)
+        {
+            return;
+        }
+        using TNodeQueue = std::priority_queue<NearestNode, space::collections::Vector<NearestNode>, std::greater<>>;
+        TNodeQueue nodes;
+        space::collections::Vector<NearestValue> best;
+        best.reserve(std::min(k, m_size));
+        const auto isCloserThanBest = [&best, k](const double distance)
+        {
+            return std::size(best) < k || distance < best.front().distance;
+        };
+
+        nodes.push({distanceOf(boundsOf(m_nodes[m_root].region()), point), m_root});
+        while (!nodes.empty() && isCloserThanBest(nodes.top().distance))
+        {
+            const Node& currentNode = m_nodes[nodes.top().node];
+            nodes.pop();
+            for (const auto& value : currentNode.getValues())
+            {
+                const auto distance = distanceOf(indexableOf(value), point);
+                if (!isCloserThanBest(distance))
+                {
+                    continue;
+                }
+                if (std::size(best) == k)
+                {
+                    std::pop_heap(best.begin(), best.end());
+                    best.pop_back();
+                }
+                best.push_back({distance, std::addressof(value)});
+                std::push_heap(best.begin(), best.end());
+            }
+            for (const auto child : currentNode.getChildren())
+            {
+                if (s_nullIndex == child)
+                {
+                    continue;
+                }
+                const auto distance = distanceOf(boundsOf(m_nodes[child].region()), point);
+                if (isCloserThanBest(distance))
+                {
+                    nodes.push({distance, child});
+                }
+            }
+        }
+
+        std::sort_heap(best.begin(), best.end());
+        for (const auto& [distance, value] : best)
+        {
+            *outIt++ = *value;
+        }
+    }
+
+    /**
+     * @brief   Finds values intersecting every rectangle of the given batch.
+     *
+     * @details The queries are split to the chunks of s_batchChunkSize queries, every chunk
+     *          traverses the tree once, visiting a node only for the queries which intersect
+     *          the node region. The chunks are processed by the given execution policy, every
+     *          chunk writes only its own part of the result, so there is no locking.
+     *
+     * @tparam  TExecutionPolicy The type of execution policy.
+     * @param   policy The execution policy.
+     * @param   keys The rectangles for query.
+     * @return  The found values for every query.
+     */
+    template <typename TExecutionPolicy>
+        requires std::is_execution_policy_v<std::remove_cvref_t<TExecutionPolicy>>
+    BatchQueryResult queryBatch(TExecutionPolicy&& policy, space::collections::Span<const TBox> keys) const
+    {
+        const auto queryCount = std::size(keys);
+        const auto chunkCount = (queryCount + s_batchChunkSize - 1) / s_batchChunkSize;
+
+        space::collections::Vector<size_type> chunks(chunkCount);
+        std::iota(chunks.begin(), chunks.end(), size_type {0});
+        space::collections::Vector<space::collections::Vector<TBatchHit>> chunkHits(chunkCount);
+
+        BatchQueryResult result;
+        result.offsets.assign(queryCount + 1, 0);
+        std::for_each(policy, chunks.begin(), chunks.end(), [&](const size_type chunk)
+        {
+            const auto first = chunk * s_batchChunkSize;
+            const auto last = std::min(first + s_batchChunkSize, queryCount);
+            auto& hits = chunkHits[chunk];
+            queryChunk(keys, first, last, hits);
+            for (const auto& hit : hits)
+            {
+                ++result.offsets[hit.first + 1];
+            }
+        });
+
+        std::inclusive_scan(policy, result.offsets.begin(), result.offsets.end(), result.offsets.begin());
+        result.values.resize(result.offsets.back());
+
+        std::for_each(policy, chunks.begin(), chunks.end(), [&](const size_type chunk)
+        {
+            const auto first = chunk * s_batchChunkSize;
+            const auto last = std::min(first + s_batchChunkSize, queryCount);
+            space::collections::Vector<size_type> cursors(result.offsets.begin() + static_cast<std::ptrdiff_t>(first)
+                                                          , result.offsets.begin() + static_cast<std::ptrdiff_t>(last));
+            for (auto& [query, value] : chunkHits[chunk])
+            {
+                result.values[cursors[query - first]++] = std::move(value);
+            }
+        });
+        return result;
+    }
+
+    /**
+     * @brief   Finds values intersecting every rectangle of the given batch in parallel.
+     *
+     * @param   keys The rectangles for query.
+     * @return  The found values for every query.
+     */
+    BatchQueryResult queryBatch(space::collections::Span<const TBox> keys) const
+    {
+        return queryBatch(std::execution::par, keys);
+    }
+
+    /**
+     * @brief   Removes given rectangle form quadtree.
+     *
+     * @details The node which became empty is released together with its ancestors which
+     *          became empty, so no dead branches are left on the path.
+     *
+     * @param   key the rectangle.
+     */
+    void remove(const TKey& key)
+    {
+        eraseKey(key);
+    }
+
+    /**
+     * @brief   Replaces the stored key by the new one, i.e. moves the object to the new box.
+     *
+     * @details The path from the root to the node of the old key is recorded once, the new key
+     *          follows that path down to the first divergence and only the rest of its path is
+     *          walked (or grown). When both keys belong to one node the value slot is reused,
+     *          only the values between the old and new positions are shifted. The tree grows up
+     *          if the new key is outside of the root region.
+     *
+     * @param   oldKey The stored key.
+     * @param   newKey The new key.
+     * @return  true if the key is updated, false if the old key is not stored or the new key
+     *          is already stored (the tree is not changed).
+     */
+    bool update(const TKey& oldKey, const TKey& newKey)
+    {
+        if (s_nullIndex == m_root)
+        {
+            return false;
+        }
+        if constexpr (s_isBucketed)
+        {
+            // The new key node depends on the leaf capacity, it is found by insert.
+            if (!contains(oldKey))
+            {
+                return false;
+            }
+            if (oldKey == newKey)
+            {
+                return true;
+            }
+            if (contains(newKey))
+            {
+                return false;
+            }
+            eraseKey(oldKey);
+            insert(newKey);
+            return true;
+        }
+        const auto& oldBox = indexableOf(oldKey);
+        const auto& newBox = indexableOf(newKey);
+
+        TNodePath path;
+        const auto pathDepth = findPath(oldBox, path);
+        if (!pathDepth)
+        {
+            return false;
+        }
+        const auto depth = *pathDepth;
+        auto& oldNode = m_nodes[path[depth]];
+        if (!oldNode.containsValue(oldKey))
+        {
+            return false;
+        }
+        if (oldKey == newKey)
+        {
+            return true;
+        }
+        if (!isInside(newBox, m_nodes[m_root].region()))
+        {
+            // The new key is outside of all stored keys, so it can't be a duplicate.
+            remove(oldKey);
+            insert(newKey);
+            return true;
+        }
+
+        std::size_t level = 0;
+        while (level < depth && !isTerminal(newBox, m_nodes[path[level]].region())
+               && path[level + 1] == m_nodes[path[level]].getChild(getZOrderPos(m_nodes[path[level]].region(), newBox)))
+        {
+            ++level;
+        }
+        const auto newNodeIndex = findDescendant(path[level], newBox);
+        if (path[depth] == newNodeIndex)
+        {
+            const bool isReplaced = oldNode.replaceValue(oldKey, newKey);
+            m_version += isReplaced ? 1 : 0;
+            return isReplaced;
+        }
+        if (s_nullIndex != newNodeIndex && m_nodes[newNodeIndex].containsValue(newKey))
+        {
+            return false;
+        }
+
+        oldNode.eraseValue(oldKey);
+        growDownIfNeedsAndReturnLastNode(newBox, path[level]).addValue(newKey);
+        pruneEmptyPath({path.data(), depth + 1});
+        ++m_version;
+        return true;
+    }
+
+    /**
+     * @brief   Applies the batch of updates, see update.
+     *
+     * @details The updates are sorted by the z-order codes of the old keys nodes, the codes are
+     *          computed without touching the tree. Then the nodes are visited in the z-order
+     *          reusing the common prefix of paths, so every node is walked once. Every node erases
+     *          all its old keys in one pass and merges the new keys staying in the same node,
+     *          the other new keys are inserted by bulkLoad. All old keys are removed before
+     *          the new keys are inserted. As by update, the update is skipped if its old key is
+     *          not stored or its new key is already stored, the update with the old or new key
+     *          of a preceding update is skipped too, so no key is lost or stored twice.
+     *
+     * @param   updates The pairs of the old key and the new key.
+     * @return  The number of applied updates.
+     */
+    size_type applyUpdates(space::collections::Span<const std::pair<TKey, TKey>> updates)
+    {
+        if (s_nullIndex == m_root)
+        {
+            return 0;
+        }
+        // The new keys are checked before any old key is erased.
+        space::collections::Vector<std::size_t> byNewKey(std::size(updates));
+        std::iota(byNewKey.begin(), byNewKey.end(), std::size_t {0});
+        std::ranges::stable_sort(byNewKey, {}, [&updates](const auto i) -> const TKey& { return updates[i].second; });
+        space::collections::Vector<bool> isSkipped(std::size(updates), false);
+        for (std::size_t k = 0; k < std::size(byNewKey); ++k)
+        {
+            const auto& [oldKey, newKey] = updates[byNewKey[k]];
+            isSkipped[byNewKey[k]] = (0 != k && updates[byNewKey[k - 1]].second == newKey)
+                                     || (!(oldKey == newKey) && contains(newKey));
+        }
+        if constexpr (s_isBucketed)
+        {
+            space::collections::Vector<TKey> newKeys;
+            for (std::size_t i = 0; i < std::size(updates); ++i)
+            {
+                if (!isSkipped[i] && eraseKey(updates[i].first))
+                {
+                    newKeys.push_back(updates[i].second);
+                }
+            }
+            for (const auto& newKey : newKeys)
+            {
+                insert(newKey);
+            }
+            return std::size(newKeys);
+        }
+        const auto rootRegion = m_nodes[m_root].region();
+        space::collections::Vector<std::pair<ZOrderCode, std::size_t>> codedUpdates;
+        codedUpdates.reserve(std::size(updates));
+        for (std::size_t i = 0; i < std::size(updates); ++i)
+        {
+            // The stored keys are strictly inside the root region.
+            const auto& oldBox = indexableOf(updates[i].first);
+            if (!isSkipped[i] && isInside(oldBox, rootRegion))
+            {
+                codedUpdates.emplace_back(zOrderCodeOf(oldBox, rootRegion), i);
+            }
+        }
+        // The first update of the old key is applied, the later ones are skipped.
+        std::ranges::sort(codedUpdates, [&updates](const auto& lhs, const auto& rhs)
+        {
+            if (lhs.first != rhs.first)
+            {
+                return lhs.first < rhs.first;
+            }
+            const auto& lhsKey = updates[lhs.second].first;
+            const auto& rhsKey = updates[rhs.second].first;
+            return lhsKey != rhsKey ? lhsKey < rhsKey : lhs.second < rhs.second;
+        });
+
+        size_type appliedCount = 0;
+        space::collections::Vector<TKey> oldKeys;
+        space::collections::Vector<TKey> nodeKeys;
+        space::collections::Vector<TKey> movedKeys;
+        space::collections::Vector<std::size_t> missedUpdates;
+        ZOrderPath nodePath {{m_root}, 0, {}};
+        for (auto groupBegin = codedUpdates.begin(); groupBegin != codedUpdates.end() && s_nullIndex != m_root;)
+        {
+            const auto& code = groupBegin->first;
+            const auto groupEnd = std::find_if(groupBegin + 1, codedUpdates.end(), [&code](const auto& codedUpdate)
+            {
+                return codedUpdate.first != code;
+            });
+
+            const auto nodeIndex = findByCode(code, nodePath);
+            if (s_nullIndex == nodeIndex)
+            {
+                std::transform(groupBegin, groupEnd, std::back_inserter(missedUpdates), [](const auto& codedUpdate)
+                {
+                    return codedUpdate.second;
+                });
+                groupBegin = groupEnd;
+                continue;
+            }
+            auto& node = m_nodes[nodeIndex];
+            oldKeys.clear();
+            nodeKeys.clear();
+            for (auto it = groupBegin; it != groupEnd; ++it)
+            {
+                const auto& [oldKey, newKey] = updates[it->second];
+                if (!oldKeys.empty() && oldKeys.back() == oldKey)
+                {
+                    continue;
+                }
+                if (!node.containsValue(oldKey))
+                {
+                    missedUpdates.push_back(it->second);
+                    continue;
+                }
+                oldKeys.push_back(oldKey);
+                const auto& newBox = indexableOf(newKey);
+                const bool isSameNode = isInside(newBox, rootRegion) && zOrderCodeOf(newBox, rootRegion) == code;
+                (isSameNode ? nodeKeys : movedKeys).push_back(newKey);
+            }
+            appliedCount += std::size(oldKeys);
+            m_size -= node.eraseValues(oldKeys.begin(), oldKeys.end());
+            std::ranges::sort(nodeKeys);
+            const auto uniqueEnd = std::unique(nodeKeys.begin(), nodeKeys.end());
+            m_size += node.mergeValues(nodeKeys.begin(), uniqueEnd);
+
+            const auto keptCount = pruneEmptyPath({nodePath.nodes.data(), nodePath.depth + std::size_t {1}});
+            nodePath.depth = static_cast<std::uint32_t>(keptCount == 0 ? 0 : keptCount - 1);
+            groupBegin = groupEnd;
+        }
+
+        // The key may be stored above its z-order node, e.g. in the node which was the root before growing up.
+        for (const auto i : missedUpdates)
+        {
+            if (eraseKey(updates[i].first))
+            {
+                ++appliedCount;
+                movedKeys.push_back(updates[i].second);
+            }
+        }
+        bulkLoad(movedKeys);
+        if (0 != appliedCount)
+        {
+            ++m_version;
+        }
+        return appliedCount;
+    }
+
+    /**
+     * @brief   Determines whether the quadtree contains the specified key.
+     *
+     * @param   key The key to locate in the quadtree.
+     * @return  true if the quadtree contains an element with the specified key; otherwise, false.
+     */
+    [[nodiscard]]
+    bool contains(const TKey& key) const
+    {
+        const auto* nodeLink = findNode(indexableOf(key));
+        if (nullptr == nodeLink)
+        {
+            return false;
+        }
+        const auto& values = m_nodes[*nodeLink].getValues();
+        return values.end() != values.find(key);
+    }
+
+    /**
+     * @brief  Checks the container empty or not.
+     *
+     * @return true if the container is empty, otherwise false.
+     */
+    [[nodiscard]]
+    bool empty() const noexcept
+    {
+        return 0 == m_size;
+    }
+
+    /**
+     * @brief Removes all values stored in the container.
+     *
+     * @details The nodes are released together with their slabs, so the cost depends
+     *          on the number of slabs instead of walking the whole tree.
+     */
+    void clear()
+    {
+        m_nodes.clear();
+        m_root = s_nullIndex;
+        m_size = 0;
+        ++m_version;
+    }
+
+    /**
+     * @brief   Get the number of values stored in the index.
+     *
+     * @return  The number of values stored in the index.
+     */
+    [[nodiscard]]
+    size_type size() const noexcept
+    {
+        return m_size;
+    }
+
+    /**
+     * @brief   Gets the version of the stored values.
+     *
+     * @details The version is changed by every operation which changes the values (insert,
+     *          bulkLoad, remove, update, applyUpdates, clear and the move), so the results
+     *          computed for one version, e.g. by QueryCache, are valid while it is the same.
+     *          The compact keeps the version, it changes only the layout of nodes.
+     *
+     * @return  The version.
+     */
+    [[nodiscard]]
+    std::uint64_t version() const noexcept
+    {
+        return m_version;
+    }
+
+    /**
+     * @brief   Get the number of nodes of the tree.
+     *
+     * @return  The number of nodes.
+     */
+    [[nodiscard]]
+    size_type nodeCount() const noexcept
+    {
+        return std::size(m_nodes);
+    }
+
+    /**
+     * @brief   Gets the snapshot of the tree structure and operation counters.
+     *
+     * @details The structure is computed by one traversal of the nodes. The counters are
+     *          collected only by the trees with the CollectStats policy (see StatsQuadTreePolicy),
+     *          otherwise they are zero and the operations don't pay for them.
+     *
+     * @return  The statistics of the tree.
+     */
+    [[nodiscard]]
+    QuadTreeStats stats() const
+    {
+        QuadTreeStats result {};
+        result.counters = m_counters.load();
+        result.nodeCount = std::size(m_nodes);
+        result.valueCount = m_size;
+        result.bytesUsed = m_nodes.capacity() * sizeof(Node);
+        if (s_nullIndex == m_root)
+        {
+            return result;
+        }
+
+        const auto increment = [](auto& histogram, std::size_t bucket, std::size_t count)
+        {
+            if (std::size(histogram) <= bucket)
+            {
+                histogram.resize(bucket + 1, 0);
+            }
+            histogram[bucket] += count;
+        };
+        space::collections::Vector<std::pair<TNodeIndex, std::size_t>> nodeStack {{m_root, 0}};
+        while (!nodeStack.empty())
+        {
+            const auto[index, depth] = nodeStack.back();
+            nodeStack.pop_back();
+            const auto& node = m_nodes[index];
+            const auto valueCount = std::size(node.getValues());
+            increment(result.nodesPerDepth, depth, 1);
+            increment(result.valuesPerDepth, depth, valueCount);
+            increment(result.valuesPerNode, static_cast<std::size_t>(std::bit_width(valueCount)), 1);
+            result.bytesUsed += node.getValues().capacity() * sizeof(TKey);
+            if constexpr (s_hasColumns)
+            {
+                result.bytesUsed += node.getColumns().capacity() * 4 * sizeof(TCoordinate);
+            }
+            for (const auto child : node.getChildren())
+            {
+                if (s_nullIndex != child)
+                {
+                    nodeStack.emplace_back(child, depth + 1);
+                }
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief   Resets the operation counters to zero.
+     */
+    void resetStats() noexcept
+    {
+        m_counters.reset();
+    }
+
+    /**
+     * @brief   Rebuilds the nodes of the tree densely and releases the unused memory.
+     *
+     * @details The empty subtrees are removed and the root is lowered while it has no values
+     *          and only one child (the root of the tree with the world region is kept).
+     *          The live nodes are moved to the new pool in the pre-order, so the slabs of the
+     *          released nodes are returned and the subtrees are contiguous in memory, and the
+     *          unused capacity of the node values is released. The complexity is O(n).
+     */
+    void compact()
+    {
+        if (s_nullIndex == m_root)
+        {
+            return;
+        }
+        m_root = pruneSubtree(m_root);
+        while (!m_worldRegion && s_nullIndex != m_root && m_nodes[m_root].getValues().empty())
+        {
+            const auto& children = m_nodes[m_root].getChildren();
+            const auto isChild = [](const auto child) { return s_nullIndex != child; };
+            if (1 != std::ranges::count_if(children, isChild)
+                || m_nodes[*std::ranges::find_if(children, isChild)].region().size() < s_rootGrid)
+            {
+                break;
+            }
+            m_nodes.release(std::exchange(m_root, *std::ranges::find_if(children, isChild)));
+        }
+        if (s_nullIndex == m_root)
+        {
+            m_nodes.clear();
+            return;
+        }
+        TNodePool nodes;
+        m_root = moveSubtree(m_root, nodes);
+        m_nodes = std::move(nodes);
+    }
+
+    /**
+     * @brief   Saves the snapshot of the tree to the given file.
+     *
+     * @details The nodes are written in the breadth-first order with their bounds, so the
+     *          snapshot is queried in place by MappedQuadTree without rebuilding the tree.
+     *          The complexity is O(n), the file is overwritten.
+     *
+     * @throws  std::runtime_error if the file can't be written.
+     *
+     * @param   path The path of snapshot.
+     */
+    void save(const std::filesystem::path& path) const
+        requires std::is_trivially_copyable_v<TKey>
+    {
+        using TSnapshotNode = QuadTreeSnapshotNode<TRegionCoordinate>;
+
+        space::collections::Vector<TSnapshotNode> snapshotNodes;
+        space::collections::Vector<TKey> snapshotValues;
+        snapshotValues.reserve(m_size);
+        space::collections::Vector<TNodeIndex> order;
+        if (s_nullIndex != m_root)
+        {
+            order.push_back(m_root);
+        }
+        for (std::size_t i = 0; i < std::size(order); ++i)
+        {
+            const Node& currentNode = m_nodes[order[i]];
+            TSnapshotNode snapshotNode {boundsOf(currentNode.region()), static_cast<std::uint32_t>(std::size(order)), 0
+                                        , std::size(snapshotValues), 0};
+            for (const auto child : currentNode.getChildren())
+            {
+                if (s_nullIndex != child)
+                {
+                    order.push_back(child);
+                    ++snapshotNode.childCount;
+                }
+            }
+            const auto& values = currentNode.getValues();
+            snapshotValues.insert(snapshotValues.end(), values.begin(), values.end());
+            snapshotNode.valueEnd = std::size(snapshotValues);
+            snapshotNodes.push_back(snapshotNode);
+        }
+        space::impl::writeQuadTreeSnapshot<TKey, TSnapshotNode>(path, snapshotNodes, snapshotValues);
+    }
+
+#ifdef SPACE_HAS_MMAP
+    /**
+     * @brief   Maps the snapshot written by save for the read-only queries.
+     *
+     * @details Available only on the platforms with mmap (SPACE_HAS_MMAP).
+     *
+     * @throws  std::system_error if the file can't be opened or mapped.
+     * @throws  std::runtime_error if the file is not the valid snapshot for TKey.
+     *
+     * @param   path The path of snapshot.
+     * @return  The mapped tree.
+     */
+    [[nodiscard]]
+    static MappedQuadTree<TKey, TPolicy> openMapped(const std::filesystem::path& path)
+        requires std::is_trivially_copyable_v<TKey>
+    {
+        return MappedQuadTree<TKey, TPolicy> {path};
+    }
+#endif // SPACE_HAS_MMAP
+
+private:
+
+    /**
+     * @internal
+     * @brief   Returns the link to the node for the given key.
+     *
+     * @details The link is the root index or the child index stored in the parent node,
+     *          it can be used to unlink the node from the tree.
+     *
+     * @param   key The key.
+     * @return  The pointer to node link if that exists, otherwise null. The trees with the leaf
+     *          capacity return the deepest node on the key path.
+     */
+    const TNodeIndex* findNode(const TBox& key) const
+    {
+        if (s_nullIndex == m_root)
+        {
+            return nullptr;
+        }
+        const auto* currentLink = std::addressof(m_root);
+        while (!isTerminal(key, m_nodes[*currentLink].region()))
+        {
+            const auto& currentNode = m_nodes[*currentLink];
+            const auto zOrderPos = getZOrderPos(currentNode.region(), key);
+            const auto& child = currentNode.getChildren()[static_cast<std::size_t>(zOrderPos)];
+
+            if (s_nullIndex == child)
+            {
+                // The bucketed key stays in the leaf on its path.
+                return s_isBucketed ? currentLink : nullptr;
+            }
+            currentLink = std::addressof(child);
+        }
+        return currentLink;
+    }
+
+    TNodeIndex* findNode(const TBox& key)
+    {
+        return const_cast<TNodeIndex*>(std::as_const(*this).findNode(key));
+    }
+
+    /**
+     * @internal
+     * @brief   Records the path from the root to the node for the given key.
+     *
+     * @param   key The key.
+     * @param   path The nodes from the root to the node.
+     * @return  The depth of the node if that exists, otherwise nullopt. The trees with the leaf
+     *          capacity return the depth of the deepest node on the key path.
+     */
+    std::optional<std::size_t> findPath(const TBox& key, TNodePath& path) const
+    {
+        if (s_nullIndex == m_root)
+        {
+            return std::nullopt;
+        }
+        std::size_t depth = 0;
+        path[0] = m_root;
+        while (!isTerminal(key, m_nodes[path[depth]].region()))
+        {
+            const auto& currentNode = m_nodes[path[depth]];
+            const auto child = currentNode.getChildren()[static_cast<std::size_t>(getZOrderPos(currentNode.region(), key))];
+            if (s_nullIndex == child)
+            {
+                if constexpr (s_isBucketed)
+                {
+                    return depth;
+                }
+                return std::nullopt;
+            }
+            path[++depth] = child;
+        }
+        return depth;
+    }
+
+    /**
+     * @internal
+     * @brief   Erases the key and prunes the nodes which became empty.
+     *
+     * @param   key The key.
+     * @return  true if the key was stored, otherwise false.
+     */
+    bool eraseKey(const TKey& key)
+    {
+        TNodePath path;
+        const auto depth = findPath(indexableOf(key), path);
+        if constexpr (s_collectStats)
+        {
+            if (depth)
+            {
+                m_counters.add({.valueShifts = shiftCountOf(m_nodes[path[*depth]].getValues(), key)});
+            }
+        }
+        if (!depth || !m_nodes[path[*depth]].eraseValue(key))
+        {
+            return false;
+        }
+        --m_size;
+        ++m_version;
+        pruneEmptyPath({path.data(), *depth + 1});
+        return true;
+    }
+
+    /**
+     * @internal
+     * @brief   Releases the last node of the path if that is empty, and then its ancestors
+     *          which became empty.
+     *
+     * @param   path The nodes from the root.
+     * @return  The number of the kept nodes of path, 0 if the root is released.
+     */
+    std::size_t pruneEmptyPath(space::collections::Span<const TNodeIndex> path)
+    {
+        auto keptCount = std::size(path);
+        while (0 != keptCount && m_nodes[path[keptCount - 1]].empty())
+        {
+            const auto node = path[keptCount - 1];
+            auto& link = (1 == keptCount) ? m_root : *std::ranges::find(m_nodes[path[keptCount - 2]].getChildren(), node);
+            m_nodes.release(std::exchange(link, s_nullIndex));
+            --keptCount;
+        }
+        return keptCount;
+    }
+
+    /**
+     * @internal
+     * @brief   Releases the empty nodes of the subtree.
+     *
+     * @param   index The root of subtree.
+     * @return  The root of subtree, s_nullIndex if the whole subtree is released.
+     */
+    TNodeIndex pruneSubtree(TNodeIndex index)
+    {
+        for (auto& child : m_nodes[index].getChildren())
+        {
+            if (s_nullIndex != child)
+            {
+                child = pruneSubtree(child);
+            }
+        }
+        if (m_nodes[index].empty())
+        {
+            m_nodes.release(index);
+            return s_nullIndex;
+        }
+        return index;
+    }
+
+    /**
+     * @internal
+     * @brief   Moves the subtree to the given pool in the pre-order.
+     *
+     * @param   index The root of subtree.
+     * @param   nodes The destination pool.
+     * @return  The index of subtree root in the destination pool.
+     */
+    TNodeIndex moveSubtree(TNodeIndex index, TNodePool& nodes)
+    {
+        const auto newIndex = nodes.create(std::move(m_nodes[index]));
+        auto& newNode = nodes[newIndex];
+        newNode.shrinkToFit();
+        for (auto& child : newNode.getChildren())
+        {
+            if (s_nullIndex != child)
+            {
+                child = moveSubtree(child, nodes);
+            }
+        }
+        return newIndex;
+    }
+
+    /**
+     * @internal
+     * @brief   Returns the node for the given key in the subtree of the given node.
+     *
+     * @param   from The node to start from, the key path from the root must pass it.
+     * @param   key The key.
+     * @return  The node index if that exists, otherwise s_nullIndex.
+     */
+    TNodeIndex findDescendant(TNodeIndex from, const TBox& key) const
+    {
+        auto current = from;
+        while (s_nullIndex != current && !isTerminal(key, m_nodes[current].region()))
+        {
+            const auto& currentNode = m_nodes[current];
+            current = currentNode.getChildren()[static_cast<std::size_t>(getZOrderPos(currentNode.region(), key))];
+        }
+        return current;
+    }
+
+    /**
+     * @internal
+     * @brief       Calls the visitor for every value intersecting the given rectangle.
+     *
+     * @details     The values are strictly inside of the node region, so when the rectangle
+     *              covers the region, the values of the node are visited without the tests.
+     *
+     * @tparam TVisitor The type of visitor, returns false to stop the traversal.
+     * @param key   The rectangle.
+     * @param visitor The visitor.
+     * @return      false if the visitor stopped the traversal, otherwise true.
+     */
+    template <typename TVisitor>
+    bool visitIntersecting(const TBox& key, TVisitor&& visitor) const
+    {
+        QuadTreeCounters counters {.queries = 1};
+        const auto isCompleted = visitIntersecting(key, visitor, counters);
+        if constexpr (s_collectStats)
+        {
+            m_counters.add(counters);
+        }
+        return isCompleted;
+    }
+
+    /**
+     * @internal
+     * @brief       Calls the visitor for every value intersecting the given rectangle and
+     *              counts the touched nodes and values if the tree collects stats.
+     *
+     * @tparam TVisitor The type of visitor, returns false to stop the traversal.
+     * @param key   The rectangle.
+     * @param visitor The visitor.
+     * @param counters The counters of the query.
+     * @return      false if the visitor stopped the traversal, otherwise true.
+     */
+    template <typename TVisitor>
+    bool visitIntersecting(const TBox& key, TVisitor& visitor, QuadTreeCounters& counters) const
+    {
+        if (s_nullIndex == m_root)
+        {
+            return true;
+        }
+        TTraversalStack nodeStack;
+        nodeStack.push(m_root);
+
+        while (!nodeStack.empty())
+        {
+            const Node& currentNode = m_nodes[nodeStack.top()];
+            nodeStack.pop();
+            if constexpr (s_collectStats)
+            {
+                ++counters.nodesVisited;
+            }
+            const auto bounds = boundsOf(currentNode.region());
+            if (!space::util::hasIntersect(key, bounds))
+            {
+                continue;
+            }
+            for (const auto child : currentNode.getChildren())
+            {
+                if (s_nullIndex != child)
+                {
+                    nodeStack.push(child);
+                }
+            }
+            const auto& values = currentNode.getValues();
+            const bool isCovered = space::util::contains(key, bounds);
+            if constexpr (s_hasColumns)
+            {
+                if (!isCovered)
+                {
+                    const auto columnVisitor = [&values, &visitor, &counters](const std::size_t index)
+                    {
+                        if constexpr (s_collectStats)
+                        {
+                            ++counters.valuesMatched;
+                        }
+                        return visitor(values.begin()[static_cast<std::ptrdiff_t>(index)]);
+                    };
+                    if constexpr (s_collectStats)
+                    {
+                        counters.valuesTested += std::size(values);
+                    }
+                    if (!currentNode.getColumns().forEachIntersecting(key, columnVisitor))
+                    {
+                        return false;
+                    }
+                    continue;
+                }
+            }
+            for (const auto& value : values)
+            {
+                if constexpr (s_collectStats)
+                {
+                    counters.valuesTested += isCovered ? 0 : 1;
+                }
+                if (isCovered || space::util::hasIntersect(key, indexableOf(value)))
+                {
+                    if constexpr (s_collectStats)
+                    {
+                        ++counters.valuesMatched;
+                    }
+                    if (!visitor(value))
+                    {
+                        return false;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @internal
+     * @brief       Returns the number of values shifted by inserting or erasing the given value.
+     *
+     * @param values The values of node.
+     * @param value The value.
+     * @return      The number of values after the position of value.
+     */
+    static std::uint64_t shiftCountOf(const typename Node::TValueContainer& values, const TKey& value)
+    {
+        return static_cast<std::uint64_t>(values.end() - values.lower_bound(value));
+    }
+
+    /**
+     * @internal
+     * @brief       Finds values intersecting the queries [first, last) of the given batch.
+     *
+     * @details     The active queries of the visited nodes are kept in one buffer, the frame
+     *              of a node refers to the queries of its parent which intersect the parent
+     *              region. The buffer is truncated when a frame is popped, so it is used
+     *              as a stack.
+     *
+     * @param keys  The rectangles for query.
+     * @param first The index of the first query of the chunk.
+     * @param last  The index after the last query of the chunk.
+     * @param hits  The output for the query indexes with found values.
+     */
+    void queryChunk(space::collections::Span<const TBox> keys, size_type first, size_type last
+                    , space::collections::Vector<TBatchHit>& hits) const
+    {
+        if (s_nullIndex == m_root)
+        {
+            return;
+        }
+        space::collections::Vector<size_type> active(last - first);
+        std::iota(active.begin(), active.end(), first);
+        space::collections::Vector<BatchFrame> frames {{m_root, 0, std::size(active)}};
+
+        while (!frames.empty())
+        {
+            const auto[node, begin, end] = frames.back();
+            frames.pop_back();
+            active.resize(end);
+
+            const Node& currentNode = m_nodes[node];
+            const auto bounds = boundsOf(currentNode.region());
+            for (auto i = begin; i < end; ++i)
+            {
+                if (space::util::hasIntersect(keys[active[i]], bounds))
+                {
+                    active.push_back(active[i]);
+                }
+            }
+            if (std::size(active) == end)
+            {
+                continue;
+            }
+
+            for (const auto child : currentNode.getChildren())
+            {
+                if (s_nullIndex != child)
+                {
+                    frames.push_back({child, end, std::size(active)});
+                }
+            }
+            const auto& values = currentNode.getValues();
+            if constexpr (s_hasColumns)
             {
-                return false;
+                for (auto i = end; i < std::size(active); ++i)
+                {
+                    const auto query = active[i];
+                    currentNode.getColumns().forEachIntersecting(keys[query], [&](const std::size_t index)
+                    {
+                        hits.emplace_back(query, values.begin()[static_cast<std::ptrdiff_t>(index)]);
+                        return true;
+                    });
+                }
             }
-            return std::ranges::all_of(getChildren(), [](const auto& child)
+            else
             {
-                return nullptr == child;
-            });
+                for (const auto& value : values)
+                {
+                    for (auto i = end; i < std::size(active); ++i)
+                    {
+                        if (space::util::hasIntersect(keys[active[i]], indexableOf(value)))
+                        {
+                            hits.emplace_back(active[i], value);
+                        }
+                    }
+                }
+            }
         }
+    }
 
-    private:
-        TRegion m_region;
-        TChildContainer m_child;
-        TValueContainer m_values;
-    };
-
-
-    using TRegion = typename Node::TRegion;
-private:
-
-    using TNodePtr = std::unique_ptr<Node>;
-public:
-
-    using size_type = std::size_t;
-
-    QuadTree()
-        : m_root(nullptr)
-        , m_size(0)
+    /**
+     * @internal
+     * @brief       Returns the squared distance between the shape and the point for ordering.
+     *
+     * @tparam TShape The type of orthogonal shape.
+     * @param shape The shape.
+     * @param point The point.
+     * @return      The squared distance.
+     */
+    template <typename TShape>
+    static double distanceOf(const TShape& shape, const space::Point<TCoordinate>& point) noexcept
     {
+        return space::util::squaredDistance<TShape, TCoordinate, double>(shape, point);
     }
 
     /**
-     * @brief   Inserts a value to the quad tree.
+     * @internal
+     * @brief       Returns the box of the given value.
      *
-     * @param   key The new value.
-     * @return  true if value successfully inserted, otherwise false.
+     * @param value The value.
+     * @return      The box.
      */
-    bool insert(const TKey& key)
+    static decltype(auto) indexableOf(const TKey& value) noexcept
     {
-        if (nullptr == m_root)
-        {
-            creatRoot(key);
-        }
-
-        growUpIfNeeds(key);
-
-        auto* node = growDownIfNeedsAndReturnLastNode(key);
-        if (node->addValue(key))
-        {
-            ++m_size;
-            return true;
-        }
-        return false;
+        return TIndexableTraits::indexableOf(value);
     }
 
     /**
-     * @brief   Finds values intersecting a given rectangle.
+     * @internal
+     * @brief       Creates new root.
      *
-     * @tparam  TOutIt The type of output iterator.
-     * @param   key The rectangle for query.
-     * @param   outIt The output iterator.
+     * @details     The root region is the world region if the tree has it, otherwise
+     *              the new root region contains the given key.
+     *
+     * @param key   The key for computing region.
      */
-    template <typename TOutIt>
-    void query(const TKey& key, TOutIt outIt) const
+    void creatRoot(const TBox& key)
     {
-        space::collections::Stack<const Node*> nodeStack;
-        auto pushNodeIfNotNull = [&nodeStack](const Node* node)
-        {
-            if (nullptr == node)
-            {
-                return;
-            }
-            nodeStack.push(node);
-        };
-        auto popNode = [&nodeStack]()
-        {
-            auto* node = nodeStack.top();
-            nodeStack.pop();
-            return node;
-        };
-        pushNodeIfNotNull(m_root.get());
+        m_root = m_nodes.create(m_worldRegion.value_or(makeRegionFor(key)));
+    }
 
-        while (!nodeStack.empty())
+    /**
+     * @internal
+     * @brief   Grow up the tree if the given key cannot contain in the root.
+     *
+     * @details Creates new root with the doubled size toward the key and sets the old root
+     *          the child for it, in the child slot which is opposite to the growth direction.
+     *
+     * @param   key The rectangle.
+     */
+    void growUpIfNeeds(const TBox& key)
+    {
+        while (!isInside(key, m_nodes[m_root].region()))
         {
-            const Node* currentNode = popNode();
-            if (!space::util::hasIntersect(key, currentNode->region()))
+            const auto[regionForNewRoot, oldRootPos] = grownRegionOf(m_nodes[m_root].region(), key);
+            const auto newRoot = m_nodes.create(regionForNewRoot);
+            m_nodes[newRoot].setChild(oldRootPos, m_root);
+            m_root = newRoot;
+            if constexpr (s_collectStats)
             {
-                continue;
-            }
-            for (auto& child : currentNode->getChildren())
-            {
-                pushNodeIfNotNull(child.get());
-            }
-            for (const auto& value : currentNode->getValues())
-            {
-                if (!space::util::hasIntersect(key, value))
-                {
-                    continue;
-                }
-                outIt = value;
+                m_counters.add({.rootRegrowths = 1});
             }
         }
     }
 
     /**
-     * @brief   Removes given rectangle form quadtree.
+     * @internal
+     * @brief   Returns the region with the doubled size toward the key and the position
+     *          of the given region in it.
      *
-     * @param   key the rectangle.
+     * @param   rootRegion The region of the current root.
+     * @param   key The rectangle.
+     * @return  The region of new root and the child slot of the old root.
      */
-    void remove(const TKey& key)
+    static std::pair<TRegion, ZOrderPos> grownRegionOf(const TRegion& rootRegion, const TBox& key)
     {
-        auto* node = findNode(key);
-        if (nullptr == node)
+        const auto[x, y] = rootRegion.pos();
+        const auto regionSize = rootRegion.size();
+        const auto[keyX, keyY] = space::util::bottomLeftOf(key);
+        const bool growLeft = keyX <= x;
+        const bool growDown = keyY <= y;
+
+        TRegionCoordinate newRegionSize {};
+        if constexpr (std::is_integral_v<TCoordinate>)
         {
-            return;
+            assert(regionSize < (TRegionCoordinate {1} << (s_rangeDigits + 2))
+                   && "The key is out of the range of coordinates.");
+            newRegionSize = regionSize * 2;
         }
-        if ((*node)->eraseValue(key))
+        else
         {
-            --m_size;
+            assert(regionSize < std::ldexp(TRegionCoordinate {1}, static_cast<int>(s_rangeDigits + 2))
+                   && "The key is out of the range of coordinates.");
+            newRegionSize = regionSize * 2;
         }
 
-        // remove node if empty.
-        if ((*node)->empty())
-        {
-            node->reset(nullptr);
-        }
+        const TRegion regionForNewRoot {{growLeft ? x - regionSize : x, growDown ? y - regionSize : y}, newRegionSize};
+        const auto oldRootPos = growLeft
+            ? (growDown ? ZOrderPos::RightTop : ZOrderPos::RightBottom)
+            : (growDown ? ZOrderPos::LeftTop : ZOrderPos::LeftBottom);
+        return {regionForNewRoot, oldRootPos};
     }
 
     /**
-     * @brief   Determines whether the quadtree contains the specified key.
+     * @internal
+     * @brief       Returns the smallest region with power of two size for the given key, not
+     *              smaller than the minimum region size.
      *
-     * @param   key The key to locate in the quadtree.
-     * @return  true if the quadtree contains an element with the specified key; otherwise, false.
+     * @details     The integer region is anchored one unit below the key bottom-left corner, the
+     *              floating point region is anchored on the root grid below it, so the key is
+     *              strictly inside the region (see isInside).
+     *
+     * @param key   The key.
+     * @return      The region.
      */
-    [[nodiscard]]
-    bool contains(const TKey& key) const
+    static TRegion makeRegionFor(const TBox& key)
     {
-        const auto pNode = findNode(key);
-        if (nullptr == pNode)
+        const auto[x, y] = space::util::bottomLeftOf(key);
+        // The region is not smaller than the terminal regions, so the tree grows up from
+        // the splittable root.
+        if constexpr (std::is_integral_v<TCoordinate>)
         {
-            return false;
+            using TUnsigned = std::make_unsigned_t<TRegionCoordinate>;
+            const auto keySize = static_cast<TUnsigned>(std::max(key.width(), key.height()));
+            const auto regionSize = std::max(std::bit_ceil(keySize + 2), static_cast<TUnsigned>(s_minRegionSize));
+            return TRegion {{TRegionCoordinate {x} - 1, TRegionCoordinate {y} - 1}
+                            , static_cast<TRegionCoordinate>(regionSize)};
+        }
+        else
+        {
+            const auto gridBelow = [](TRegionCoordinate coordinate)
+            {
+                const auto gridCoordinate = std::floor(coordinate / s_rootGrid) * s_rootGrid;
+                return (gridCoordinate < coordinate) ? gridCoordinate : gridCoordinate - s_rootGrid;
+            };
+            const space::Point<TRegionCoordinate> pos {gridBelow(x), gridBelow(y)};
+            const auto[x2, y2] = space::util::topRightOf(key);
+            // The power of two sizes are halved exactly down to the smallest regions.
+            auto regionSize = s_rootGrid;
+            while (regionSize < s_minRegionSize || !(x2 < pos.x() + regionSize && y2 < pos.y() + regionSize))
+            {
+                regionSize *= 2;
+            }
+            return TRegion {pos, regionSize};
         }
-        const auto& values = (*pNode)->getValues();
-        return values.end() != values.find(key);
     }
 
     /**
-     * @brief  Checks the container empty or not.
+     * @internal
+     * @brief       Grow down the tree if the associated node for key not exists.
+     *              Returns associated node for the key.
      *
-     * @return true if the container is empty, otherwise false.
+     * @details     The trees with the leaf capacity stop at the first leaf on the key path.
+     *
+     * @param key   The rectangle.
+     * @return      The associated node for the key.
      */
-    [[nodiscard]]
-    bool empty() const noexcept
+    Node& growDownIfNeedsAndReturnLastNode(const TBox& key)
     {
-        return (nullptr == m_root) || m_root->empty();
+        return growDownIfNeedsAndReturnLastNode(key, m_root);
     }
 
     /**
-     * @brief Removes all values stored in the container.
+     * @internal
+     * @brief       Grow down the subtree of the given node if the associated node for key
+     *              not exists. Returns associated node for the key.
+     *
+     * @param key   The rectangle, its path from the root must pass the given node.
+     * @param from  The node to start from.
+     * @return      The associated node for the key.
      */
-    void clear()
+    Node& growDownIfNeedsAndReturnLastNode(const TBox& key, TNodeIndex from)
     {
-        m_root.reset();
+        auto currentNode = from;
+        while (!isTerminal(key, m_nodes[currentNode].region()))
+        {
+            if constexpr (s_isBucketed)
+            {
+                if (m_nodes[currentNode].isLeaf())
+                {
+                    break;
+                }
+            }
+            const auto childPosition = getZOrderPos(m_nodes[currentNode].region(), key);
+            auto child = m_nodes[currentNode].getChild(childPosition);
+            if (s_nullIndex == child)
+            {
+                auto newChildRegion = makeChildRegion(m_nodes[currentNode].region(), childPosition);
+                child = m_nodes.create(newChildRegion);
+                m_nodes[currentNode].setChild(childPosition, child);
+                if constexpr (s_collectStats)
+                {
+                    m_counters.add({.nodesAllocated = 1});
+                }
+            }
+            currentNode = child;
+        }
+
+        return m_nodes[currentNode];
     }
 
     /**
-     * @brief   Get the number of values stored in the index.
+     * @internal
+     * @brief       Splits the leaf if it has more values than the leaf capacity.
      *
-     * @return  The number of values stored in the index.
+     * @details     The leaf with more values than the capacity has only the values which
+     *              cross its split lines (otherwise it would be split), so the values are
+     *              scanned only if the inserted value can move down or the capacity is
+     *              exceeded the first time.
+     *
+     * @param node  The node of the inserted value.
+     * @param inserted The box of the inserted value.
      */
-    [[nodiscard]]
-    size_type size() const noexcept
+    void splitIfNeeds(Node& node, const TBox& inserted)
     {
-        return m_size;
+        const auto valueCount = std::size(node.getValues());
+        if (valueCount <= s_leafCapacity || !node.isLeaf()
+            || (valueCount > s_leafCapacity + 1 && isTerminal(inserted, node.region())))
+        {
+            return;
+        }
+        split(node);
     }
 
-private:
-
     /**
      * @internal
-     * @brief   Returns node for the given key.
+     * @brief       Moves the values which don't cross the split lines of the leaf to the
+     *              children, the children with more values than the leaf capacity are split too.
      *
-     * @param   key The key.
-     * @return  The pointer to node unique_ptr if that exists, otherwise null.
+     * @param node  The leaf.
      */
-    const TNodePtr* findNode(const TKey& key) const
+    void split(Node& node)
     {
-        if (nullptr == m_root)
+        space::collections::Array<space::collections::Vector<TKey>, 4> childValues {};
+        space::collections::Vector<TKey> movedValues;
+        for (const auto& value : node.getValues())
         {
-            return nullptr;
+            const auto& box = indexableOf(value);
+            if (!isTerminal(box, node.region()))
+            {
+                childValues[static_cast<std::size_t>(getZOrderPos(node.region(), box))].push_back(value);
+                movedValues.push_back(value);
+            }
         }
-        auto* currentNode = std::addressof(m_root);
-        while (!hasIntersectionWithRegionSplitLines(key, (*currentNode)->region()))
+        if (movedValues.empty())
         {
-            const auto zOrderPos = getZOrderPos((*currentNode)->region(), key);
-            auto& child = (*currentNode)->getChild(zOrderPos);
-
-            if (nullptr == child)
+            return;
+        }
+        // The values are taken in the sorted order, so they are merged without sorting.
+        node.eraseValues(movedValues.begin(), movedValues.end());
+        for (std::size_t pos = 0; pos < std::size(childValues); ++pos)
+        {
+            const auto& values = childValues[pos];
+            if (values.empty())
+            {
+                continue;
+            }
+            const auto zOrderPos = static_cast<ZOrderPos>(pos);
+            const auto child = m_nodes.create(makeChildRegion(node.region(), zOrderPos));
+            node.setChild(zOrderPos, child);
+            if constexpr (s_collectStats)
+            {
+                m_counters.add({.nodesAllocated = 1});
+            }
+            auto& childNode = m_nodes[child];
+            childNode.mergeValues(values.begin(), values.end());
+            if (std::size(values) > s_leafCapacity)
             {
-                return nullptr;
+                split(childNode);
             }
-            currentNode = std::addressof(child);
         }
-        return currentNode;
     }
 
-    TNodePtr* findNode(const TKey& key)
+    /**
+     * @internal
+     * @brief       Returns the z-order code of the node for the given key.
+     *
+     * @details     The code is the path of ZOrderPos from the root to the node, two bits
+     *              per level starting from the most significant bits, and the depth of
+     *              the node. Sorting by codes gives the pre-order (Z-order) of nodes.
+     *
+     * @param key   The key.
+     * @param region The root region, must contain the key.
+     * @return      The z-order code.
+     */
+    static ZOrderCode zOrderCodeOf(const TBox& key, TRegion region)
     {
-        return const_cast<TNodePtr*>(std::as_const(*this).findNode(key));
+        ZOrderCode code {};
+        auto& [path, depth] = code;
+        while (!isTerminal(key, region))
+        {
+            const auto zOrderPos = getZOrderPos(region, key);
+            const auto shift = 62 - 2 * (depth % 32);
+            path[depth / 32] |= static_cast<std::uint64_t>(zOrderPos) << shift;
+            ++depth;
+            region = makeChildRegion(region, zOrderPos);
+        }
+        return code;
     }
 
     /**
      * @internal
-     * @brief       Creates new root.
+     * @brief       Grow down the tree by the given z-order code, returns the node of the code.
      *
-     * @details     The new root region can contain the given key.
-     * @param key   The key for computing region size.
+     * @details     The nodes of the previous code are reused up to the common prefix of codes,
+     *              so building nodes in the z-order touches every node once.
+     *
+     * @param code  The z-order code.
+     * @param path  The nodes of the previous code, updated to the nodes of the given code.
+     * @return      The node for the code.
      */
-    void creatRoot(const TKey& key)
+    Node& growDownByCode(const ZOrderCode& code, ZOrderPath& path)
     {
-        const auto[x, y] = space::util::topRightOf(key);
-        auto regionSize = static_cast<int32_t>(std::pow(2, static_cast<int32_t>(std::log2(std::max(x, y))) + 1));
-        if (0 == regionSize)
+        auto& nodes = path.nodes;
+        auto& depth = path.depth;
+        const auto commonDepth = std::min(commonPrefixDepth(code.path, path.code), std::size_t {depth});
+        depth = static_cast<std::uint32_t>(std::min(commonDepth, std::size_t {code.depth}));
+        path.code = code.path;
+        while (depth < code.depth)
         {
-            regionSize = 1;
+            const auto childPosition = zOrderPosOf(code, depth);
+            const auto currentNode = nodes[depth];
+            auto child = m_nodes[currentNode].getChild(childPosition);
+            if (s_nullIndex == child)
+            {
+                child = m_nodes.create(makeChildRegion(m_nodes[currentNode].region(), childPosition));
+                m_nodes[currentNode].setChild(childPosition, child);
+                if constexpr (s_collectStats)
+                {
+                    m_counters.add({.nodesAllocated = 1});
+                }
+            }
+            nodes[++depth] = child;
         }
+        return m_nodes[nodes[depth]];
+    }
 
-        TRegion regionForNewNode {{0, 0}, regionSize};
-        m_root = std::make_unique<Node>(regionForNewNode);
+    /**
+     * @internal
+     * @brief       Returns the z-order position of the given level of the code.
+     *
+     * @param code  The z-order code.
+     * @param level The level, less than the code depth.
+     * @return      The z-order position of child at the level.
+     */
+    static ZOrderPos zOrderPosOf(const ZOrderCode& code, std::size_t level) noexcept
+    {
+        const auto shift = 62 - 2 * (level % 32);
+        return static_cast<ZOrderPos>((code.path[level / 32] >> shift) & 3);
     }
 
     /**
      * @internal
-     * @brief   Grow up the tree if the given key cannot contain in the root.
+     * @brief       Finds the node of the given z-order code, doesn't create nodes.
      *
-     * @details Creates new root and set old root the child for it.
+     * @details     The nodes of the previous code are reused up to the common prefix of codes,
+     *              as in growDownByCode.
      *
-     * @param   key The rectangle.
+     * @param code  The z-order code.
+     * @param path  The nodes of the previous code, updated to the existing nodes of the given code.
+     * @return      The node index if that exists, otherwise s_nullIndex.
      */
-    void growUpIfNeeds(const TKey& key)
+    TNodeIndex findByCode(const ZOrderCode& code, ZOrderPath& path) const
     {
-        while (!space::util::contains(m_root->region(), key))
+        auto& nodes = path.nodes;
+        auto& depth = path.depth;
+        const auto commonDepth = std::min(commonPrefixDepth(code.path, path.code), std::size_t {depth});
+        depth = static_cast<std::uint32_t>(std::min(commonDepth, std::size_t {code.depth}));
+        path.code = code.path;
+        while (depth < code.depth)
         {
-            const auto regionSize = m_root->region().size() << 1;
-            TRegion regionSizeForNewRoot {{0, 0}, regionSize};
-            auto newRoot = std::make_unique<Node>(regionSizeForNewRoot);
-            newRoot->setChild(ZOrderPos::LeftBottom, std::move(m_root));
-            m_root = std::move(newRoot);
+            const auto child = m_nodes[nodes[depth]].getChildren()[static_cast<std::size_t>(zOrderPosOf(code, depth))];
+            if (s_nullIndex == child)
+            {
+                return s_nullIndex;
+            }
+            nodes[++depth] = child;
         }
+        return nodes[depth];
     }
 
     /**
      * @internal
-     * @brief       Grow down the tree if the associated node for key not exists.
-     *              Returns associated node for the key.
+     * @brief       Returns the number of common levels for the given z-order paths.
      *
-     * @param key   The rectangle.
-     * @return      The associated node pointer for the key.
+     * @param first The first path.
+     * @param second The second path.
+     * @return      The number of common levels.
      */
-    Node* growDownIfNeedsAndReturnLastNode(const TKey& key)
+    static std::size_t commonPrefixDepth(const TZOrderBits& first, const TZOrderBits& second) noexcept
     {
-        auto* currentNode = m_root.get();
-        while (!(hasIntersectionWithRegionSplitLines(key, currentNode->region())
-                 || 1 == currentNode->region().size()))
+        std::size_t depth = 0;
+        for (std::size_t i = 0; i < std::size(first); ++i)
         {
-            const auto childPosition = getZOrderPos(currentNode->region(), key);
-            auto& child = currentNode->getChild(childPosition);
-            if (nullptr == child)
+            const auto diff = first[i] ^ second[i];
+            if (0 != diff)
             {
-                auto newChildRegion = makeChildRegion(currentNode->region(), childPosition);
-                child = std::make_unique<Node>(newChildRegion);
+                return depth + static_cast<std::size_t>(std::countl_zero(diff)) / 2;
             }
-            currentNode = child.get();
+            depth += 32;
         }
+        return depth;
+    }
 
-        return currentNode;
+    /**
+     * @internal
+     * @brief       Returns the boundary box of the given keys.
+     *
+     * @param keys  The coded keys, must not be empty.
+     * @return      The smallest key which contains all given keys.
+     */
+    static TBox boundaryBoxOf(std::span<const TCodedKey> keys)
+    {
+        auto[minX, minY] = space::util::bottomLeftOf(indexableOf(keys.front().second));
+        auto[maxX, maxY] = space::util::topRightOf(indexableOf(keys.front().second));
+        for (const auto& [code, key] : keys)
+        {
+            const auto[x1, y1] = space::util::bottomLeftOf(indexableOf(key));
+            const auto[x2, y2] = space::util::topRightOf(indexableOf(key));
+            minX = std::min(minX, x1);
+            minY = std::min(minY, y1);
+            maxX = std::max(maxX, x2);
+            maxY = std::max(maxY, y2);
+        }
+        return TBox {{minX, minY}, {maxX, maxY}};
     }
 
 
@@ -427,7 +2511,7 @@ private:
      * @param region    The region.
      * @return          true if has intersection, otherwise false.
      */
-    static bool hasIntersectionWithRegionSplitLines(const TKey& rect, const TRegion& region)
+    static bool hasIntersectionWithRegionSplitLines(const TBox& rect, const TRegion& region)
     {
         const auto middleX = getRectMiddleX(region);
         const auto middleY = getRectMiddleY(region);
@@ -435,6 +2519,138 @@ private:
                || ((rect.pos().y() <= middleY) && (middleY <= rect.pos().y() + rect.height()));
     }
 
+    /**
+     * @internal
+     * @brief           Checks the split lines of the given region are exact.
+     *
+     * @details         The floating point regions far from the origin are not split below the
+     *                  precision of their coordinates, the rounded split lines would not match
+     *                  the child regions. The integer split lines are always exact.
+     *
+     * @param region    The region.
+     * @return          true if the middle coordinates are exact, otherwise false.
+     */
+    static bool hasExactSplitLines(const TRegion& region) noexcept
+    {
+        if constexpr (std::is_integral_v<TCoordinate>)
+        {
+            return true;
+        }
+        else
+        {
+            // The rounding error of the sum (Knuth's TwoSum).
+            const auto roundingErrorOf = [](TRegionCoordinate a, TRegionCoordinate b)
+            {
+                const auto sum = a + b;
+                const auto bVirtual = sum - a;
+                const auto aVirtual = sum - bVirtual;
+                return (a - aVirtual) + (b - bVirtual);
+            };
+            const auto halfSize = region.size() / 2;
+            return TRegionCoordinate {0} == roundingErrorOf(region.pos().x(), halfSize)
+                   && TRegionCoordinate {0} == roundingErrorOf(region.pos().y(), halfSize);
+        }
+    }
+
+    /**
+     * @internal
+     * @brief           Checks the given rectangle must be stored in the node with the given region.
+     *
+     * @details         The rectangle stays in the node if it has an intersection with the region
+     *                  split lines or the region cannot be split anymore (the region size is
+     *                  not bigger than the minimum region size of policy or its split lines
+     *                  are not exact).
+     *
+     * @param rect      The rectangle.
+     * @param region    The region.
+     * @return          true if the rectangle belongs to the region node, otherwise false.
+     */
+    static bool isTerminal(const TBox& rect, const TRegion& region)
+    {
+        if (region.size() <= s_minRegionSize || !hasExactSplitLines(region))
+        {
+            return true;
+        }
+        if constexpr (s_isLoose)
+        {
+            const auto childBounds = boundsOf(makeChildRegion(region, getZOrderPos(region, rect)));
+            return !space::util::contains(childBounds, rect);
+        }
+        else
+        {
+            return hasIntersectionWithRegionSplitLines(rect, region);
+        }
+    }
+
+    /**
+     * @internal
+     * @brief           Returns the bounds of node with the given region.
+     *
+     * @details         The bounds of the loose tree node are enlarged by the looseness factor
+     *                  around the region center, all values of the node are inside its bounds.
+     *
+     * @param region    The node region.
+     * @return          The node bounds.
+     */
+    static TRegion boundsOf(const TRegion& region) noexcept
+    {
+        if constexpr (s_isLoose)
+        {
+            using TCoordinate = typename TRegion::TCoordinate;
+            const auto expansion = static_cast<TCoordinate>(region.size() * (TLooseness::num - TLooseness::den)
+                                                            / (2 * TLooseness::den));
+            return TRegion {{region.pos().x() - expansion, region.pos().y() - expansion}
+                            , static_cast<TCoordinate>(region.size() + 2 * expansion)};
+        }
+        else
+        {
+            return region;
+        }
+    }
+
+    /**
+     * @internal
+     * @brief           Checks the given rectangle is strictly inside the region.
+     *
+     * @details         The rectangle stored in a node never touches the node region boundary,
+     *                  so when the old root becomes a child of the new root in any direction,
+     *                  the values of the old root don't touch the new split lines.
+     *
+     * @param rect      The rectangle.
+     * @param region    The region.
+     * @return          true if the rectangle is strictly inside the region, otherwise false.
+     */
+    static bool isInside(const TBox& rect, const TRegion& region)
+    {
+        const auto[x1, y1] = space::util::bottomLeftOf(rect);
+        const auto[x2, y2] = space::util::topRightOf(rect);
+        const auto[regionX1, regionY1] = space::util::bottomLeftOf(region);
+        const auto[regionX2, regionY2] = space::util::topRightOf(region);
+        return regionX1 < x1 && x2 < regionX2 && regionY1 < y1 && y2 < regionY2;
+    }
+
+    /**
+     * @internal
+     * @brief           Returns the point of the key which selects the child.
+     *
+     * @details         The bottom-left corner for the tight tree, the keys crossing no split
+     *                  lines are entirely on one side of them. The center for the loose tree.
+     *
+     * @param key       The key.
+     * @return          The point.
+     */
+    static auto positionOf(const TBox& key) noexcept
+    {
+        if constexpr (s_isLoose)
+        {
+            return space::Point<TCoordinate> {static_cast<TCoordinate>(key.pos().x() + key.width() / 2)
+                                              , static_cast<TCoordinate>(key.pos().y() + key.height() / 2)};
+        }
+        else
+        {
+            return key.pos();
+        }
+    }
 
     /**
      * @internal
@@ -444,11 +2660,11 @@ private:
      * @param key       The key.
      * @return          The z-order position.
      */
-    static ZOrderPos getZOrderPos(const TRegion& region, const TKey& key)
+    static ZOrderPos getZOrderPos(const TRegion& region, const TBox& key)
     {
         const auto middleX = getRectMiddleX(region);
         const auto middleY = getRectMiddleY(region);
-        const auto[x, y] = key.pos();
+        const auto[x, y] = positionOf(key);
         if (x < middleX)
         {
             if (y > middleY)
@@ -477,7 +2693,7 @@ private:
     {
         const auto middleX = getRectMiddleX(region);
         const auto middleY = getRectMiddleY(region);
-        const auto size = static_cast<typename TRegion::TCoordinate>(std::round(region.size() / 2.0));
+        const auto size = region.size() / 2;
 
         switch (zOrderPos)
         {
@@ -497,11 +2713,31 @@ private:
 private:
 
     /**
-     * @brief The root for quadtree.
+     * @brief The storage for all nodes of quadtree.
      */
-    TNodePtr m_root;
+    TNodePool m_nodes;
+
+    /**
+     * @brief The index of the root for quadtree.
+     */
+    TNodeIndex m_root;
 
     size_type m_size;
+
+    /**
+     * @brief The version of the stored values, see version.
+     */
+    std::uint64_t m_version;
+
+    /**
+     * @brief The root region given by the world extent.
+     */
+    std::optional<TRegion> m_worldRegion;
+
+    /**
+     * @brief The operation counters, updated by the const queries too.
+     */
+    [[no_unique_address]] mutable TCounters m_counters;
 };
 
 } // namespace space
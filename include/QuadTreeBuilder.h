@@ -0,0 +1,359 @@
+/**
+ * @file        QuadTreeBuilder.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaring the QuadTreeBuilder class.
+ * @date        14-10-2026
+ * @copyright   Copyright (c) 2026
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <execution>
+#include <iterator>
+#include <thread>
+#include <utility>
+
+#include "BoundedQueue.h"
+#include "Definitions.h"
+#include "QuadTree.h"
+
+namespace space
+{
+
+/**
+ * @brief   The streaming builder of quadtree, the keys are pushed in chunks by the producer
+ *          threads and loaded to the tree by the builder thread.
+ *
+ * @details The chunks go through the bounded lock-free queue, the builder thread collects
+ *          them into batches and loads every batch with the parallel QuadTree::bulkLoad (the
+ *          keys are coded and sorted by the z-order, then merged into the nodes). So parsing
+ *          of the input stream is overlapped with indexing instead of being added to it. The
+ *          producers wait only while the queue is full.
+ *          The tree is owned by the builder thread until flush or finalize, after flush it
+ *          can be read by the tree function until the next push.
+ *
+ * @tparam  TKey The type of keys.
+ * @tparam  TPolicy The policy of the tree.
+ */
+template <typename TKey, typename TPolicy = DefaultQuadTreePolicy>
+class QuadTreeBuilder
+{
+public:
+    using TTree = QuadTree<TKey, TPolicy>;
+    using TChunk = space::collections::Vector<TKey>;
+    using size_type = std::size_t;
+
+    /**
+     * @brief   The default number of keys loaded together.
+     */
+    static constexpr size_type s_defaultBatchSize = size_type {1} << 16;
+
+    /**
+     * @brief   The default number of chunks waiting in the queue.
+     */
+    static constexpr size_type s_defaultQueueCapacity = 64;
+
+    /**
+     * @brief   Initializes the builder of the given tree and starts the builder thread.
+     *
+     * @param   tree The tree to add the keys, empty by default.
+     * @param   batchSize The number of keys to load together, the smaller batches are loaded
+     *          only by flush and finalize.
+     * @param   queueCapacity The number of chunks waiting in the queue.
+     */
+    explicit QuadTreeBuilder(TTree tree = TTree {}, size_type batchSize = s_defaultBatchSize
+                             , size_type queueCapacity = s_defaultQueueCapacity)
+        : m_tree {std::move(tree)}
+        , m_batchSize {std::max(batchSize, size_type {1})}
+        , m_queue {queueCapacity}
+        , m_thread {[this]()
+                    {
+                        run();
+                    }}
+    {
+    }
+
+    QuadTreeBuilder(const QuadTreeBuilder&) = delete;
+
+    QuadTreeBuilder& operator=(const QuadTreeBuilder&) = delete;
+
+    /**
+     * @brief   Loads the pushed chunks and stops the builder thread.
+     */
+    ~QuadTreeBuilder()
+    {
+        stop();
+    }
+
+    /**
+     * @brief   Pushes the chunk of keys, waits while the queue is full.
+     *
+     * @details Can be called concurrently by many producers, but not after finalize.
+     *
+     * @param   chunk The keys.
+     */
+    void push(TChunk&& chunk)
+    {
+        assert(!m_isStopping.load() && "The builder is finalized.");
+        if (chunk.empty())
+        {
+            return;
+        }
+        while (!m_queue.tryPush(chunk))
+        {
+            // The consumer signals every pop, so the wait ends when a cell is free.
+            const auto poppedCount = m_poppedCount.load(std::memory_order_acquire);
+            if (m_queue.tryPush(chunk))
+            {
+                break;
+            }
+            m_poppedCount.wait(poppedCount, std::memory_order_acquire);
+        }
+        m_pushedCount.fetch_add(1, std::memory_order_release);
+        signal();
+    }
+
+    /**
+     * @brief   Pushes the copy of the given keys, waits while the queue is full.
+     *
+     * @param   keys The keys.
+     */
+    void push(space::collections::Span<const TKey> keys)
+    {
+        push(TChunk(keys.begin(), keys.end()));
+    }
+
+    /**
+     * @brief   Waits until all chunks pushed before the call are loaded to the tree, including
+     *          the batch which is not full.
+     *
+     * @throw   The exception of the failed load, the keys of the failed batch are lost.
+     */
+    void flush()
+    {
+        const auto target = m_pushedCount.load(std::memory_order_acquire);
+        for (auto flushTarget = m_flushTarget.load(); flushTarget < target
+             && !m_flushTarget.compare_exchange_weak(flushTarget, target);)
+        {
+        }
+        signal();
+        for (auto loadedCount = m_loadedCount.load(std::memory_order_acquire); loadedCount < target
+             ; loadedCount = m_loadedCount.load(std::memory_order_acquire))
+        {
+            m_loadedCount.wait(loadedCount, std::memory_order_acquire);
+        }
+        rethrowIfFailed();
+    }
+
+    /**
+     * @brief   Loads all pushed chunks, stops the builder thread and returns the tree.
+     *
+     * @details The producers must be done before the call, the builder accepts no pushes after it.
+     *
+     * @return  The tree.
+     * @throw   The exception of the failed load, the keys of the failed batch are lost.
+     */
+    TTree finalize()
+    {
+        stop();
+        rethrowIfFailed();
+        return std::move(m_tree);
+    }
+
+    /**
+     * @brief   Gets the tree, valid after flush until the next push.
+     *
+     * @return  The tree.
+     */
+    [[nodiscard]]
+    const TTree& tree() const noexcept
+    {
+        return m_tree;
+    }
+
+    /**
+     * @brief   Gets the number of the loaded keys, the duplicates are not counted.
+     *
+     * @return  The number of keys.
+     */
+    [[nodiscard]]
+    size_type size() const noexcept
+    {
+        return m_size.load(std::memory_order_acquire);
+    }
+
+private:
+    /**
+     * @internal
+     * @brief   The loop of the builder thread.
+     *
+     * @details The thread pops the chunks while the queue is not empty and loads the full
+     *          batches. The batch which is not full waits for more chunks unless there is a
+     *          flush or stop. The thread sleeps on the event counter when there is nothing to do.
+     */
+    void run()
+    {
+        TChunk batch;
+        size_type batchChunkCount = 0;
+        for (;;)
+        {
+            const auto events = m_events.load(std::memory_order_acquire);
+            const bool isStopping = m_isStopping.load(std::memory_order_acquire);
+            bool hasWork = false;
+            while (auto chunk = m_queue.tryPop())
+            {
+                m_poppedCount.fetch_add(1, std::memory_order_release);
+                m_poppedCount.notify_all();
+                batch.insert(batch.end(), std::make_move_iterator(chunk->begin()), std::make_move_iterator(chunk->end()));
+                ++batchChunkCount;
+                hasWork = true;
+                if (std::size(batch) >= m_batchSize)
+                {
+                    load(batch, batchChunkCount);
+                }
+            }
+            const auto loadedCount = m_loadedCount.load(std::memory_order_relaxed);
+            if (0 != batchChunkCount && (isStopping || loadedCount < m_flushTarget.load(std::memory_order_acquire)))
+            {
+                load(batch, batchChunkCount);
+                hasWork = true;
+            }
+            if (isStopping && 0 == batchChunkCount && !hasWork)
+            {
+                return;
+            }
+            if (!hasWork)
+            {
+                m_events.wait(events, std::memory_order_acquire);
+            }
+        }
+    }
+
+    /**
+     * @internal
+     * @brief   Loads the batch to the tree and publishes the number of the loaded chunks.
+     *
+     * @param   batch The keys, cleared after the load.
+     * @param   chunkCount The number of chunks of the batch, reset after the load.
+     */
+    void load(TChunk& batch, size_type& chunkCount)
+    {
+        if (nullptr == m_error)
+        {
+            try
+            {
+                m_size.fetch_add(m_tree.bulkLoad(std::execution::par, batch), std::memory_order_release);
+            }
+            catch (...)
+            {
+                m_error = std::current_exception();
+                m_hasFailed.store(true, std::memory_order_release);
+            }
+        }
+        batch.clear();
+        m_loadedCount.fetch_add(std::exchange(chunkCount, 0), std::memory_order_release);
+        m_loadedCount.notify_all();
+    }
+
+    /**
+     * @internal
+     * @brief   Wakes up the builder thread.
+     */
+    void signal() noexcept
+    {
+        m_events.fetch_add(1, std::memory_order_release);
+        m_events.notify_one();
+    }
+
+    /**
+     * @internal
+     * @brief   Stops the builder thread after it loads all pushed chunks.
+     */
+    void stop()
+    {
+        if (m_thread.joinable())
+        {
+            m_isStopping.store(true, std::memory_order_release);
+            signal();
+            m_thread.join();
+        }
+    }
+
+    /**
+     * @internal
+     * @brief   Rethrows the exception of the failed load.
+     */
+    void rethrowIfFailed() const
+    {
+        if (m_hasFailed.load(std::memory_order_acquire))
+        {
+            std::rethrow_exception(m_error);
+        }
+    }
+
+private:
+    /**
+     * @brief   The built tree, accessed only by the builder thread until flush or finalize.
+     */
+    TTree m_tree;
+
+    /**
+     * @brief   The number of keys to load together.
+     */
+    size_type m_batchSize;
+
+    /**
+     * @brief   The queue of the pushed chunks.
+     */
+    space::collections::BoundedQueue<TChunk> m_queue;
+
+    /**
+     * @brief   The counters of the pushed, popped and loaded chunks.
+     */
+    std::atomic<size_type> m_pushedCount {0};
+    std::atomic<size_type> m_poppedCount {0};
+    std::atomic<size_type> m_loadedCount {0};
+
+    /**
+     * @brief   The number of chunks requested by flush, the smaller batch is loaded until it.
+     */
+    std::atomic<size_type> m_flushTarget {0};
+
+    /**
+     * @brief   The number of loaded keys.
+     */
+    std::atomic<size_type> m_size {0};
+
+    /**
+     * @brief   The counter of events for the builder thread (pushes, flushes, the stop).
+     */
+    std::atomic<std::uint32_t> m_events {0};
+
+    /**
+     * @brief   true if the builder thread must stop after loading all chunks.
+     */
+    std::atomic<bool> m_isStopping {false};
+
+    /**
+     * @brief   The exception of the first failed load, written once by the builder thread.
+     */
+    std::exception_ptr m_error {};
+
+    /**
+     * @brief   true if the exception is written, the batches after the failure are skipped.
+     */
+    std::atomic<bool> m_hasFailed {false};
+
+    /**
+     * @brief   The builder thread, the last member so it starts after the others are initialized.
+     */
+    std::thread m_thread;
+}; // class QuadTreeBuilder
+
+} // namespace space
@@ -0,0 +1,118 @@
+/**
+ * @file        QuadTreePolicy.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaring the policies for the QuadTree class.
+ * @date        14-10-2026
+ * @copyright   Copyright (c) 2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <ratio>
+
+namespace space
+{
+
+/**
+ * @brief   The default policy of quadtree.
+ *
+ * @details The custom policies can derive from this one and override only the needed options.
+ *          Looseness The factor for node bounds relative to the node region, the std::ratio
+ *              not less than 1. With the factor 1 the tree is tight, the key stays in the
+ *              deepest node which split lines it doesn't cross. With the bigger factor the
+ *              node bounds are enlarged, the key goes to the child which contains its center
+ *              if the child bounds contain the key, so the keys crossing split lines sink
+ *              down to the nodes of their size instead of piling up in the upper nodes.
+ *          ColumnarValues If true, the node values are mirrored to the box columns (the
+ *              structure of arrays of corners), the intersection tests of queries are
+ *              vectorised. The FlatSet of values stays the index for contains and remove.
+ *          CollectStats If true, the tree counts the nodes and values touched by the
+ *              operations, see QuadTree::stats. If false, the counters are not compiled in.
+ *          LeafCapacity If not zero, the node is split only when it has more values than
+ *              the capacity, the keys stay in the leaves until that. So the dense keys (e.g.
+ *              points) don't travel down to the smallest regions, the depth is traded against
+ *              the number of values scanned in the leaves. If zero, the key goes down until it
+ *              crosses the split lines. Used by QuadTree and ShardedQuadTree, the trees built
+ *              from the codes of keys (LinearQuadTree, ConcurrentQuadTree) ignore it.
+ *          MaxDepth The maximum depth of nodes, counted from the region of the whole range of
+ *              coordinate type (2^digits, the region size halves per level). The nodes at the
+ *              maximum depth are not split, the keys stay there. The range of floating point
+ *              coordinates is the range of the signed integer of the same size (2^31 for float,
+ *              2^63 for double).
+ *          MinRegionSize The size of the smallest regions, the std::ratio greater than 0. The
+ *              nodes of these regions are not split, like the nodes at the maximum depth. The
+ *              resolution of the tree for the floating point coordinates (e.g. std::ratio<1, 100>
+ *              for centimeters in the coordinates of meters), rounded up to the unit for the
+ *              integer coordinates.
+ */
+struct DefaultQuadTreePolicy
+{
+    using Looseness = std::ratio<1>;
+    static constexpr bool ColumnarValues = false;
+    static constexpr bool CollectStats = false;
+    static constexpr std::size_t LeafCapacity = 0;
+    static constexpr std::size_t MaxDepth = std::numeric_limits<std::size_t>::max();
+    using MinRegionSize = std::ratio<1>;
+};
+
+/**
+ * @brief   The policy of loose quadtree, the node bounds are twice bigger than the node region.
+ *
+ * @details Every key is stored at the depth defined by its size, so the number of keys in one
+ *          node is bounded by the density of keys instead of the number of keys crossing
+ *          the split lines.
+ */
+struct LooseQuadTreePolicy : DefaultQuadTreePolicy
+{
+    using Looseness = std::ratio<2>;
+};
+
+/**
+ * @brief   The policy of quadtree with the values mirrored to the box columns.
+ *
+ * @details Pays the memory for the second copy of corners and slower updates for the
+ *          vectorised intersection tests, useful for the nodes with many values.
+ */
+struct ColumnarQuadTreePolicy : DefaultQuadTreePolicy
+{
+    static constexpr bool ColumnarValues = true;
+};
+
+/**
+ * @brief   The policy of quadtree with the operation counters, for profiling.
+ */
+struct StatsQuadTreePolicy : DefaultQuadTreePolicy
+{
+    static constexpr bool CollectStats = true;
+};
+
+/**
+ * @brief   The policy of quadtree with the leaf capacity and the maximum depth.
+ *
+ * @tparam  Capacity The number of values of the leaf to split it, zero to split by the split lines.
+ * @tparam  Depth The maximum depth of nodes, see DefaultQuadTreePolicy.
+ * @tparam  TBase The policy for the other options.
+ */
+template <std::size_t Capacity, std::size_t Depth = DefaultQuadTreePolicy::MaxDepth
+          , typename TBase = DefaultQuadTreePolicy>
+struct BucketQuadTreePolicy : TBase
+{
+    static constexpr std::size_t LeafCapacity = Capacity;
+    static constexpr std::size_t MaxDepth = Depth;
+};
+
+/**
+ * @brief   The policy of quadtree with the given resolution, for the floating point coordinates.
+ *
+ * @tparam  TMinRegionSize The size of the smallest regions, the std::ratio.
+ * @tparam  TBase The policy for the other options.
+ */
+template <typename TMinRegionSize, typename TBase = DefaultQuadTreePolicy>
+struct ResolutionQuadTreePolicy : TBase
+{
+    using MinRegionSize = TMinRegionSize;
+};
+
+} // namespace space
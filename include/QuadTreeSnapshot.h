@@ -0,0 +1,573 @@
+/**
+ * @file        QuadTreeSnapshot.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaring the on-disk snapshot of QuadTree and the MappedQuadTree class.
+ *
+ * @details     The snapshot is written on every platform, MappedQuadTree maps it with POSIX mmap
+ *              and is declared only if SPACE_HAS_MMAP is defined.
+ * @date        14-10-2026
+ * @copyright   Copyright (c) 2026
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#if __has_include(<sys/mman.h>) && __has_include(<unistd.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SPACE_HAS_MMAP 1
+#endif
+
+#include "Definitions.h"
+#include "Indexable.h"
+#include "InlineStack.h"
+#include "Square.h"
+#include "Utility.h"
+
+namespace space
+{
+
+template <typename TKey, typename TPolicy>
+class QuadTree;
+
+/**
+ * @brief   The header of the quadtree snapshot file.
+ *
+ * @details The snapshot is the native-endian image of the tree: the header, the array of nodes
+ *          in the breadth-first order and the array of values, the values of one node are
+ *          stored contiguously. The nodes and values are linked by indexes, so the file is
+ *          position independent and is used in place after mmap. The sizes of the layout types
+ *          are stored to reject the files written for other types or platforms.
+ */
+struct QuadTreeSnapshotHeader
+{
+    /**
+     * @brief   The file signature.
+     */
+    static constexpr std::uint64_t s_magic = 0x5041'4e53'4545'5254; // "TREESNAP"
+
+    /**
+     * @brief   The version of layout, incremented on every incompatible change.
+     */
+    static constexpr std::uint32_t s_version = 2;
+
+    std::uint64_t magic;
+    std::uint32_t version;
+    std::uint32_t nodeSize;
+    std::uint32_t valueSize;
+    std::uint32_t coordinateSize;
+    std::uint64_t nodeCount;
+    std::uint64_t valueCount;
+    std::uint64_t nodeOffset;
+    std::uint64_t valueOffset;
+    std::uint64_t fileSize;
+};
+
+/**
+ * @brief   The node of the quadtree snapshot.
+ *
+ * @details The children of a node are contiguous in the breadth-first order, so the node keeps
+ *          only the first child index and the number of children.
+ *
+ * @tparam  TCrt The type of coordinates.
+ */
+template <typename TCrt>
+struct QuadTreeSnapshotNode
+{
+    /**
+     * @brief   The node bounds, all values of the node are inside of them.
+     */
+    space::Square<TCrt> bounds;
+    std::uint32_t firstChild;
+    std::uint32_t childCount;
+    std::uint64_t valueBegin;
+    std::uint64_t valueEnd;
+};
+
+namespace impl
+{
+
+/**
+ * @internal
+ * @brief       Rounds the offset up to the given alignment.
+ *
+ * @param offset The offset.
+ * @param alignment The alignment, must be a power of two.
+ * @return      The aligned offset.
+ */
+[[nodiscard]]
+constexpr std::uint64_t alignedOffset(std::uint64_t offset, std::uint64_t alignment) noexcept
+{
+    return (offset + alignment - 1) & ~(alignment - 1);
+}
+
+/**
+ * @internal
+ * @brief       Writes the quadtree snapshot file.
+ *
+ * @throws      std::runtime_error if the file can't be written.
+ *
+ * @tparam TKey The type of values, must be trivially copyable.
+ * @tparam TNode The type of nodes.
+ * @param path  The path of file.
+ * @param nodes The nodes in the breadth-first order.
+ * @param values The values of nodes.
+ */
+template <typename TKey, typename TNode>
+void writeQuadTreeSnapshot(const std::filesystem::path& path
+                           , space::collections::Span<const TNode> nodes
+                           , space::collections::Span<const TKey> values)
+{
+    using TCoordinate = typename space::IndexableTraits<TKey>::TBox::TCoordinate;
+    static_assert(std::is_trivially_copyable_v<TKey>, "The snapshot values must be trivially copyable.");
+
+    QuadTreeSnapshotHeader header {};
+    header.magic = QuadTreeSnapshotHeader::s_magic;
+    header.version = QuadTreeSnapshotHeader::s_version;
+    header.nodeSize = sizeof(TNode);
+    header.valueSize = sizeof(TKey);
+    header.coordinateSize = sizeof(TCoordinate);
+    header.nodeCount = std::size(nodes);
+    header.valueCount = std::size(values);
+    header.nodeOffset = alignedOffset(sizeof(QuadTreeSnapshotHeader), alignof(TNode));
+    header.valueOffset = alignedOffset(header.nodeOffset + std::size(nodes) * sizeof(TNode), alignof(TKey));
+    header.fileSize = header.valueOffset + std::size(values) * sizeof(TKey);
+
+    std::ofstream file {path, std::ios::binary | std::ios::trunc};
+    auto writePadding = [&file](std::uint64_t from, std::uint64_t to)
+    {
+        for (; from < to; ++from)
+        {
+            file.put('\0');
+        }
+    };
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    writePadding(sizeof(header), header.nodeOffset);
+    file.write(reinterpret_cast<const char*>(nodes.data()), static_cast<std::streamsize>(nodes.size_bytes()));
+    writePadding(header.nodeOffset + nodes.size_bytes(), header.valueOffset);
+    file.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size_bytes()));
+    file.close();
+    if (!file)
+    {
+        throw std::runtime_error {"Failed to write the quadtree snapshot " + path.string() + "."};
+    }
+}
+
+} // namespace impl
+
+#ifdef SPACE_HAS_MMAP
+
+/**
+ * @class   MappedQuadTree
+ * @brief   The read-only quadtree for the memory-mapped snapshot, see QuadTree::save.
+ *
+ * @details The file is mapped read-only and the queries run directly on the mapped pages,
+ *          so opening costs only the validation of node links, nothing is parsed or copied.
+ *          The processes mapping one snapshot share its pages through the page cache.
+ *          The snapshot is native-endian, it is not portable between platforms with
+ *          different byte order or layout of the value type.
+ *
+ * @tparam  TKey The type of values, must be trivially copyable.
+ * @tparam  TPolicy The policy of the saved tree, it bounds the depth of the snapshot.
+ */
+template <typename TKey, typename TPolicy>
+class MappedQuadTree
+{
+    static_assert(std::is_trivially_copyable_v<TKey>, "The snapshot values must be trivially copyable.");
+
+    using TIndexableTraits = space::IndexableTraits<TKey>;
+
+    /**
+     * @brief   The snapshot is written by the tree of the same keys and policy.
+     */
+    using TLayout = QuadTree<TKey, TPolicy>;
+
+public:
+    /**
+     * @brief   The type of value box, the queries are done by boxes.
+     */
+    using TBox = typename TIndexableTraits::TBox;
+    using TCoordinate = typename TBox::TCoordinate;
+    using size_type = std::size_t;
+
+    /**
+     * @brief   The type of snapshot nodes.
+     */
+    using TNode = QuadTreeSnapshotNode<typename TLayout::TRegionCoordinate>;
+
+    /**
+     * @brief   The maximum depth of the tree, the same as for QuadTree of the policy.
+     */
+    static constexpr std::size_t s_maxDepth = TLayout::s_maxDepth;
+
+private:
+    /**
+     * @brief   The stack for the depth-first traversal, a node keeps up to 3 siblings on it.
+     */
+    using TTraversalStack = space::collections::InlineStack<std::uint32_t, 3 * s_maxDepth + 4>;
+
+public:
+
+    MappedQuadTree() = delete;
+
+    /**
+     * @brief   Maps the given snapshot file.
+     *
+     * @throws  std::system_error if the file can't be opened or mapped.
+     * @throws  std::runtime_error if the file is not the valid snapshot for TKey.
+     *
+     * @param   path The path of snapshot.
+     */
+    explicit MappedQuadTree(const std::filesystem::path& path)
+    {
+        const int descriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (descriptor < 0)
+        {
+            throw std::system_error {errno, std::generic_category(), "Failed to open " + path.string()};
+        }
+        struct ::stat status {};
+        if (::fstat(descriptor, &status) < 0)
+        {
+            const auto error = errno;
+            ::close(descriptor);
+            throw std::system_error {error, std::generic_category(), "Failed to stat " + path.string()};
+        }
+        m_mappingSize = static_cast<std::size_t>(status.st_size);
+        if (m_mappingSize < sizeof(QuadTreeSnapshotHeader))
+        {
+            ::close(descriptor);
+            throw std::runtime_error {"The file " + path.string() + " is not a quadtree snapshot."};
+        }
+        void* mapping = ::mmap(nullptr, m_mappingSize, PROT_READ, MAP_SHARED, descriptor, 0);
+        const auto error = errno;
+        ::close(descriptor);
+        if (MAP_FAILED == mapping)
+        {
+            throw std::system_error {error, std::generic_category(), "Failed to map " + path.string()};
+        }
+        m_mapping = static_cast<const std::byte*>(mapping);
+
+        try
+        {
+            validate(path);
+        }
+        catch (...)
+        {
+            ::munmap(const_cast<std::byte*>(m_mapping), m_mappingSize);
+            throw;
+        }
+    }
+
+    MappedQuadTree(MappedQuadTree&& other) noexcept
+        : m_mapping {std::exchange(other.m_mapping, nullptr)}
+        , m_mappingSize {std::exchange(other.m_mappingSize, 0)}
+        , m_nodes {std::exchange(other.m_nodes, {})}
+        , m_values {std::exchange(other.m_values, {})}
+    {
+    }
+
+    MappedQuadTree& operator=(MappedQuadTree&& other) noexcept
+    {
+        if (this != std::addressof(other))
+        {
+            unmap();
+            m_mapping = std::exchange(other.m_mapping, nullptr);
+            m_mappingSize = std::exchange(other.m_mappingSize, 0);
+            m_nodes = std::exchange(other.m_nodes, {});
+            m_values = std::exchange(other.m_values, {});
+        }
+        return *this;
+    }
+
+    MappedQuadTree(const MappedQuadTree&) = delete;
+
+    MappedQuadTree& operator=(const MappedQuadTree&) = delete;
+
+    ~MappedQuadTree()
+    {
+        unmap();
+    }
+
+    /**
+     * @brief   Finds values intersecting a given rectangle.
+     *
+     * @tparam  TOutIt The type of output iterator.
+     * @param   key The rectangle for query.
+     * @param   outIt The output iterator.
+     */
+    template <typename TOutIt>
+    void query(const TBox& key, TOutIt outIt) const
+    {
+        visitIntersecting(key, [&outIt](const TKey& value)
+        {
+            *outIt++ = value;
+            return true;
+        });
+    }
+
+    /**
+     * @brief   Checks there is a value intersecting a given rectangle.
+     *
+     * @param   key The rectangle for query.
+     * @return  true if there is an intersecting value, otherwise false.
+     */
+    [[nodiscard]]
+    bool queryAny(const TBox& key) const
+    {
+        return !visitIntersecting(key, [](const TKey&)
+        {
+            return false;
+        });
+    }
+
+    /**
+     * @brief   Counts values intersecting a given rectangle.
+     *
+     * @param   key The rectangle for query.
+     * @return  The number of intersecting values.
+     */
+    [[nodiscard]]
+    size_type queryCount(const TBox& key) const
+    {
+        size_type count = 0;
+        visitIntersecting(key, [&count](const TKey&)
+        {
+            ++count;
+            return true;
+        });
+        return count;
+    }
+
+    /**
+     * @brief   Determines whether the snapshot contains the specified key.
+     *
+     * @param   key The key to locate.
+     * @return  true if the snapshot contains the key; otherwise, false.
+     */
+    [[nodiscard]]
+    bool contains(const TKey& key) const
+    {
+        return !visitIntersecting(TIndexableTraits::indexableOf(key), [&key](const TKey& value)
+        {
+            return !(value == key);
+        });
+    }
+
+    /**
+     * @brief   Gets the number of values stored in the snapshot.
+     *
+     * @return  The number of values.
+     */
+    [[nodiscard]]
+    size_type size() const noexcept
+    {
+        return std::size(m_values);
+    }
+
+    /**
+     * @brief  Checks the snapshot empty or not.
+     *
+     * @return true if the snapshot is empty, otherwise false.
+     */
+    [[nodiscard]]
+    bool empty() const noexcept
+    {
+        return m_values.empty();
+    }
+
+    /**
+     * @brief   Gets the nodes of the snapshot in the breadth-first order.
+     *
+     * @return  The span on the mapped nodes.
+     */
+    [[nodiscard]]
+    space::collections::Span<const TNode> nodes() const noexcept
+    {
+        return m_nodes;
+    }
+
+    /**
+     * @brief   Gets the values of the snapshot grouped by nodes.
+     *
+     * @return  The span on the mapped values.
+     */
+    [[nodiscard]]
+    space::collections::Span<const TKey> values() const noexcept
+    {
+        return m_values;
+    }
+
+private:
+
+    /**
+     * @internal
+     * @brief   Checks the header and the node links of the mapped file.
+     *
+     * @details The children of the nodes must follow each other in the breadth-first order,
+     *          so the links form a tree, the traversal terminates and its depth is bounded.
+     *
+     * @throws  std::runtime_error if the file is not the valid snapshot for TKey.
+     *
+     * @param   path The path of snapshot for the error messages.
+     */
+    void validate(const std::filesystem::path& path)
+    {
+        auto invalid = [&path](const char* reason)
+        {
+            return std::runtime_error {"The quadtree snapshot " + path.string() + " is invalid: " + reason + "."};
+        };
+
+        QuadTreeSnapshotHeader header {};
+        std::memcpy(&header, m_mapping, sizeof(header));
+        if (QuadTreeSnapshotHeader::s_magic != header.magic)
+        {
+            throw invalid("wrong signature");
+        }
+        if (QuadTreeSnapshotHeader::s_version != header.version)
+        {
+            throw invalid("unsupported version");
+        }
+        if (sizeof(TNode) != header.nodeSize || sizeof(TKey) != header.valueSize
+            || sizeof(TCoordinate) != header.coordinateSize)
+        {
+            throw invalid("the layout doesn't match the value type");
+        }
+        if (header.fileSize != m_mappingSize
+            || 0 != header.nodeOffset % alignof(TNode) || 0 != header.valueOffset % alignof(TKey)
+            || header.nodeOffset < sizeof(header) || header.nodeOffset > m_mappingSize
+            || header.valueOffset > m_mappingSize
+            || header.nodeCount > (m_mappingSize - header.nodeOffset) / sizeof(TNode)
+            || header.valueOffset < header.nodeOffset + header.nodeCount * sizeof(TNode)
+            || header.valueCount > (m_mappingSize - header.valueOffset) / sizeof(TKey))
+        {
+            throw invalid("truncated file");
+        }
+        m_nodes = space::collections::Span<const TNode> {reinterpret_cast<const TNode*>(m_mapping + header.nodeOffset)
+                                                         , header.nodeCount};
+        m_values = space::collections::Span<const TKey> {reinterpret_cast<const TKey*>(m_mapping + header.valueOffset)
+                                                         , header.valueCount};
+
+        space::collections::Vector<std::uint8_t> depths(std::size(m_nodes), 0);
+        std::uint64_t nextChild = 1;
+        for (std::size_t i = 0; i < std::size(m_nodes); ++i)
+        {
+            const auto& node = m_nodes[i];
+            if (node.firstChild != nextChild || node.childCount > 4
+                || node.firstChild + static_cast<std::uint64_t>(node.childCount) > std::size(m_nodes)
+                || node.valueBegin > node.valueEnd || node.valueEnd > std::size(m_values))
+            {
+                throw invalid("broken node links");
+            }
+            if (0 != node.childCount && depths[i] >= s_maxDepth)
+            {
+                throw invalid("the tree is too deep");
+            }
+            for (std::uint32_t child = 0; child < node.childCount; ++child)
+            {
+                depths[node.firstChild + child] = static_cast<std::uint8_t>(depths[i] + 1);
+            }
+            nextChild += node.childCount;
+        }
+        if (nextChild != std::max<std::uint64_t>(std::size(m_nodes), 1))
+        {
+            throw invalid("broken node links");
+        }
+    }
+
+    /**
+     * @internal
+     * @brief       Calls the visitor for every value intersecting the given rectangle.
+     *
+     * @tparam TVisitor The type of visitor, returns false to stop the traversal.
+     * @param key   The rectangle.
+     * @param visitor The visitor.
+     * @return      false if the visitor stopped the traversal, otherwise true.
+     */
+    template <typename TVisitor>
+    bool visitIntersecting(const TBox& key, TVisitor&& visitor) const
+    {
+        if (m_nodes.empty())
+        {
+            return true;
+        }
+        TTraversalStack nodeStack;
+        nodeStack.push(0);
+
+        while (!nodeStack.empty())
+        {
+            const auto& currentNode = m_nodes[nodeStack.top()];
+            nodeStack.pop();
+            if (!space::util::hasIntersect(key, currentNode.bounds))
+            {
+                continue;
+            }
+            for (std::uint32_t child = 0; child < currentNode.childCount; ++child)
+            {
+                nodeStack.push(currentNode.firstChild + child);
+            }
+            const bool isCovered = space::util::contains(key, currentNode.bounds);
+            for (auto i = currentNode.valueBegin; i < currentNode.valueEnd; ++i)
+            {
+                const auto& value = m_values[i];
+                if ((isCovered || space::util::hasIntersect(key, TIndexableTraits::indexableOf(value))) && !visitor(value))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @internal
+     * @brief   Unmaps the file if it is mapped.
+     */
+    void unmap() noexcept
+    {
+        if (nullptr != m_mapping)
+        {
+            ::munmap(const_cast<std::byte*>(m_mapping), m_mappingSize);
+            m_mapping = nullptr;
+        }
+    }
+
+private:
+
+    /**
+     * @brief   The mapped file.
+     */
+    const std::byte* m_mapping {nullptr};
+
+    /**
+     * @brief   The size of mapped file.
+     */
+    std::size_t m_mappingSize {0};
+
+    /**
+     * @brief   The nodes in the mapped file.
+     */
+    space::collections::Span<const TNode> m_nodes {};
+
+    /**
+     * @brief   The values in the mapped file.
+     */
+    space::collections::Span<const TKey> m_values {};
+}; // class MappedQuadTree
+
+#endif // SPACE_HAS_MMAP
+
+} // namespace space
@@ -0,0 +1,194 @@
+/**
+ * @file        QuadTreeStats.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaring the statistics of the QuadTree class.
+ * @date        14-10-2026
+ * @copyright   Copyright (c) 2026
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "Definitions.h"
+
+namespace space
+{
+
+/**
+ * @brief   The counters of quadtree operations, collected by the trees with the
+ *          CollectStats policy.
+ */
+struct QuadTreeCounters
+{
+    /**
+     * @brief   The number of query, queryAny and queryCount calls.
+     */
+    std::uint64_t queries {0};
+
+    /**
+     * @brief   The number of nodes popped by the queries.
+     */
+    std::uint64_t nodesVisited {0};
+
+    /**
+     * @brief   The number of values tested for intersection by the queries.
+     */
+    std::uint64_t valuesTested {0};
+
+    /**
+     * @brief   The number of values reported by the queries.
+     */
+    std::uint64_t valuesMatched {0};
+
+    /**
+     * @brief   The number of nodes created by growing the tree down.
+     */
+    std::uint64_t nodesAllocated {0};
+
+    /**
+     * @brief   The number of the new roots created by growing the tree up.
+     */
+    std::uint64_t rootRegrowths {0};
+
+    /**
+     * @brief   The number of values shifted in the node FlatSets by inserts and removes.
+     */
+    std::uint64_t valueShifts {0};
+};
+
+/**
+ * @brief   The snapshot of the quadtree structure and counters.
+ */
+struct QuadTreeStats
+{
+    /**
+     * @brief   The operation counters, zero if the tree doesn't collect them.
+     */
+    QuadTreeCounters counters {};
+
+    /**
+     * @brief   The number of nodes at every depth, the root depth is zero.
+     */
+    space::collections::Vector<std::size_t> nodesPerDepth {};
+
+    /**
+     * @brief   The number of values at every depth, the big values at the upper
+     *          depths are the keys crossing the split lines.
+     */
+    space::collections::Vector<std::size_t> valuesPerDepth {};
+
+    /**
+     * @brief   The number of nodes by their number of values, the bucket 0 is for nodes
+     *          without values and the bucket i is for [2^(i - 1), 2^i) values.
+     */
+    space::collections::Vector<std::size_t> valuesPerNode {};
+
+    /**
+     * @brief   The number of nodes.
+     */
+    std::size_t nodeCount {0};
+
+    /**
+     * @brief   The number of values.
+     */
+    std::size_t valueCount {0};
+
+    /**
+     * @brief   The bytes used by the node slabs and the node values.
+     */
+    std::size_t bytesUsed {0};
+};
+
+namespace impl
+{
+
+/**
+ * @internal
+ * @brief   The placeholder of counters for the trees without stats.
+ */
+struct NoQuadTreeCounters
+{
+    [[nodiscard]]
+    QuadTreeCounters load() const noexcept
+    {
+        return {};
+    }
+
+    void reset() noexcept
+    {
+    }
+};
+
+/**
+ * @internal
+ * @brief   The counters of quadtree updated by the concurrent queries.
+ *
+ * @details The operations collect their counts locally and add them once, so the queries
+ *          don't contend on every node.
+ */
+class AtomicQuadTreeCounters
+{
+public:
+    AtomicQuadTreeCounters() = default;
+
+    AtomicQuadTreeCounters(AtomicQuadTreeCounters&& other) noexcept
+    {
+        add(other.load());
+        other.reset();
+    }
+
+    AtomicQuadTreeCounters& operator=(AtomicQuadTreeCounters&& other) noexcept
+    {
+        reset();
+        add(other.load());
+        other.reset();
+        return *this;
+    }
+
+    void add(const QuadTreeCounters& counters) noexcept
+    {
+        m_queries.fetch_add(counters.queries, std::memory_order_relaxed);
+        m_nodesVisited.fetch_add(counters.nodesVisited, std::memory_order_relaxed);
+        m_valuesTested.fetch_add(counters.valuesTested, std::memory_order_relaxed);
+        m_valuesMatched.fetch_add(counters.valuesMatched, std::memory_order_relaxed);
+        m_nodesAllocated.fetch_add(counters.nodesAllocated, std::memory_order_relaxed);
+        m_rootRegrowths.fetch_add(counters.rootRegrowths, std::memory_order_relaxed);
+        m_valueShifts.fetch_add(counters.valueShifts, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]]
+    QuadTreeCounters load() const noexcept
+    {
+        return {m_queries.load(std::memory_order_relaxed)
+                , m_nodesVisited.load(std::memory_order_relaxed)
+                , m_valuesTested.load(std::memory_order_relaxed)
+                , m_valuesMatched.load(std::memory_order_relaxed)
+                , m_nodesAllocated.load(std::memory_order_relaxed)
+                , m_rootRegrowths.load(std::memory_order_relaxed)
+                , m_valueShifts.load(std::memory_order_relaxed)};
+    }
+
+    void reset() noexcept
+    {
+        for (auto* counter : {&m_queries, &m_nodesVisited, &m_valuesTested, &m_valuesMatched
+                              , &m_nodesAllocated, &m_rootRegrowths, &m_valueShifts})
+        {
+            counter->store(0, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    std::atomic<std::uint64_t> m_queries {0};
+    std::atomic<std::uint64_t> m_nodesVisited {0};
+    std::atomic<std::uint64_t> m_valuesTested {0};
+    std::atomic<std::uint64_t> m_valuesMatched {0};
+    std::atomic<std::uint64_t> m_nodesAllocated {0};
+    std::atomic<std::uint64_t> m_rootRegrowths {0};
+    std::atomic<std::uint64_t> m_valueShifts {0};
+};
+
+} // namespace impl
+
+} // namespace space
@@ -0,0 +1,355 @@
+/**
+ * @file        QueryCache.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaring the QueryCache class.
+ * @date        14-10-2026
+ * @copyright   Copyright (c) 2026
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <list>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+#include "Definitions.h"
+#include "Indexable.h"
+#include "QuadTree.h"
+#include "Utility.h"
+
+namespace space
+{
+
+/**
+ * @brief   The counters and the size of the query cache.
+ */
+struct QueryCacheStats
+{
+    /**
+     * @brief   The number of queries answered from the cache.
+     */
+    std::uint64_t hits {0};
+
+    /**
+     * @brief   The number of queries answered by the tree.
+     */
+    std::uint64_t misses {0};
+
+    /**
+     * @brief   The number of entries evicted to fit the memory limit.
+     */
+    std::uint64_t evictions {0};
+
+    /**
+     * @brief   The number of times the cache was dropped since the tree version changed.
+     */
+    std::uint64_t invalidations {0};
+
+    /**
+     * @brief   The number of cached entries.
+     */
+    std::size_t entryCount {0};
+
+    /**
+     * @brief   The approximate bytes used by the cached entries.
+     */
+    std::size_t bytesUsed {0};
+};
+
+/**
+ * @brief   The cache of the query results of the quadtree, for the repeated window queries
+ *          against the tree which changes rarely.
+ *
+ * @details The query box is aligned to the tiles of the given size, the result of the aligned
+ *          box is cached and filtered by the query box, so the nearly the same windows share
+ *          one entry. The entries are valid for one version of the tree, the cache is dropped
+ *          on the first query after the tree changes. The least recently used entries are
+ *          evicted to keep the bytes of entries under the limit, the result which doesn't fit
+ *          the limit is not cached.
+ *          The cache is not thread safe, the concurrent readers need own caches.
+ *
+ * @tparam  TKey The type of keys of the tree.
+ * @tparam  TPolicy The policy of the tree.
+ */
+template <typename TKey, typename TPolicy = DefaultQuadTreePolicy>
+class QueryCache
+{
+public:
+    using TTree = QuadTree<TKey, TPolicy>;
+    using TBox = typename TTree::TBox;
+    using TCoordinate = typename TBox::TCoordinate;
+    using size_type = std::size_t;
+
+private:
+    /**
+     * @brief   The hash of the aligned query box.
+     */
+    struct BoxHash
+    {
+        std::size_t operator()(const TBox& box) const noexcept
+        {
+            const auto[x1, y1] = space::util::bottomLeftOf(box);
+            const auto[x2, y2] = space::util::topRightOf(box);
+            std::size_t seed = 0;
+            for (const auto coordinate : {x1, y1, x2, y2})
+            {
+                seed ^= std::hash<TCoordinate> {}(coordinate) + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+            }
+            return seed;
+        }
+    };
+
+    /**
+     * @brief   The cached result of the aligned box, the list is ordered from the most recently used.
+     */
+    struct Entry
+    {
+        TBox box;
+        space::collections::Vector<TKey> values;
+        size_type bytes;
+    };
+
+    using TEntryList = std::list<Entry>;
+
+public:
+    /**
+     * @brief   Initializes the empty cache of the given tree.
+     *
+     * @param   tree The tree, must outlive the cache.
+     * @param   maxBytes The limit of the bytes used by the entries.
+     * @param   tileSize The size of tiles to align the query boxes, zero to cache the exact boxes.
+     */
+    QueryCache(const TTree& tree, size_type maxBytes, TCoordinate tileSize = TCoordinate {0})
+        : m_tree {std::addressof(tree)}
+        , m_maxBytes {maxBytes}
+        , m_tileSize {tileSize}
+        , m_version {tree.version()}
+    {
+    }
+
+    QueryCache(const QueryCache&) = delete;
+
+    QueryCache& operator=(const QueryCache&) = delete;
+
+    /**
+     * @brief   Finds values intersecting the given box, from the cache if it has the result of
+     *          the aligned box for the current tree version.
+     *
+     * @tparam  TOutIt The type of output iterator.
+     * @param   box The box for query.
+     * @param   outIt The output iterator.
+     */
+    template <typename TOutIt>
+    void query(const TBox& box, TOutIt outIt)
+    {
+        if (m_tree->version() != m_version)
+        {
+            clear();
+            ++m_stats.invalidations;
+            m_version = m_tree->version();
+        }
+
+        const auto alignedBox = alignedBoxOf(box);
+        const auto found = m_entries.find(alignedBox);
+        if (m_entries.end() != found)
+        {
+            ++m_stats.hits;
+            m_order.splice(m_order.begin(), m_order, found->second);
+            copyIntersecting(found->second->values, box, alignedBox, outIt);
+            return;
+        }
+
+        ++m_stats.misses;
+        space::collections::Vector<TKey> values;
+        m_tree->query(alignedBox, std::back_inserter(values));
+        copyIntersecting(values, box, alignedBox, outIt);
+
+        const auto bytes = bytesOf(values);
+        if (bytes > m_maxBytes)
+        {
+            return;
+        }
+        while (m_bytesUsed + bytes > m_maxBytes)
+        {
+            evictLast();
+        }
+        m_order.push_front({alignedBox, std::move(values), bytes});
+        m_entries.emplace(alignedBox, m_order.begin());
+        m_bytesUsed += bytes;
+    }
+
+    /**
+     * @brief   Removes all entries, the counters are kept.
+     */
+    void clear() noexcept
+    {
+        m_entries.clear();
+        m_order.clear();
+        m_bytesUsed = 0;
+    }
+
+    /**
+     * @brief   Gets the counters and the size of the cache.
+     *
+     * @return  The stats.
+     */
+    [[nodiscard]]
+    QueryCacheStats stats() const noexcept
+    {
+        auto result = m_stats;
+        result.entryCount = std::size(m_order);
+        result.bytesUsed = m_bytesUsed;
+        return result;
+    }
+
+    /**
+     * @brief   Resets the counters, the entries are kept.
+     */
+    void resetStats() noexcept
+    {
+        m_stats = {};
+    }
+
+private:
+    /**
+     * @internal
+     * @brief   Returns the smallest box of the whole tiles which contains the given box.
+     *
+     * @param   box The box.
+     * @return  The aligned box, the given box if the tiles are not used.
+     */
+    [[nodiscard]]
+    TBox alignedBoxOf(const TBox& box) const noexcept
+    {
+        if (TCoordinate {0} == m_tileSize)
+        {
+            return box;
+        }
+        const auto[x1, y1] = space::util::bottomLeftOf(box);
+        const auto[x2, y2] = space::util::topRightOf(box);
+        if constexpr (std::is_integral_v<TCoordinate>)
+        {
+            // The tile k covers the coordinates [k * tileSize, (k + 1) * tileSize - 1], the tiles
+            // at the limits of the coordinates are computed in 64-bit and clamped to the range.
+            const auto tileSize = std::int64_t {m_tileSize};
+            const auto tileOf = [tileSize](std::int64_t coordinate)
+            {
+                const auto tile = coordinate / tileSize;
+                return (coordinate % tileSize < 0) ? tile - 1 : tile;
+            };
+            const auto clamped = [](std::int64_t coordinate)
+            {
+                return std::clamp(coordinate, std::int64_t {std::numeric_limits<TCoordinate>::lowest()}
+                                  , std::int64_t {std::numeric_limits<TCoordinate>::max()});
+            };
+            const auto alignedX1 = clamped(tileOf(x1) * tileSize);
+            const auto alignedY1 = clamped(tileOf(y1) * tileSize);
+            const auto width = clamped(tileOf(x2) * tileSize + (tileSize - 1)) - alignedX1;
+            const auto height = clamped(tileOf(y2) * tileSize + (tileSize - 1)) - alignedY1;
+            if (width > std::numeric_limits<TCoordinate>::max() || height > std::numeric_limits<TCoordinate>::max())
+            {
+                // The aligned box is wider than the coordinates, the box is cached as is.
+                return box;
+            }
+            return TBox {{static_cast<TCoordinate>(alignedX1), static_cast<TCoordinate>(alignedY1)}
+                         , static_cast<TCoordinate>(width), static_cast<TCoordinate>(height)};
+        }
+        else
+        {
+            return TBox {{std::floor(x1 / m_tileSize) * m_tileSize, std::floor(y1 / m_tileSize) * m_tileSize}
+                         , {(std::floor(x2 / m_tileSize) + 1) * m_tileSize, (std::floor(y2 / m_tileSize) + 1) * m_tileSize}};
+        }
+    }
+
+    /**
+     * @internal
+     * @brief   Copies the values intersecting the query box, all values if the query box is the
+     *          aligned one.
+     */
+    template <typename TOutIt>
+    static void copyIntersecting(const space::collections::Vector<TKey>& values, const TBox& box
+                                 , const TBox& alignedBox, TOutIt& outIt)
+    {
+        const bool isAligned = box == alignedBox;
+        for (const auto& value : values)
+        {
+            if (isAligned || space::util::hasIntersect(box, space::IndexableTraits<TKey>::indexableOf(value)))
+            {
+                *outIt++ = value;
+            }
+        }
+    }
+
+    /**
+     * @internal
+     * @brief   Returns the approximate bytes of the entry with the given values, including the
+     *          list and the hash map nodes.
+     */
+    [[nodiscard]]
+    static size_type bytesOf(const space::collections::Vector<TKey>& values) noexcept
+    {
+        constexpr size_type nodeBytes = sizeof(Entry) + 2 * sizeof(void*)
+            + sizeof(std::pair<const TBox, typename TEntryList::iterator>) + 2 * sizeof(void*);
+        return nodeBytes + values.capacity() * sizeof(TKey);
+    }
+
+    /**
+     * @internal
+     * @brief   Evicts the least recently used entry.
+     */
+    void evictLast()
+    {
+        const auto& last = m_order.back();
+        m_bytesUsed -= last.bytes;
+        m_entries.erase(last.box);
+        m_order.pop_back();
+        ++m_stats.evictions;
+    }
+
+private:
+    /**
+     * @brief   The cached tree.
+     */
+    const TTree* m_tree;
+
+    /**
+     * @brief   The limit of the bytes used by the entries.
+     */
+    size_type m_maxBytes;
+
+    /**
+     * @brief   The size of tiles, zero if the boxes are not aligned.
+     */
+    TCoordinate m_tileSize;
+
+    /**
+     * @brief   The tree version of the cached entries.
+     */
+    std::uint64_t m_version;
+
+    /**
+     * @brief   The entries from the most recently used, and the index of them by the aligned box.
+     */
+    TEntryList m_order {};
+    std::unordered_map<TBox, typename TEntryList::iterator, BoxHash> m_entries {};
+
+    /**
+     * @brief   The bytes used by the entries.
+     */
+    size_type m_bytesUsed {0};
+
+    /**
+     * @brief   The counters, the size fields are filled by stats.
+     */
+    QueryCacheStats m_stats {};
+}; // class QueryCache
+
+} // namespace space
@@ -52,7 +52,7 @@ public:
 
     constexpr Rect& operator=(const Rect&) noexcept = default;
 
-    constexpr std::strong_ordering operator<=>(const Rect<TCrt>&) const noexcept = default;
+    constexpr auto operator<=>(const Rect<TCrt>&) const noexcept = default;
 
     /**
      * @brief   Initializes a new instance of the Rect structure that has the specified
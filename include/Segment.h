@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "Accumulator.h"
 #include "Definitions.h"
 #include "Point.h"
 
@@ -104,19 +105,20 @@ enum class EOrientation
  * @param q     The given point.
  * @param r     The given point.
  * @return      The orientation (EOrientation::collinear, EOrientation::clockwise, EOrientation::counterclockwise)
+ *
+ * @note        The determinant is evaluated in the accumulator type, see orientationSign.
  */
 template <typename TCrt>
 EOrientation orientation(const Point <TCrt>& p, const Point <TCrt>& q, const Point <TCrt>& r) noexcept
 {
-    const TCrt val = (q.y() - p.y()) * (r.x() - q.x())
-                     - (q.x() - p.x()) * (r.y() - q.y());
+    const auto sign = orientationSign(p, q, r);
 
-    if (val == 0)
+    if (sign == 0)
     {
         return EOrientation::collinear;
     }
 
-    return (val > 0) ? EOrientation::clockwise : EOrientation::counterclockwise;
+    return (sign > 0) ? EOrientation::clockwise : EOrientation::counterclockwise;
 }
 
 } // namespace util
@@ -0,0 +1,352 @@
+/**
+ * @file        SegmentSweep.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaring the sweep line algorithms over segment collections.
+ * @date        14-10-2026
+ * @copyright   Copyright (c) 2026
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <execution>
+#include <iterator>
+#include <numeric>
+#include <set>
+#include <utility>
+
+#include "Definitions.h"
+#include "Point.h"
+#include "Segment.h"
+
+namespace space::util
+{
+
+namespace impl
+{
+
+/**
+ * @internal
+ * @brief       Returns the segment with the endpoints in the lexicographic (x, y) order.
+ *
+ * @tparam TCrt The type of coordinates.
+ * @param segment The segment.
+ * @return      The ordered segment.
+ */
+template <typename TCrt>
+[[nodiscard]]
+constexpr Segment<TCrt> orderedSegmentOf(const Segment<TCrt>& segment) noexcept
+{
+    if (segment.second < segment.first)
+    {
+        return Segment<TCrt> {segment.second, segment.first};
+    }
+    return segment;
+}
+
+/**
+ * @internal
+ * @brief       Checks the first segment is below the second one at the sweep line.
+ *
+ * @details     Both segments must be ordered and cross the sweep line, the segment starting
+ *              later is compared to the line of the other one, its second endpoint is used if
+ *              the first one is on that line. The comparison doesn't need the sweep position.
+ * @tparam TCrt The type of coordinates.
+ * @param first The first ordered segment.
+ * @param second The second ordered segment.
+ * @return      true if the first segment is below, otherwise false.
+ */
+template <typename TCrt>
+[[nodiscard]]
+constexpr bool isBelowOnSweep(const Segment<TCrt>& first, const Segment<TCrt>& second) noexcept
+{
+    // Returns 1 if the later segment is above the earlier one, -1 if below, otherwise 0.
+    auto sideOf = [](const Segment<TCrt>& segment, const Segment<TCrt>& later) -> int
+    {
+        if (segment.first.x() == segment.second.x())
+        {
+            // The vertical segment is active only at its x-axis coordinate, the later segment
+            // starts above it or touches it.
+            return later.first.y() > segment.second.y() ? 1 : 0;
+        }
+        // The positive orientation sign means the third point is below the ordered segment.
+        auto sign = orientationSign(segment.first, segment.second, later.first);
+        if (0 == sign)
+        {
+            sign = orientationSign(segment.first, segment.second, later.second);
+        }
+        return -sign;
+    };
+
+    if (!(second.first < first.first))
+    {
+        return sideOf(first, second) > 0;
+    }
+    return sideOf(second, first) < 0;
+}
+
+/**
+ * @internal
+ * @brief       Finds out whether any two segments have an intersection (Shamos-Hoey).
+ *
+ * @details     The endpoints are swept by ascending x-axis, the active segments are kept
+ *              in the order of y-axis at the sweep line. Only the neighbours in this order can
+ *              have the first intersection, so every insertion and removal checks O(1) pairs.
+ *              The complexity is O(n log n).
+ * @tparam TCrt The type of coordinates.
+ * @param segments The segments, the endpoints must be ordered.
+ * @param isIgnored The predicate accepting two segment indexes, returns true if their
+ *              intersection must be ignored.
+ * @return      true if some segments have the not ignored intersection, otherwise false.
+ */
+template <typename TCrt, typename TIgnore>
+[[nodiscard]]
+bool sweepHasIntersect(space::collections::Span<const Segment<TCrt>> segments, TIgnore isIgnored)
+{
+    struct Event
+    {
+        Point<TCrt> point;
+        // 0 for the first endpoint, 1 for the second one, so insertions go first.
+        std::uint8_t isEnd;
+        std::size_t index;
+    };
+
+    space::collections::Vector<Event> events;
+    events.reserve(2 * std::size(segments));
+    for (std::size_t i = 0; i < std::size(segments); ++i)
+    {
+        events.push_back({segments[i].first, 0, i});
+        events.push_back({segments[i].second, 1, i});
+    }
+    std::ranges::sort(events, [](const Event& lhs, const Event& rhs)
+    {
+        return std::tie(lhs.point, lhs.isEnd, lhs.index) < std::tie(rhs.point, rhs.isEnd, rhs.index);
+    });
+
+    auto isLess = [segments](std::size_t lhs, std::size_t rhs)
+    {
+        if (isBelowOnSweep(segments[lhs], segments[rhs]))
+        {
+            return true;
+        }
+        if (isBelowOnSweep(segments[rhs], segments[lhs]))
+        {
+            return false;
+        }
+        return lhs < rhs;
+    };
+    auto isIntersected = [segments, &isIgnored](std::size_t lhs, std::size_t rhs)
+    {
+        return !isIgnored(lhs, rhs) && space::util::hasIntersect(segments[lhs], segments[rhs]);
+    };
+
+    std::set<std::size_t, decltype(isLess)> status {isLess};
+    space::collections::Vector<typename decltype(status)::iterator> positions(std::size(segments));
+    for (const auto& event : events)
+    {
+        if (0 == event.isEnd)
+        {
+            const auto it = status.insert(event.index).first;
+            positions[event.index] = it;
+            if (it != status.begin() && isIntersected(*std::prev(it), event.index))
+            {
+                return true;
+            }
+            if (std::next(it) != status.end() && isIntersected(*std::next(it), event.index))
+            {
+                return true;
+            }
+        }
+        else
+        {
+            const auto it = positions[event.index];
+            if (it != status.begin() && std::next(it) != status.end()
+                && isIntersected(*std::prev(it), *std::next(it)))
+            {
+                return true;
+            }
+            status.erase(it);
+        }
+    }
+    return false;
+}
+
+/**
+ * @internal
+ * @brief       Reports the intersecting pairs of the given segments in the given sweep order.
+ *
+ * @details     The segments are swept by ascending minimum x-axis coordinate, every segment is
+ *              tested against the active segments overlapping it by x-axis and y-axis ranges.
+ * @tparam TCrt The type of coordinates.
+ * @param segments The segments, the endpoints must be ordered.
+ * @param order The indexes of segments sorted by the first endpoint.
+ * @param fn    The function accepting the pair of indexes, the smaller index goes first.
+ */
+template <typename TCrt, typename TFn>
+void sweepIntersectingPairs(space::collections::Span<const Segment<TCrt>> segments
+                            , space::collections::Span<const std::size_t> order
+                            , TFn fn)
+{
+    space::collections::Vector<std::size_t> active;
+    for (const auto index : order)
+    {
+        const auto& segment = segments[index];
+        const auto minY = std::min(segment.first.y(), segment.second.y());
+        const auto maxY = std::max(segment.first.y(), segment.second.y());
+        for (std::size_t i = 0; i < std::size(active);)
+        {
+            const auto& other = segments[active[i]];
+            if (other.second.x() < segment.first.x())
+            {
+                active[i] = active.back();
+                active.pop_back();
+                continue;
+            }
+            if (std::max(other.first.y(), other.second.y()) >= minY
+                && std::min(other.first.y(), other.second.y()) <= maxY
+                && space::util::hasIntersect(other, segment))
+            {
+                fn(std::min(index, active[i]), std::max(index, active[i]));
+            }
+            ++i;
+        }
+        active.push_back(index);
+    }
+}
+
+} // namespace impl
+
+/**
+ * @brief   Checks any two of the given segments have an intersection or not.
+ *
+ * @details The Shamos-Hoey sweep line with the exact predicates orientation and onSegment,
+ *          the complexity is O(n log n). The touching endpoints are intersections.
+ * @tparam  TCrt The type of coordinates.
+ * @param   segments The segments.
+ * @return  true if some segments have an intersection, otherwise false.
+ */
+template <typename TCrt>
+[[nodiscard]]
+bool hasAnyIntersect(space::collections::Span<const Segment<TCrt>> segments)
+{
+    space::collections::Vector<Segment<TCrt>> ordered(std::size(segments));
+    std::ranges::transform(segments, ordered.begin(), impl::orderedSegmentOf<TCrt>);
+    return impl::sweepHasIntersect<TCrt>(ordered, [](std::size_t, std::size_t) { return false; });
+}
+
+/**
+ * @brief   Reports all pairs of the given segments having an intersection.
+ *
+ * @details The segments are swept by x-axis, every segment is compared with the active segments
+ *          overlapping its x-axis range and tested exactly only if the y-axis ranges overlap too.
+ *          The complexity is O(n log n + m), where m is the number of pairs with overlapping
+ *          x-axis ranges, so it suits the short segments of polygon edges. The sweep line of
+ *          Bentley-Ottmann is not used, its events are the intersection points which are not
+ *          representable in the coordinates type.
+ * @tparam  TCrt The type of coordinates.
+ * @tparam  TOutIt The type of output iterator accepting std::pair<std::size_t, std::size_t>.
+ * @param   segments The segments.
+ * @param   outIt The output iterator for the pairs of indexes, the smaller index goes first.
+ */
+template <typename TCrt, typename TOutIt>
+void intersectingPairs(space::collections::Span<const Segment<TCrt>> segments, TOutIt outIt)
+{
+    space::collections::Vector<Segment<TCrt>> ordered(std::size(segments));
+    std::ranges::transform(segments, ordered.begin(), impl::orderedSegmentOf<TCrt>);
+
+    space::collections::Vector<std::size_t> order(std::size(segments));
+    std::iota(order.begin(), order.end(), std::size_t {0});
+    std::ranges::sort(order, std::ranges::less {}, [&ordered](std::size_t i) { return ordered[i].first.x(); });
+
+    impl::sweepIntersectingPairs<TCrt>(ordered, order, [&outIt](std::size_t first, std::size_t second)
+    {
+        *outIt++ = std::pair {first, second};
+    });
+}
+
+/**
+ * @brief   Reports all pairs of the given segments having an intersection in parallel.
+ *
+ * @details The x-axis range is split into the strips with the equal numbers of starting
+ *          segments, every strip is swept independently over the segments overlapping it.
+ *          The pair is reported by the strip containing the later start of two segments,
+ *          so every pair is reported once.
+ * @tparam  TExecutionPolicy The type of execution policy.
+ * @tparam  TCrt The type of coordinates.
+ * @param   policy The execution policy.
+ * @param   segments The segments.
+ * @param   stripCount The number of strips.
+ * @return  The pairs of indexes, the smaller index goes first.
+ */
+template <typename TExecutionPolicy, typename TCrt>
+    requires std::is_execution_policy_v<std::remove_cvref_t<TExecutionPolicy>>
+space::collections::Vector<std::pair<std::size_t, std::size_t>>
+    intersectingPairs(TExecutionPolicy&& policy, space::collections::Span<const Segment<TCrt>> segments, std::size_t stripCount = 64)
+{
+    using TPair = std::pair<std::size_t, std::size_t>;
+
+    space::collections::Vector<Segment<TCrt>> ordered(std::size(segments));
+    std::transform(policy, segments.begin(), segments.end(), ordered.begin(), impl::orderedSegmentOf<TCrt>);
+
+    space::collections::Vector<std::size_t> order(std::size(segments));
+    std::iota(order.begin(), order.end(), std::size_t {0});
+    std::sort(policy, order.begin(), order.end(), [&ordered](std::size_t lhs, std::size_t rhs)
+    {
+        return ordered[lhs].first.x() < ordered[rhs].first.x();
+    });
+
+    stripCount = std::clamp<std::size_t>(stripCount, 1, std::max<std::size_t>(std::size(order), 1));
+    space::collections::Vector<std::size_t> strips(stripCount);
+    std::iota(strips.begin(), strips.end(), std::size_t {0});
+    space::collections::Vector<space::collections::Vector<TPair>> stripPairs(stripCount);
+
+    std::for_each(policy, strips.begin(), strips.end(), [&](std::size_t strip)
+    {
+        const auto beginIndex = std::size(order) * strip / stripCount;
+        const auto endIndex = std::size(order) * (strip + 1) / stripCount;
+        if (beginIndex == endIndex)
+        {
+            return;
+        }
+        const auto stripBegin = ordered[order[beginIndex]].first.x();
+
+        // The segments starting before the strip and reaching it, then the segments of the strip.
+        space::collections::Vector<std::size_t> stripOrder;
+        for (std::size_t i = 0; i < beginIndex; ++i)
+        {
+            if (ordered[order[i]].second.x() >= stripBegin)
+            {
+                stripOrder.push_back(order[i]);
+            }
+        }
+        const auto ownBegin = std::size(stripOrder);
+        stripOrder.insert(stripOrder.end(), order.begin() + static_cast<std::ptrdiff_t>(beginIndex)
+                          , order.begin() + static_cast<std::ptrdiff_t>(endIndex));
+
+        space::collections::Vector<std::uint8_t> isOwn(std::size(ordered), 0);
+        for (auto i = ownBegin; i < std::size(stripOrder); ++i)
+        {
+            isOwn[stripOrder[i]] = 1;
+        }
+
+        auto& pairs = stripPairs[strip];
+        impl::sweepIntersectingPairs<TCrt>(ordered, stripOrder, [&](std::size_t first, std::size_t second)
+        {
+            // The pair is owned by the strip of the later segment, the earlier one is active.
+            if (0 != isOwn[first] || 0 != isOwn[second])
+            {
+                pairs.emplace_back(first, second);
+            }
+        });
+    });
+
+    space::collections::Vector<TPair> result;
+    for (auto& pairs : stripPairs)
+    {
+        result.insert(result.end(), pairs.begin(), pairs.end());
+    }
+    return result;
+}
+
+} // namespace space::util
@@ -0,0 +1,441 @@
+/**
+ * @file        ShardedQuadTree.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaring the ShardedQuadTree class.
+ * @date        14-10-2026
+ * @copyright   Copyright (c) 2026
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <execution>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <shared_mutex>
+#include <type_traits>
+#include <utility>
+
+#include "Definitions.h"
+#include "QuadTree.h"
+#include "Rect.h"
+
+namespace space
+{
+
+/**
+ * @brief   The spatial index partitioned to the independent quadtrees by the grid of cells.
+ *
+ * @details The world extent is split to GridSize x GridSize cells, every cell is a shard with
+ *          its own QuadTree and lock. The key which is inside one cell goes to its shard, the keys
+ *          which straddle the cell boundaries or are outside of the world extent go to the shared
+ *          overflow tree. The operations are thread-safe, the writers to different shards don't
+ *          contend, so the parallel ingest scales with the number of shards. The queries lock
+ *          only the shards intersecting the query box and the overflow tree.
+ *
+ * @tparam  TKey The type of values, must be ordered and have the IndexableTraits specialization.
+ * @tparam  GridSize The number of cells per side, 2 gives the top-level z-order quadrants.
+ * @tparam  TPolicy The policy of shard quadtrees, see DefaultQuadTreePolicy.
+ */
+template <typename TKey, std::size_t GridSize = 4, typename TPolicy = DefaultQuadTreePolicy>
+class ShardedQuadTree
+{
+    static_assert(GridSize != 0, "GridSize must not be zero.");
+
+    using TTree = QuadTree<TKey, TPolicy>;
+    using TIndexableTraits = space::IndexableTraits<TKey>;
+
+public:
+    using TBox = typename TTree::TBox;
+    using TCoordinate = typename TTree::TCoordinate;
+    using size_type = std::size_t;
+
+private:
+    /**
+     * @brief   The quadtree with its lock.
+     */
+    struct Shard
+    {
+        Shard() = default;
+
+        explicit Shard(const TBox& extent)
+            : tree(extent)
+        {
+        }
+
+        mutable std::shared_mutex mutex {};
+        TTree tree {};
+    };
+
+    /**
+     * @brief   The number of cell shards, the overflow shard is stored after them.
+     */
+    static constexpr std::size_t s_cellCount = GridSize * GridSize;
+
+    /**
+     * @brief   The index of the overflow shard.
+     */
+    static constexpr std::size_t s_overflowIndex = s_cellCount;
+
+public:
+    /**
+     * @brief   Initializes a new instance of the ShardedQuadTree for the given world extent.
+     *
+     * @param   worldExtent The rectangle which is split to the cells.
+     */
+    explicit ShardedQuadTree(const TBox& worldExtent)
+        : m_origin(worldExtent.pos())
+        , m_cellWidth(cellSizeOf(worldExtent.width()))
+        , m_cellHeight(cellSizeOf(worldExtent.height()))
+        , m_shards()
+    {
+        m_shards.reserve(s_cellCount + 1);
+        for (std::size_t i = 0; i < s_cellCount; ++i)
+        {
+            const auto[x, width] = cellRangeOf(m_origin.x(), worldExtent.width(), m_cellWidth, i % GridSize);
+            const auto[y, height] = cellRangeOf(m_origin.y(), worldExtent.height(), m_cellHeight, i / GridSize);
+            m_shards.push_back(std::make_unique<Shard>(TBox {{x, y}, width, height}));
+        }
+        m_shards.push_back(std::make_unique<Shard>());
+    }
+
+    ShardedQuadTree(const ShardedQuadTree&) = delete;
+
+    ShardedQuadTree& operator=(const ShardedQuadTree&) = delete;
+
+    /**
+     * @brief   Inserts the given key, safe for the concurrent calls.
+     *
+     * @param   key The key.
+     * @return  true if the key is inserted, false if it is already stored.
+     */
+    bool insert(const TKey& key)
+    {
+        auto& shard = *m_shards[shardIndexOf(indexableOf(key))];
+        const std::unique_lock lock {shard.mutex};
+        return shard.tree.insert(key);
+    }
+
+    /**
+     * @brief   Inserts the keys, the shards are loaded in parallel by the given execution policy.
+     *
+     * @details The keys are partitioned by the shards once, then every shard is bulk loaded,
+     *          see QuadTree::bulkLoad.
+     *
+     * @tparam  TExecutionPolicy The type of execution policy.
+     * @tparam  TRange The type of range of keys.
+     * @param   policy The execution policy.
+     * @param   keys The keys.
+     * @return  The number of inserted keys.
+     */
+    template <typename TExecutionPolicy, typename TRange>
+    size_type bulkLoad(TExecutionPolicy&& policy, TRange&& keys)
+    {
+        space::collections::Array<space::collections::Vector<TKey>, s_cellCount + 1> partitions;
+        for (const auto& key : keys)
+        {
+            partitions[shardIndexOf(indexableOf(key))].push_back(key);
+        }
+        space::collections::Array<size_type, s_cellCount + 1> insertedCounts {};
+        space::collections::Array<std::size_t, s_cellCount + 1> indexes {};
+        std::iota(indexes.begin(), indexes.end(), std::size_t {0});
+        std::for_each(std::forward<TExecutionPolicy>(policy), indexes.begin(), indexes.end()
+            , [this, &partitions, &insertedCounts](const std::size_t index)
+        {
+            if (partitions[index].empty())
+            {
+                return;
+            }
+            auto& shard = *m_shards[index];
+            const std::unique_lock lock {shard.mutex};
+            insertedCounts[index] = shard.tree.bulkLoad(partitions[index]);
+        });
+        return std::accumulate(insertedCounts.begin(), insertedCounts.end(), size_type {0});
+    }
+
+    /**
+     * @brief   Inserts the keys, the shards are loaded in parallel, see bulkLoad.
+     *
+     * @tparam  TRange The type of range of keys.
+     * @param   keys The keys.
+     * @return  The number of inserted keys.
+     */
+    template <typename TRange>
+    size_type bulkLoad(TRange&& keys)
+    {
+        return bulkLoad(std::execution::par, std::forward<TRange>(keys));
+    }
+
+    /**
+     * @brief   Removes the given key, safe for the concurrent calls.
+     *
+     * @param   key The key.
+     */
+    void remove(const TKey& key)
+    {
+        auto& shard = *m_shards[shardIndexOf(indexableOf(key))];
+        const std::unique_lock lock {shard.mutex};
+        shard.tree.remove(key);
+    }
+
+    /**
+     * @brief   Finds values intersecting the given rectangle, only the intersecting shards
+     *          are visited.
+     *
+     * @tparam  TOutIt The type of output iterator.
+     * @param   key The rectangle for query.
+     * @param   outIt The output iterator.
+     */
+    template <typename TOutIt>
+    void query(const TBox& key, TOutIt outIt) const
+    {
+        forEachShardOf(key, [&key, &outIt](const TTree& tree)
+        {
+            for (const auto& value : tree.queryRange(key))
+            {
+                *outIt++ = value;
+            }
+            return true;
+        });
+    }
+
+    /**
+     * @brief   Checks if any value intersects the given rectangle.
+     *
+     * @param   key The rectangle for query.
+     * @return  true if there is an intersecting value, otherwise false.
+     */
+    [[nodiscard]]
+    bool queryAny(const TBox& key) const
+    {
+        return !forEachShardOf(key, [&key](const TTree& tree)
+        {
+            return !tree.queryAny(key);
+        });
+    }
+
+    /**
+     * @brief   Counts values intersecting the given rectangle.
+     *
+     * @param   key The rectangle for query.
+     * @return  The number of intersecting values.
+     */
+    [[nodiscard]]
+    size_type queryCount(const TBox& key) const
+    {
+        size_type count = 0;
+        forEachShardOf(key, [&key, &count](const TTree& tree)
+        {
+            count += tree.queryCount(key);
+            return true;
+        });
+        return count;
+    }
+
+    /**
+     * @brief   Determines whether the index contains the specified key.
+     *
+     * @param   key The key to locate.
+     * @return  true if the key is stored, otherwise false.
+     */
+    [[nodiscard]]
+    bool contains(const TKey& key) const
+    {
+        const auto& shard = *m_shards[shardIndexOf(indexableOf(key))];
+        const std::shared_lock lock {shard.mutex};
+        return shard.tree.contains(key);
+    }
+
+    /**
+     * @brief   Get the number of values stored in the index.
+     *
+     * @return  The number of values.
+     */
+    [[nodiscard]]
+    size_type size() const
+    {
+        size_type count = 0;
+        for (const auto& shard : m_shards)
+        {
+            const std::shared_lock lock {shard->mutex};
+            count += shard->tree.size();
+        }
+        return count;
+    }
+
+    /**
+     * @brief  Checks the container empty or not.
+     *
+     * @return true if the container is empty, otherwise false.
+     */
+    [[nodiscard]]
+    bool empty() const
+    {
+        return 0 == size();
+    }
+
+    /**
+     * @brief   Get the number of values stored in the overflow tree, i.e. the keys which
+     *          straddle the cell boundaries or are outside of the world extent.
+     *
+     * @return  The number of overflow values.
+     */
+    [[nodiscard]]
+    size_type overflowSize() const
+    {
+        const auto& shard = *m_shards[s_overflowIndex];
+        const std::shared_lock lock {shard.mutex};
+        return shard.tree.size();
+    }
+
+private:
+    /**
+     * @internal
+     * @brief   Returns the cell size for the given world size.
+     */
+    static TCoordinate cellSizeOf(TCoordinate worldSize) noexcept
+    {
+        if constexpr (std::is_integral_v<TCoordinate>)
+        {
+            // The rounded up size is not bigger than the world size, so it fits the coordinates.
+            constexpr auto gridSize = static_cast<std::int64_t>(GridSize);
+            return static_cast<TCoordinate>(std::max(std::int64_t {1}, (std::int64_t {worldSize} + gridSize - 1) / gridSize));
+        }
+        else
+        {
+            return worldSize / static_cast<TCoordinate>(GridSize);
+        }
+    }
+
+    /**
+     * @internal
+     * @brief   Returns the start and the size of the cell along one axis.
+     *
+     * @details The integer cells are computed in 64-bit, the cells past the rounded up
+     *          world size are clamped to the world extent.
+     */
+    static std::pair<TCoordinate, TCoordinate> cellRangeOf(TCoordinate origin, TCoordinate worldSize
+                                                           , TCoordinate cellSize, std::size_t cell) noexcept
+    {
+        if constexpr (std::is_integral_v<TCoordinate>)
+        {
+            const auto worldEnd = std::int64_t {origin} + worldSize;
+            const auto cellBegin = std::min(std::int64_t {origin} + static_cast<std::int64_t>(cell) * cellSize, worldEnd);
+            const auto cellEnd = std::min(cellBegin + cellSize, worldEnd);
+            return {static_cast<TCoordinate>(cellBegin), static_cast<TCoordinate>(cellEnd - cellBegin)};
+        }
+        else
+        {
+            return {origin + static_cast<TCoordinate>(cell) * cellSize, cellSize};
+        }
+    }
+
+    /**
+     * @internal
+     * @brief   Returns the cell of coordinate along one axis, may be out of the grid.
+     */
+    static std::ptrdiff_t cellOf(TCoordinate coordinate, TCoordinate origin, TCoordinate cellSize) noexcept
+    {
+        if (coordinate < origin)
+        {
+            return -1;
+        }
+        if constexpr (std::is_integral_v<TCoordinate>)
+        {
+            return static_cast<std::ptrdiff_t>((static_cast<std::int64_t>(coordinate) - origin) / cellSize);
+        }
+        else
+        {
+            return static_cast<std::ptrdiff_t>(std::floor((coordinate - origin) / cellSize));
+        }
+    }
+
+    /**
+     * @internal
+     * @brief   Returns the shard index for the given box.
+     *
+     * @param   box The box of key.
+     * @return  The index of the cell which contains the box, otherwise the overflow index.
+     */
+    std::size_t shardIndexOf(const TBox& box) const noexcept
+    {
+        const auto[x1, y1] = space::util::bottomLeftOf(box);
+        const auto[x2, y2] = space::util::topRightOf(box);
+        const auto column = cellOf(x1, m_origin.x(), m_cellWidth);
+        const auto row = cellOf(y1, m_origin.y(), m_cellHeight);
+        constexpr auto gridSize = static_cast<std::ptrdiff_t>(GridSize);
+        if (column < 0 || row < 0 || column >= gridSize || row >= gridSize
+            || column != cellOf(x2, m_origin.x(), m_cellWidth) || row != cellOf(y2, m_origin.y(), m_cellHeight))
+        {
+            return s_overflowIndex;
+        }
+        return static_cast<std::size_t>(row * gridSize + column);
+    }
+
+    /**
+     * @internal
+     * @brief   Calls the visitor for the trees of shards intersecting the given box.
+     *
+     * @tparam  TVisitor The type of visitor, returns false to stop.
+     * @param   key The box.
+     * @param   visitor The visitor.
+     * @return  false if the visitor stopped, otherwise true.
+     */
+    template <typename TVisitor>
+    bool forEachShardOf(const TBox& key, TVisitor&& visitor) const
+    {
+        const auto visit = [&visitor](const Shard& shard)
+        {
+            const std::shared_lock lock {shard.mutex};
+            return visitor(shard.tree);
+        };
+        if (!visit(*m_shards[s_overflowIndex]))
+        {
+            return false;
+        }
+
+        constexpr auto lastCell = static_cast<std::ptrdiff_t>(GridSize) - 1;
+        const auto[x1, y1] = space::util::bottomLeftOf(key);
+        const auto[x2, y2] = space::util::topRightOf(key);
+        const auto firstColumn = std::max(std::ptrdiff_t {0}, cellOf(x1, m_origin.x(), m_cellWidth));
+        const auto firstRow = std::max(std::ptrdiff_t {0}, cellOf(y1, m_origin.y(), m_cellHeight));
+        const auto lastColumn = std::min(lastCell, cellOf(x2, m_origin.x(), m_cellWidth));
+        const auto lastRow = std::min(lastCell, cellOf(y2, m_origin.y(), m_cellHeight));
+        for (auto row = firstRow; row <= lastRow; ++row)
+        {
+            for (auto column = firstColumn; column <= lastColumn; ++column)
+            {
+                if (!visit(*m_shards[static_cast<std::size_t>(row * (lastCell + 1) + column)]))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    static decltype(auto) indexableOf(const TKey& value) noexcept
+    {
+        return TIndexableTraits::indexableOf(value);
+    }
+
+private:
+    /**
+     * @brief   The bottom-left corner of the grid.
+     */
+    space::Point<TCoordinate> m_origin;
+
+    TCoordinate m_cellWidth;
+
+    TCoordinate m_cellHeight;
+
+    /**
+     * @brief   The cell shards in the row-major order and the overflow shard.
+     */
+    space::collections::Vector<std::unique_ptr<Shard>> m_shards;
+}; // class ShardedQuadTree
+
+} // namespace space
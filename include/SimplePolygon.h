@@ -9,14 +9,19 @@
 #pragma once
 
 #include <algorithm>
+#include <cstdint>
 #include <iterator>
 #include <optional>
+#include <stdexcept>
+#include <type_traits>
 #include <iostream>
 
+#include "Accumulator.h"
 #include "Definitions.h"
 #include "Point.h"
 #include "Rect.h"
 #include "Segment.h"
+#include "SegmentSweep.h"
 #include "Vector.h"
 
 namespace space
@@ -157,26 +162,90 @@ constexpr void move(SimplePolygon<TCrt>& poly, TCrt deltaX, TCrt deltaY) noexcep
 template <typename TCrt>
 constexpr space::Rect<TCrt> boundaryBoxOf(const SimplePolygon<TCrt>& poly) noexcept
 {
-    auto[leftBottomIt, rightTopIt] = std::ranges::minmax_element(poly.boundaryCurve());
-    return space::Rect<TCrt>(*leftBottomIt, *rightTopIt);
+    const auto[minXIt, maxXIt] = std::ranges::minmax_element(poly.boundaryCurve(), std::ranges::less {}
+                                                             , [](const auto& point) { return point.x(); });
+    const auto[minYIt, maxYIt] = std::ranges::minmax_element(poly.boundaryCurve(), std::ranges::less {}
+                                                             , [](const auto& point) { return point.y(); });
+    return space::Rect<TCrt>({minXIt->x(), minYIt->y()}, {maxXIt->x(), maxYIt->y()});
 }
 
 namespace impl
 {
 /**
  * @internal
- * @brief       Returns number that can be used as infinity for the given polygon.
+ * @brief       The relation of the polygon edge and the horizontal ray from the point to the positive x.
+ */
+enum class ERayCrossing
+{
+    none = 0, crossing, boundary
+};
+
+/**
+ * @internal
+ * @brief       Finds the relation of the given edge and the ray from the point to the positive x.
  *
- * @details     Finds the biggest x-axis coordinate in a polygon, increments it by 1, then returns.
+ * @details     The half-open rule is used, the edge crosses the ray if exactly one of its ends
+ *              is above the point, so a ray going through a vertex is counted once. The cross
+ *              product sign is calculated by orientationSign, so it doesn't overflow.
  * @tparam TCrt The type of coordinates.
- * @param poly  The given polygon.
- * @return      Pseudo infinity number.
+ * @param first The start of edge.
+ * @param second The end of edge.
+ * @param point The start of ray.
+ * @return      ERayCrossing::boundary if the point is on the edge, ERayCrossing::crossing if
+ *              the edge crosses the ray, otherwise ERayCrossing::none.
  */
 template <typename TCrt>
-TCrt infinityXAxisFor(const SimplePolygon<TCrt>& poly) noexcept
+[[nodiscard]]
+constexpr ERayCrossing rayCrossingOf(const Point<TCrt>& first, const Point<TCrt>& second, const Point<TCrt>& point) noexcept
 {
-    space::Rect boundingBox = space::util::boundaryBoxOf(poly);
-    return space::util::topRightOf(boundingBox).x() + 1;
+    // The cross product of (second - first) and (point - first) has the opposite sign.
+    const auto cross = -orientationSign(first, second, point);
+    if (0 == cross
+        && point.x() >= std::min(first.x(), second.x()) && point.x() <= std::max(first.x(), second.x())
+        && point.y() >= std::min(first.y(), second.y()) && point.y() <= std::max(first.y(), second.y()))
+    {
+        return ERayCrossing::boundary;
+    }
+    if ((first.y() > point.y()) != (second.y() > point.y()) && ((cross > 0) == (second.y() > first.y())))
+    {
+        return ERayCrossing::crossing;
+    }
+    return ERayCrossing::none;
+}
+
+/**
+ * @internal
+ * @brief       Checks the point is inside or on the given closed piecewise linear curve.
+ *
+ * @details     The even-odd rule with the horizontal ray from the point to the positive x.
+ * @tparam TCrt The type of coordinates.
+ * @param boundary The closed piecewise linear curve.
+ * @param point The given point.
+ * @return      true if contains, otherwise returns false.
+ */
+template <typename TCrt>
+[[nodiscard]]
+constexpr bool curveContains(const typename SimplePolygon<TCrt>::TPiecewiseLinearCurve& boundary
+                             , const Point<TCrt>& point) noexcept
+{
+    const auto numOfVertex = std::size(boundary);
+    if (numOfVertex < 3)
+    {
+        return false;
+    }
+
+    bool isInside = false;
+    for (size_t i = 0; i < numOfVertex; ++i)
+    {
+        const auto& next = (i + 1 == numOfVertex) ? boundary[0] : boundary[i + 1];
+        const auto crossing = rayCrossingOf(boundary[i], next, point);
+        if (ERayCrossing::boundary == crossing)
+        {
+            return true;
+        }
+        isInside ^= (ERayCrossing::crossing == crossing);
+    }
+    return isInside;
 }
 } // namespace impl
 
@@ -189,7 +258,7 @@ TCrt infinityXAxisFor(const SimplePolygon<TCrt>& poly) noexcept
  *          If we take a ray that starts at a point and goes off to infinity (in any direction),
  *          we count the number of intersections. If this number is odd, the point is inside;
  *          otherwise, it is outside. The running time linearly depends on the number of vertices
- *          in the polygon.
+ *          in the polygon, see space::EdgeBands for large polygons.
  * @tparam  TCrt The type of coordinates.
  * @param   poly The given Simple Polygon.
  * @param   point The given point.
@@ -199,49 +268,179 @@ template <typename TCrt>
 [[nodiscard]]
 constexpr bool contains(const SimplePolygon<TCrt>& poly, const Point<TCrt>& point) noexcept
 {
-    // Create a horizontal line from point to infinity.
-    const auto infinity = impl::infinityXAxisFor(poly);
-    const Segment<TCrt> horizontalLine { point, Point<TCrt>{infinity, point.y()} };
+    return impl::curveContains(poly.boundaryCurve(), point);
+}
 
-    // Count intersections of the above line with sides of polygon
-    size_t count = 0;
-    size_t i = 0;
+namespace impl
+{
 
-    const auto& boundary = poly.boundaryCurve();
-    auto numOfVertex = std::size(boundary);
+/**
+ * @internal
+ * @brief   The number of points processed together by the batch point-in-polygon test.
+ */
+inline constexpr std::size_t s_containsBatchBlockSize = 64;
+
+/**
+ * @internal
+ * @brief       Checks the block of points is inside or on the given closed piecewise linear curve.
+ *
+ * @details     The loops are flipped relative to curveContains, every edge is tested against all
+ *              points of the block without branches, so the inner loop can be vectorised. The edges
+ *              out of the y-axis range of the block are skipped. The results are the same as
+ *              curveContains for every point, except for the floating point coordinates where
+ *              the nearly collinear cases are not refined as by orientationSign.
+ * @tparam TCrt The type of coordinates.
+ * @param boundary The closed piecewise linear curve.
+ * @param points The points, at most s_containsBatchBlockSize.
+ * @param out   The results, 1 if contains, otherwise 0.
+ */
+template <typename TCrt>
+void curveContainsBlock(const typename SimplePolygon<TCrt>::TPiecewiseLinearCurve& boundary
+                        , space::collections::Span<const Point<TCrt>> points
+                        , space::collections::Span<std::uint8_t> out) noexcept
+{
+    using TAccumulate = TAccumulatorOf<TCrt>;
 
+    const auto count = std::size(points);
+    const auto numOfVertex = std::size(boundary);
     if (numOfVertex < 3)
     {
-        return false;
+        std::fill_n(out.begin(), count, std::uint8_t {0});
+        return;
+    }
+
+    TAccumulate xs[s_containsBatchBlockSize];
+    TAccumulate ys[s_containsBatchBlockSize];
+    std::uint8_t isInside[s_containsBatchBlockSize] {};
+    std::uint8_t isOnBoundary[s_containsBatchBlockSize] {};
+
+    for (std::size_t j = 0; j < count; ++j)
+    {
+        xs[j] = points[j].x();
+        ys[j] = points[j].y();
     }
+    const auto [minYIt, maxYIt] = std::minmax_element(ys, ys + count);
+    const auto blockMinY = *minYIt;
+    const auto blockMaxY = *maxYIt;
 
-    do
+    for (std::size_t i = 0; i < numOfVertex; ++i)
     {
-        const auto next = (i + 1) % numOfVertex;
-        Segment polygonEdge {boundary[i], boundary[next]};
-        if (hasIntersect(polygonEdge, horizontalLine))
+        const auto& first = boundary[i];
+        const auto& second = (i + 1 == numOfVertex) ? boundary[0] : boundary[i + 1];
+
+        const TAccumulate firstX = first.x();
+        const TAccumulate firstY = first.y();
+        const TAccumulate deltaX = static_cast<TAccumulate>(second.x()) - firstX;
+        const TAccumulate deltaY = static_cast<TAccumulate>(second.y()) - firstY;
+        const TAccumulate minX = std::min<TAccumulate>(first.x(), second.x());
+        const TAccumulate maxX = std::max<TAccumulate>(first.x(), second.x());
+        const TAccumulate minY = std::min(firstY, firstY + deltaY);
+        const TAccumulate maxY = std::max(firstY, firstY + deltaY);
+        if (maxY < blockMinY || minY > blockMaxY)
         {
-            if (impl::EOrientation::collinear
-                == impl::orientation(polygonEdge.first, point, polygonEdge.second))
-            {
-                return impl::onSegment(polygonEdge, point);
-            }
-            if (impl::onSegment(horizontalLine, polygonEdge.second))
-            {
-                if (impl::orientation(point, polygonEdge.second, polygonEdge.first)
-                    == impl::orientation(boundary[(i + 2) % numOfVertex], polygonEdge.second, point))
-                {
-                    ++count;
-                }
-            }
-            ++count;
+            continue;
+        }
+        const bool isUpward = deltaY > 0;
+
+        for (std::size_t j = 0; j < count; ++j)
+        {
+            const auto cross = deltaX * (ys[j] - firstY) - (xs[j] - firstX) * deltaY;
+            const bool isStraddling = (firstY > ys[j]) != (firstY + deltaY > ys[j]);
+            isInside[j] ^= static_cast<std::uint8_t>(isStraddling & ((cross > 0) == isUpward));
+            isOnBoundary[j] |= static_cast<std::uint8_t>((cross == 0)
+                & (xs[j] >= minX) & (xs[j] <= maxX) & (ys[j] >= minY) & (ys[j] <= maxY));
+        }
+    }
+
+    for (std::size_t j = 0; j < count; ++j)
+    {
+        out[j] = isInside[j] | isOnBoundary[j];
+    }
+}
+
+/**
+ * @internal
+ * @brief       Checks the points are inside or on the given closed curve with the given boundary box.
+ *
+ * @details     The points out of the boundary box are rejected, the others are sorted by y-axis
+ *              and tested by blocks, so the blocks have narrow y-axis ranges and most edges
+ *              are skipped for every block.
+ * @tparam TCrt The type of coordinates.
+ * @param boundary The closed piecewise linear curve.
+ * @param box   The boundary box of curve.
+ * @param points The points.
+ * @param out   The results, 1 if contains, otherwise 0.
+ */
+template <typename TCrt>
+void curveContainsBatch(const typename SimplePolygon<TCrt>::TPiecewiseLinearCurve& boundary
+                        , const space::Rect<TCrt>& box
+                        , space::collections::Span<const Point<TCrt>> points
+                        , space::collections::Span<std::uint8_t> out)
+{
+    const auto minX = box.pos().x();
+    const auto minY = box.pos().y();
+    const auto maxX = minX + box.width();
+    const auto maxY = minY + box.height();
+
+    const auto count = std::size(points);
+    space::collections::Vector<std::size_t> candidateIndexes;
+    candidateIndexes.reserve(count);
+    for (std::size_t j = 0; j < count; ++j)
+    {
+        const auto& point = points[j];
+        out[j] = 0;
+        if (point.x() >= minX && point.x() <= maxX && point.y() >= minY && point.y() <= maxY)
+        {
+            candidateIndexes.push_back(j);
         }
+    }
+    std::ranges::sort(candidateIndexes, std::ranges::less {}, [&points](std::size_t j) { return points[j].y(); });
 
-        i = next;
-    } while (i != 0);
+    Point<TCrt> candidates[s_containsBatchBlockSize];
+    std::uint8_t results[s_containsBatchBlockSize];
+    const auto candidateCount = std::size(candidateIndexes);
+    for (std::size_t blockStart = 0; blockStart < candidateCount; blockStart += s_containsBatchBlockSize)
+    {
+        const auto blockSize = std::min(s_containsBatchBlockSize, candidateCount - blockStart);
+        for (std::size_t j = 0; j < blockSize; ++j)
+        {
+            candidates[j] = points[candidateIndexes[blockStart + j]];
+        }
 
-    // Return true if count is odd, false otherwise
-    return count & 1;
+        curveContainsBlock<TCrt>(boundary, {candidates, blockSize}, {results, blockSize});
+        for (std::size_t j = 0; j < blockSize; ++j)
+        {
+            out[candidateIndexes[blockStart + j]] = results[j];
+        }
+    }
+}
+
+} // namespace impl
+
+/**
+ * @brief   Checks every given point is inside or on the edge of the Simple Polygon.
+ *
+ * @details The batch version of space::util::contains with the same results. The points out
+ *          of the boundary box are rejected without visiting the edges, the others are sorted
+ *          by y-axis and tested by blocks of impl::s_containsBatchBlockSize points. Every edge
+ *          overlapping the y-axis range of a block is tested against all points of the block
+ *          by the branch-free crossing test.
+ * @throws  std::out_of_range if the polygon is empty or the output is smaller than the points.
+ * @tparam  TCrt The type of coordinates.
+ * @param   poly The given Simple Polygon.
+ * @param   points The given points.
+ * @param   out The results, out[i] is 1 if the polygon contains points[i], otherwise 0.
+ */
+template <typename TCrt>
+void containsBatch(const SimplePolygon<TCrt>& poly
+                   , space::collections::Span<const Point<TCrt>> points
+                   , space::collections::Span<std::uint8_t> out)
+{
+    if (std::size(out) < std::size(points))
+    {
+        throw std::out_of_range {"The output is smaller than the points."};
+    }
+    impl::curveContainsBatch(poly.boundaryCurve(), boundaryBoxOf(poly), points, out);
 }
 
 namespace impl
@@ -253,11 +452,11 @@ namespace impl
  * @tparam TCrt     TCrt The type of coordinates.
  * @param axis      The axis for projection.
  * @param polygon   The polygon for projection.
- * @return std::pair<TCrt, TCrt> [min, max] interval for projection.
+ * @return std::pair<TAccumulatorOf<TCrt>, TAccumulatorOf<TCrt>> [min, max] interval for projection.
  */
 template <typename TCrt>
 [[nodiscard]]
-constexpr std::pair<TCrt, TCrt> projectPolygon(const Vector<TCrt>& axis, const SimplePolygon<TCrt>& polygon) noexcept
+constexpr std::pair<TAccumulatorOf<TCrt>, TAccumulatorOf<TCrt>> projectPolygon(const Vector<TCrt>& axis, const SimplePolygon<TCrt>& polygon) noexcept
 {
     // To project a point on an axis use the dot product
     auto dotProduct = util::dotProduct(axis, Vector<TCrt>{ polygon.boundaryCurve()[0] });
@@ -323,8 +522,9 @@ constexpr bool polygonEdgesProjectionsOverlaps(const SimplePolygon<TCrt>& first,
     {
         const auto& p1 =  first.boundaryCurve()[edgeIndex];
         const auto& p2 =  first.boundaryCurve()[(edgeIndex + 1) % edgeCountFirst];
-        auto edge = Vector { p2 } - Vector { p1 };
-        Vector axis = util::axisPerpendicularOf(edge);
+        const auto edge = Vector { p2 } - Vector { p1 };
+        // The axis is not normalized, the projections are compared only on the same axis.
+        const Vector axis {-edge.top().y(), edge.top().x()};
 
         if (!impl::polygonProjectionshasIntersect(axis, first, second))
         {
@@ -336,12 +536,447 @@ constexpr bool polygonEdgesProjectionsOverlaps(const SimplePolygon<TCrt>& first,
 
 } // namespace impl
 
+namespace impl
+{
+
+/**
+ * @internal
+ * @brief   The walk over the convex polygon in the counterclockwise order.
+ */
+struct ConvexWalk
+{
+    /**
+     * @brief   The index of the lowest (the leftmost of lowest) vertex.
+     */
+    std::size_t lowest;
+
+    /**
+     * @brief   The index of the highest (the rightmost of highest) vertex.
+     */
+    std::size_t highest;
+
+    /**
+     * @brief   true if the vertices are in the counterclockwise order, otherwise false.
+     */
+    bool isCounterclockwise;
+
+    /**
+     * @brief   Gets the index of the next vertex in the counterclockwise order.
+     */
+    [[nodiscard]]
+    constexpr std::size_t next(std::size_t index, std::size_t vertexCount) const noexcept
+    {
+        if (isCounterclockwise)
+        {
+            return (index + 1 == vertexCount) ? 0 : index + 1;
+        }
+        return (index == 0) ? vertexCount - 1 : index - 1;
+    }
+};
+
+/**
+ * @internal
+ * @brief       Checks the given closed curve bounds a convex polygon with the nonzero area.
+ *
+ * @details     All nonzero turns have the same direction and the x-axis and y-axis directions
+ *              of edges change at most twice, the second condition rejects the self-intersecting
+ *              curves like the pentagram. The repeated vertices and the collinear vertices are
+ *              allowed. The complexity is O(n).
+ * @tparam TCrt The type of coordinates.
+ * @param boundary The closed piecewise linear curve.
+ * @return      The walk over the polygon if it is convex, otherwise std::nullopt.
+ */
+template <typename TCrt>
+[[nodiscard]]
+constexpr std::optional<ConvexWalk> convexWalkOf(const typename SimplePolygon<TCrt>::TPiecewiseLinearCurve& boundary) noexcept
+{
+    const auto vertexCount = std::size(boundary);
+    if (vertexCount < 3)
+    {
+        return std::nullopt;
+    }
+
+    auto directionChanges = [](int& lastDirection, int direction) -> int
+    {
+        if (0 == direction)
+        {
+            return 0;
+        }
+        const int isChanged = (0 != lastDirection && direction != lastDirection);
+        lastDirection = direction;
+        return isChanged;
+    };
+
+    int turn = 0;
+    int lastDirectionX = 0;
+    int lastDirectionY = 0;
+    int changesX = 0;
+    int changesY = 0;
+    std::size_t lowest = 0;
+    std::size_t highest = 0;
+    // The edges are visited twice to count the direction changes over the closing vertex.
+    for (std::size_t k = 0; k < 2 * vertexCount; ++k)
+    {
+        const auto i = k % vertexCount;
+        const auto& current = boundary[i];
+        const auto& next = boundary[(i + 1) % vertexCount];
+        const int directionX = (next.x() > current.x()) - (next.x() < current.x());
+        const int directionY = (next.y() > current.y()) - (next.y() < current.y());
+        const auto isChangedX = directionChanges(lastDirectionX, directionX);
+        const auto isChangedY = directionChanges(lastDirectionY, directionY);
+        if (k < vertexCount)
+        {
+            continue;
+        }
+        changesX += isChangedX;
+        changesY += isChangedY;
+
+        const auto& nextNext = boundary[(i + 2) % vertexCount];
+        const auto sign = orientationSign(current, next, nextNext);
+        if (0 != sign)
+        {
+            if (0 != turn && sign != turn)
+            {
+                return std::nullopt;
+            }
+            turn = sign;
+        }
+
+        if (std::pair {current.y(), current.x()} < std::pair {boundary[lowest].y(), boundary[lowest].x()})
+        {
+            lowest = i;
+        }
+        if (std::pair {current.y(), current.x()} > std::pair {boundary[highest].y(), boundary[highest].x()})
+        {
+            highest = i;
+        }
+    }
+
+    if (0 == turn || changesX > 2 || changesY > 2)
+    {
+        return std::nullopt;
+    }
+    // The positive orientation sign is the clockwise turn, see impl::orientation.
+    return ConvexWalk {lowest, highest, turn < 0};
+}
+
+/**
+ * @internal
+ * @brief       Checks the convex polygons have an intersection or not in O(n + m).
+ *
+ * @details     The polygons intersect if and only if their Minkowski difference contains the
+ *              origin. The edges of the difference are the edges of the first polygon and the
+ *              reversed edges of the second one merged by the polar angle, so the difference is
+ *              walked once without building it and the origin is checked against every edge.
+ * @tparam TCrt The type of coordinates.
+ * @param first The boundary of the first convex polygon.
+ * @param firstWalk The walk over the first polygon.
+ * @param second The boundary of the second convex polygon.
+ * @param secondWalk The walk over the second polygon.
+ * @return      true if polygons have an intersection, otherwise false.
+ */
+template <typename TCrt>
+[[nodiscard]]
+constexpr bool convexHasIntersect(const typename SimplePolygon<TCrt>::TPiecewiseLinearCurve& first
+                                  , const ConvexWalk& firstWalk
+                                  , const typename SimplePolygon<TCrt>::TPiecewiseLinearCurve& second
+                                  , const ConvexWalk& secondWalk) noexcept
+{
+    using TAccumulator = TAccumulatorOf<TCrt>;
+    using TEdge = std::pair<TAccumulator, TAccumulator>;
+
+    // The half of the plane of the edge direction, 0 for the angles in [0, pi), otherwise 1.
+    auto halfOf = [](const TEdge& edge) -> int
+    {
+        return (edge.second < 0 || (edge.second == 0 && edge.first < 0)) ? 1 : 0;
+    };
+    auto isBefore = [&halfOf](const TEdge& lhs, const TEdge& rhs) -> bool
+    {
+        const auto lhsHalf = halfOf(lhs);
+        const auto rhsHalf = halfOf(rhs);
+        if (lhsHalf != rhsHalf)
+        {
+            return lhsHalf < rhsHalf;
+        }
+        return productDifferenceSign(lhs.first, rhs.second, lhs.second, rhs.first) >= 0;
+    };
+
+    const auto firstCount = std::size(first);
+    const auto secondCount = std::size(second);
+
+    // The lowest vertex of the first polygon minus the highest vertex of the second one
+    // is the lowest vertex of the Minkowski difference.
+    auto firstIndex = firstWalk.lowest;
+    auto secondIndex = secondWalk.highest;
+    TAccumulator vertexX = static_cast<TAccumulator>(first[firstIndex].x()) - second[secondIndex].x();
+    TAccumulator vertexY = static_cast<TAccumulator>(first[firstIndex].y()) - second[secondIndex].y();
+
+    std::size_t firstEdges = 0;
+    std::size_t secondEdges = 0;
+    while (firstEdges < firstCount || secondEdges < secondCount)
+    {
+        const auto firstNext = firstWalk.next(firstIndex, firstCount);
+        const auto secondNext = secondWalk.next(secondIndex, secondCount);
+        const TEdge firstEdge {static_cast<TAccumulator>(first[firstNext].x()) - first[firstIndex].x()
+                               , static_cast<TAccumulator>(first[firstNext].y()) - first[firstIndex].y()};
+        const TEdge secondEdge {static_cast<TAccumulator>(second[secondIndex].x()) - second[secondNext].x()
+                                , static_cast<TAccumulator>(second[secondIndex].y()) - second[secondNext].y()};
+
+        // The edges of repeated vertices have no direction, they are skipped before merging.
+        if (firstEdges < firstCount && firstEdge.first == 0 && firstEdge.second == 0)
+        {
+            firstIndex = firstNext;
+            ++firstEdges;
+            continue;
+        }
+        if (secondEdges < secondCount && secondEdge.first == 0 && secondEdge.second == 0)
+        {
+            secondIndex = secondNext;
+            ++secondEdges;
+            continue;
+        }
+
+        const bool isFirst = (secondEdges == secondCount)
+            || (firstEdges < firstCount && isBefore(firstEdge, secondEdge));
+        const auto& edge = isFirst ? firstEdge : secondEdge;
+        if (isFirst)
+        {
+            firstIndex = firstNext;
+            ++firstEdges;
+        }
+        else
+        {
+            secondIndex = secondNext;
+            ++secondEdges;
+        }
+
+        // The origin must be on the left of the edge or on it, cross(edge, origin - vertex) >= 0.
+        if (productDifferenceSign(edge.second, vertexX, edge.first, vertexY) < 0)
+        {
+            return false;
+        }
+        vertexX += edge.first;
+        vertexY += edge.second;
+    }
+    return true;
+}
+
+/**
+ * @internal
+ * @brief       Checks any edge of the first curve intersects any edge of the second curve.
+ *
+ * @details     Only the edges overlapping the given box are considered. The edges are swept by
+ *              ascending minimum y-axis coordinate, every edge is tested against the active edges
+ *              of the other curve overlapping it by the y-axis range, then the x-axis range.
+ * @tparam TCrt The type of coordinates.
+ * @param first The first closed curve.
+ * @param second The second closed curve.
+ * @param clip  The box containing the intersection of curves boundary boxes.
+ * @return      true if edges have an intersection, otherwise false.
+ */
+template <typename TCrt>
+[[nodiscard]]
+bool edgesHaveIntersect(const typename SimplePolygon<TCrt>::TPiecewiseLinearCurve& first
+                        , const typename SimplePolygon<TCrt>::TPiecewiseLinearCurve& second
+                        , const space::Rect<TCrt>& clip)
+{
+    struct SweepEdge
+    {
+        Segment<TCrt> segment;
+        TCrt minX;
+        TCrt maxX;
+        TCrt minY;
+        TCrt maxY;
+        std::uint8_t curve;
+    };
+
+    const auto clipMinX = clip.pos().x();
+    const auto clipMinY = clip.pos().y();
+    const auto clipMaxX = clipMinX + clip.width();
+    const auto clipMaxY = clipMinY + clip.height();
+
+    space::collections::Vector<SweepEdge> edges;
+    auto collect = [&](const typename SimplePolygon<TCrt>::TPiecewiseLinearCurve& curve, std::uint8_t curveIndex)
+    {
+        const auto vertexCount = std::size(curve);
+        for (std::size_t i = 0; i < vertexCount; ++i)
+        {
+            const auto& p = curve[i];
+            const auto& q = (i + 1 == vertexCount) ? curve[0] : curve[i + 1];
+            const SweepEdge edge {Segment<TCrt> {p, q}, std::min(p.x(), q.x()), std::max(p.x(), q.x())
+                                  , std::min(p.y(), q.y()), std::max(p.y(), q.y()), curveIndex};
+            if (edge.maxX >= clipMinX && edge.minX <= clipMaxX && edge.maxY >= clipMinY && edge.minY <= clipMaxY)
+            {
+                edges.push_back(edge);
+            }
+        }
+    };
+    collect(first, 0);
+    collect(second, 1);
+    std::ranges::sort(edges, std::ranges::less {}, &SweepEdge::minY);
+
+    space::collections::Array<space::collections::Vector<const SweepEdge*>, 2> active;
+    for (const auto& edge : edges)
+    {
+        auto& others = active[1 - edge.curve];
+        for (std::size_t i = 0; i < std::size(others);)
+        {
+            if (others[i]->maxY < edge.minY)
+            {
+                others[i] = others.back();
+                others.pop_back();
+                continue;
+            }
+            if (others[i]->maxX >= edge.minX && others[i]->minX <= edge.maxX
+                && hasIntersect(others[i]->segment, edge.segment))
+            {
+                return true;
+            }
+            ++i;
+        }
+        active[edge.curve].push_back(&edge);
+    }
+    return false;
+}
+
+/**
+ * @internal
+ * @brief       Checks the simple polygons have an intersection or not.
+ *
+ * @details     The convex polygons are checked by convexHasIntersect, the others by the edge
+ *              intersections and by the containment of one polygon in the other.
+ * @tparam TCrt The type of coordinates.
+ * @param first The first polygon.
+ * @param firstBox The boundary box of the first polygon.
+ * @param firstWalk The walk over the first polygon if it is convex.
+ * @param second The second polygon.
+ * @param secondBox The boundary box of the second polygon.
+ * @param secondWalk The walk over the second polygon if it is convex.
+ * @return      true if polygons have an intersection, otherwise false.
+ */
+template <typename TCrt>
+[[nodiscard]]
+bool polygonsHaveIntersect(const SimplePolygon<TCrt>& first
+                           , const space::Rect<TCrt>& firstBox
+                           , const std::optional<ConvexWalk>& firstWalk
+                           , const SimplePolygon<TCrt>& second
+                           , const space::Rect<TCrt>& secondBox
+                           , const std::optional<ConvexWalk>& secondWalk)
+{
+    const auto minX = std::max(firstBox.pos().x(), secondBox.pos().x());
+    const auto minY = std::max(firstBox.pos().y(), secondBox.pos().y());
+    const auto maxX = std::min(firstBox.pos().x() + firstBox.width(), secondBox.pos().x() + secondBox.width());
+    const auto maxY = std::min(firstBox.pos().y() + firstBox.height(), secondBox.pos().y() + secondBox.height());
+    if (minX > maxX || minY > maxY)
+    {
+        return false;
+    }
+
+    const auto& firstCurve = first.boundaryCurve();
+    const auto& secondCurve = second.boundaryCurve();
+    if (firstWalk && secondWalk)
+    {
+        return convexHasIntersect<TCrt>(firstCurve, *firstWalk, secondCurve, *secondWalk);
+    }
+
+    return edgesHaveIntersect<TCrt>(firstCurve, secondCurve, space::Rect<TCrt> {{minX, minY}, {maxX, maxY}})
+        || curveContains(firstCurve, secondCurve.front())
+        || curveContains(secondCurve, firstCurve.front());
+}
+
+} // namespace impl
+
+/**
+ * @brief       Checks the simple polygon is convex or not.
+ *
+ * @details     The polygon is convex if all its nonzero turns have the same direction and it
+ *              has the nonzero area. The complexity is O(n).
+ * @tparam TCrt The type of coordinates.
+ * @param poly  The given polygon.
+ * @return      true if the polygon is convex, otherwise false.
+ */
+template <typename TCrt>
+[[nodiscard]]
+constexpr bool isConvex(const SimplePolygon<TCrt>& poly) noexcept
+{
+    return !poly.empty() && impl::convexWalkOf<TCrt>(poly.boundaryCurve()).has_value();
+}
+
+/**
+ * @brief       Checks the boundary of polygon has no self-intersections.
+ *
+ * @details     The adjacent edges may have only the common vertex, the other edges must not
+ *              touch. The check is the Shamos-Hoey sweep over the edges, the complexity is
+ *              O(n log n), so it is cheap enough to validate polygons on ingest. The polygons
+ *              with less than 3 vertices or with the repeated consecutive vertices are not simple.
+ * @tparam TCrt The type of coordinates.
+ * @param poly  The given polygon.
+ * @return      true if the boundary has no self-intersections, otherwise false.
+ */
+template <typename TCrt>
+[[nodiscard]]
+bool isSimple(const SimplePolygon<TCrt>& poly)
+{
+    if (poly.empty() || std::size(poly.boundaryCurve()) < 3)
+    {
+        return false;
+    }
+    const auto& curve = poly.boundaryCurve();
+    const auto vertexCount = std::size(curve);
+
+    space::collections::Vector<Segment<TCrt>> edges(vertexCount);
+    for (std::size_t i = 0; i < vertexCount; ++i)
+    {
+        edges[i] = impl::orderedSegmentOf(Segment<TCrt> {curve[i], curve[(i + 1) % vertexCount]});
+    }
+
+    // The adjacent edges (i, i + 1) share the vertex i + 1, they must not overlap beyond it.
+    auto isIgnored = [&curve, vertexCount](std::size_t lhs, std::size_t rhs)
+    {
+        const auto first = std::min(lhs, rhs);
+        const auto second = std::max(lhs, rhs);
+        std::size_t edge = 0;
+        if (second == first + 1)
+        {
+            edge = first;
+        }
+        else if (0 == first && vertexCount - 1 == second)
+        {
+            edge = second;
+        }
+        else
+        {
+            return false;
+        }
+        const auto& p = curve[edge];
+        const auto& q = curve[(edge + 1) % vertexCount];
+        const auto& r = curve[(edge + 2) % vertexCount];
+        return p != q && q != r
+            && (impl::EOrientation::collinear != impl::orientation(p, q, r)
+                || (!impl::onSegment(Segment<TCrt> {p, q}, r) && !impl::onSegment(Segment<TCrt> {q, r}, p)));
+    };
+    return !impl::sweepHasIntersect<TCrt>(edges, isIgnored);
+}
+
+/**
+ * @brief   Checks the simple polygons have an intersection or not.
+ *
+ * @details The polygons intersect if they have a common point, including the boundary and the
+ *          case when one polygon is inside the other. The convex polygons are checked in O(n + m)
+ *          through the Minkowski difference, the concave polygons are checked by the sweep over
+ *          the edges and the point in polygon test. See PreparedSimplePolygon for the repeated
+ *          checks, it caches the convexity.
+ * @tparam  TCrt The type of coordinates.
+ * @param   first The first polygon.
+ * @param   second The second polygon.
+ * @return  true if polygons have an intersection, otherwise false.
+ */
 template <typename TCrt>
 [[nodiscard]]
-constexpr bool hasIntersect(const SimplePolygon<TCrt>& first, const SimplePolygon<TCrt>& second) noexcept
+bool hasIntersect(const SimplePolygon<TCrt>& first, const SimplePolygon<TCrt>& second)
 {
-    return impl::polygonEdgesProjectionsOverlaps(first, second)
-        && impl::polygonEdgesProjectionsOverlaps(second, first);
+    return impl::polygonsHaveIntersect(first, boundaryBoxOf(first), impl::convexWalkOf<TCrt>(first.boundaryCurve())
+                                       , second, boundaryBoxOf(second), impl::convexWalkOf<TCrt>(second.boundaryCurve()));
 }
 
 } // namespace util
@@ -0,0 +1,212 @@
+/**
+ * @file        SlabPool.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaring the SlabPool class.
+ * @date        14-10-2026
+ * @copyright   Copyright (c) 2026
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <utility>
+
+#include "Definitions.h"
+
+namespace space::collections
+{
+
+/**
+ * @brief   The object pool which keeps objects in the fixed size contiguous slabs.
+ *
+ * @details The objects are addressed by 32-bit indexes instead of pointers. The index
+ *          stays valid until the object is released, the released slots are reused
+ *          through the free list. The slabs are never moved or freed before clear(),
+ *          so references to the pooled objects are stable.
+ *
+ * @tparam  T The type of objects, must be default constructible and move assignable.
+ * @tparam  SlabSize The number of objects in one slab, must be a power of two.
+ */
+template <typename T, std::size_t SlabSize = 256>
+class SlabPool
+{
+    static_assert(SlabSize != 0 && (SlabSize & (SlabSize - 1)) == 0, "SlabSize must be a power of two.");
+
+public:
+    using value_type = T;
+    using index_type = std::uint32_t;
+    using size_type = std::size_t;
+
+    /**
+     * @brief   The index which doesn't address any object.
+     */
+    static constexpr index_type npos = std::numeric_limits<index_type>::max();
+
+    SlabPool() = default;
+
+    ~SlabPool() = default;
+
+    SlabPool(SlabPool&& other) noexcept
+        : m_slabs {std::move(other.m_slabs)}
+        , m_freeList {std::move(other.m_freeList)}
+        , m_end {std::exchange(other.m_end, 0)}
+        , m_size {std::exchange(other.m_size, 0)}
+    {
+    }
+
+    SlabPool& operator=(SlabPool&& other) noexcept
+    {
+        m_slabs = std::move(other.m_slabs);
+        m_freeList = std::move(other.m_freeList);
+        m_end = std::exchange(other.m_end, 0);
+        m_size = std::exchange(other.m_size, 0);
+        return *this;
+    }
+
+    SlabPool(const SlabPool&) = delete;
+
+    SlabPool& operator=(const SlabPool&) = delete;
+
+    /**
+     * @brief   Creates a new object in the pool.
+     *
+     * @details Reuses the last released slot if there is one, otherwise takes the next slot
+     *          of the last slab, allocating a new slab when the last one is full.
+     *
+     * @tparam  TArgs The types of constructor arguments.
+     * @param   args The constructor arguments.
+     * @return  The index of the new object.
+     */
+    template <typename... TArgs>
+    index_type create(TArgs&&... args)
+    {
+        index_type index = npos;
+        if (!m_freeList.empty())
+        {
+            index = m_freeList.back();
+            m_freeList.pop_back();
+        }
+        else
+        {
+            if (0 == (m_end % SlabSize))
+            {
+                m_slabs.push_back(std::make_unique<T[]>(SlabSize));
+            }
+            index = m_end++;
+        }
+        (*this)[index] = T(std::forward<TArgs>(args)...);
+        ++m_size;
+        return index;
+    }
+
+    /**
+     * @brief   Releases the object and returns its slot to the free list.
+     *
+     * @details The object is reset to the default state, so the resources held by it
+     *          are freed immediately.
+     *
+     * @param   index The index of the object.
+     */
+    void release(index_type index)
+    {
+        (*this)[index] = T {};
+        m_freeList.push_back(index);
+        --m_size;
+    }
+
+    /**
+     * @brief   Gets the object by index.
+     *
+     * @param   index The index of the object.
+     * @return  The reference to the object.
+     */
+    [[nodiscard]]
+    T& operator[](index_type index) noexcept
+    {
+        return m_slabs[index / SlabSize][index % SlabSize];
+    }
+
+    /**
+     * @brief   Gets the object by index.
+     *
+     * @param   index The index of the object.
+     * @return  The const reference to the object.
+     */
+    [[nodiscard]]
+    const T& operator[](index_type index) const noexcept
+    {
+        return m_slabs[index / SlabSize][index % SlabSize];
+    }
+
+    /**
+     * @brief   Releases all objects and slabs.
+     *
+     * @details The cost is proportional to the number of slabs, not to the number of objects.
+     */
+    void clear() noexcept
+    {
+        m_slabs.clear();
+        m_freeList.clear();
+        m_end = 0;
+        m_size = 0;
+    }
+
+    /**
+     * @brief   Gets the number of live objects in the pool.
+     *
+     * @return  The number of live objects.
+     */
+    [[nodiscard]]
+    size_type size() const noexcept
+    {
+        return m_size;
+    }
+
+    /**
+     * @brief   Checks the pool has live objects or not.
+     *
+     * @return  true if the pool is empty, otherwise false.
+     */
+    [[nodiscard]]
+    bool empty() const noexcept
+    {
+        return 0 == m_size;
+    }
+
+    /**
+     * @brief   Gets the number of slots in all allocated slabs.
+     *
+     * @return  The number of slots.
+     */
+    [[nodiscard]]
+    size_type capacity() const noexcept
+    {
+        return std::size(m_slabs) * SlabSize;
+    }
+
+private:
+
+    /**
+     * @brief   The slabs of objects.
+     */
+    space::collections::Vector<std::unique_ptr<T[]>> m_slabs {};
+
+    /**
+     * @brief   The indexes of released slots.
+     */
+    space::collections::Vector<index_type> m_freeList {};
+
+    /**
+     * @brief   The index of the first never used slot.
+     */
+    index_type m_end {0};
+
+    /**
+     * @brief   The number of live objects.
+     */
+    size_type m_size {0};
+}; // class SlabPool
+
+} // namespace space::collections
@@ -0,0 +1,377 @@
+/**
+ * @file        SpatialJoin.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaring the spatial join of two quadtrees.
+ * @date        14-10-2026
+ * @copyright   Copyright (c) 2026
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <execution>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "Definitions.h"
+#include "QuadTree.h"
+#include "Utility.h"
+
+namespace space
+{
+
+namespace impl
+{
+
+/**
+ * @internal
+ * @brief   The synchronous traversal of two quadtrees.
+ *
+ * @details The nodes of the same depth are visited in pairs, the pairs with not intersecting
+ *          bounds are pruned. Every node pair joins the values of both nodes, the values of
+ *          one node are joined with the child subtrees of the other node, and the child pairs
+ *          are visited. So every pair of values is tested once, at the pair of the deepest
+ *          common depth of their nodes.
+ */
+struct QuadTreeJoin
+{
+    /**
+     * @brief   The kind of join task.
+     */
+    enum class TaskKind
+    {
+        NodePair        // The subtrees of both nodes.
+        , FirstValues   // The values of first node and the subtree of second node.
+        , SecondValues  // The values of second node and the subtree of first node.
+    };
+
+    /**
+     * @brief   The join task, the node indexes in the first and second trees.
+     */
+    struct Task
+    {
+        std::uint32_t first;
+        std::uint32_t second;
+        TaskKind kind;
+    };
+
+    /**
+     * @brief   The buffers of the values of one node which are joined with the subtree.
+     */
+    template <typename TFirstKey, typename TSecondKey>
+    struct Buffers
+    {
+        space::collections::Vector<const TFirstKey*> firstValues {};
+        space::collections::Vector<const TSecondKey*> secondValues {};
+    };
+
+    /**
+     * @brief   The minimum number of tasks for the parallel join.
+     */
+    static constexpr std::size_t s_minTaskCount = 256;
+
+    /**
+     * @brief   Gets the root of the given tree, nullopt if the tree has no nodes.
+     */
+    template <typename TTree>
+    static std::optional<std::uint32_t> rootOf(const TTree& tree) noexcept
+    {
+        if (TTree::s_nullIndex == tree.m_root)
+        {
+            return std::nullopt;
+        }
+        return tree.m_root;
+    }
+
+    template <typename TFirstTree, typename TSecondTree, typename TBuffers, typename TCallback>
+    static void run(const TFirstTree& first, const TSecondTree& second, const Task& task
+                    , TBuffers& buffers, TCallback& callback)
+    {
+        switch (task.kind)
+        {
+            case TaskKind::NodePair:
+                joinNodes(first, second, task.first, task.second, buffers, callback);
+                break;
+            case TaskKind::FirstValues:
+                joinValuesWithSubtree<false>(first, task.first, second, task.second, buffers.firstValues, callback);
+                break;
+            case TaskKind::SecondValues:
+                joinValuesWithSubtree<true>(second, task.second, first, task.first, buffers.secondValues, callback);
+                break;
+        }
+    }
+
+    /**
+     * @brief   Checks the bounds of the given nodes intersect.
+     */
+    template <typename TFirstTree, typename TSecondTree>
+    static bool hasIntersect(const TFirstTree& first, const TSecondTree& second, std::uint32_t a, std::uint32_t b)
+    {
+        return space::util::hasIntersect(TFirstTree::boundsOf(first.m_nodes[a].region())
+                                         , TSecondTree::boundsOf(second.m_nodes[b].region()));
+    }
+
+    /**
+     * @brief   Joins the values of the given nodes.
+     */
+    template <typename TFirstTree, typename TSecondTree, typename TCallback>
+    static void joinNodeValues(const TFirstTree& first, const TSecondTree& second, std::uint32_t a, std::uint32_t b
+                               , TCallback& callback)
+    {
+        const auto& secondValues = second.m_nodes[b].getValues();
+        if (secondValues.empty())
+        {
+            return;
+        }
+        for (const auto& firstValue : first.m_nodes[a].getValues())
+        {
+            const auto& firstBox = TFirstTree::indexableOf(firstValue);
+            for (const auto& secondValue : secondValues)
+            {
+                if (space::util::hasIntersect(firstBox, TSecondTree::indexableOf(secondValue)))
+                {
+                    callback(firstValue, secondValue);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief   Calls the visitor for the tasks of the given node pair, except for joining
+     *          the node values.
+     */
+    template <typename TFirstTree, typename TSecondTree, typename TVisitor>
+    static void forEachSubtask(const TFirstTree& first, const TSecondTree& second, std::uint32_t a, std::uint32_t b
+                               , TVisitor&& visitor)
+    {
+        const auto& nodeA = first.m_nodes[a];
+        const auto& nodeB = second.m_nodes[b];
+        for (const auto childB : nodeB.getChildren())
+        {
+            if (TSecondTree::s_nullIndex != childB && !nodeA.getValues().empty())
+            {
+                visitor(Task {a, childB, TaskKind::FirstValues});
+            }
+        }
+        for (const auto childA : nodeA.getChildren())
+        {
+            if (TFirstTree::s_nullIndex == childA)
+            {
+                continue;
+            }
+            if (!nodeB.getValues().empty())
+            {
+                visitor(Task {childA, b, TaskKind::SecondValues});
+            }
+            for (const auto childB : nodeB.getChildren())
+            {
+                if (TSecondTree::s_nullIndex != childB)
+                {
+                    visitor(Task {childA, childB, TaskKind::NodePair});
+                }
+            }
+        }
+    }
+
+    template <typename TFirstTree, typename TSecondTree, typename TBuffers, typename TCallback>
+    static void joinNodes(const TFirstTree& first, const TSecondTree& second, std::uint32_t a, std::uint32_t b
+                          , TBuffers& buffers, TCallback& callback)
+    {
+        if (!hasIntersect(first, second, a, b))
+        {
+            return;
+        }
+        joinNodeValues(first, second, a, b, callback);
+        forEachSubtask(first, second, a, b, [&first, &second, &buffers, &callback](const Task& task)
+        {
+            run(first, second, task, buffers, callback);
+        });
+    }
+
+    /**
+     * @brief   Joins the values of the given node with the subtree of the other tree.
+     *
+     * @tparam  IsSwapped true if the values are from the second tree.
+     */
+    template <bool IsSwapped, typename TValuesTree, typename TTree, typename TValue, typename TCallback>
+    static void joinValuesWithSubtree(const TValuesTree& valuesTree, std::uint32_t valuesNode, const TTree& tree
+                                      , std::uint32_t node, space::collections::Vector<const TValue*>& active
+                                      , TCallback& callback)
+    {
+        active.clear();
+        for (const auto& value : valuesTree.m_nodes[valuesNode].getValues())
+        {
+            active.push_back(std::addressof(value));
+        }
+        joinActive<IsSwapped, TValuesTree>(active, 0, tree, node, callback);
+    }
+
+    /**
+     * @brief   Joins the active values [frameBegin, end) with the subtree.
+     *
+     * @details The values intersecting the node bounds are appended as the frame for the
+     *          children, the frame is truncated after them, so the buffer is used as a stack.
+     */
+    template <bool IsSwapped, typename TValuesTree, typename TTree, typename TValue, typename TCallback>
+    static void joinActive(space::collections::Vector<const TValue*>& active, std::size_t frameBegin
+                           , const TTree& tree, std::uint32_t node, TCallback& callback)
+    {
+        const auto& currentNode = tree.m_nodes[node];
+        const auto bounds = TTree::boundsOf(currentNode.region());
+        const auto frameEnd = std::size(active);
+        for (auto i = frameBegin; i < frameEnd; ++i)
+        {
+            if (space::util::hasIntersect(TValuesTree::indexableOf(*active[i]), bounds))
+            {
+                active.push_back(active[i]);
+            }
+        }
+        if (frameEnd == std::size(active))
+        {
+            return;
+        }
+        for (const auto& value : currentNode.getValues())
+        {
+            const auto& box = TTree::indexableOf(value);
+            for (auto i = frameEnd; i < std::size(active); ++i)
+            {
+                if (space::util::hasIntersect(TValuesTree::indexableOf(*active[i]), box))
+                {
+                    if constexpr (IsSwapped)
+                    {
+                        callback(value, *active[i]);
+                    }
+                    else
+                    {
+                        callback(*active[i], value);
+                    }
+                }
+            }
+        }
+        for (const auto child : currentNode.getChildren())
+        {
+            if (TTree::s_nullIndex != child)
+            {
+                joinActive<IsSwapped, TValuesTree>(active, frameEnd, tree, child, callback);
+            }
+        }
+        active.resize(frameEnd);
+    }
+};
+
+} // namespace impl
+
+/**
+ * @brief   Finds all pairs of intersecting values of two quadtrees.
+ *
+ * @details The trees are traversed together from their roots, so the upper levels of the second
+ *          tree are not walked for every value of the first tree as the loop of queries does.
+ *
+ * @tparam  TFirstKey The type of values of the first tree.
+ * @tparam  TFirstPolicy The policy of the first tree.
+ * @tparam  TSecondKey The type of values of the second tree.
+ * @tparam  TSecondPolicy The policy of the second tree.
+ * @tparam  TCallback The type of callback, called as callback(firstValue, secondValue).
+ * @param   first The first tree.
+ * @param   second The second tree.
+ * @param   callback The callback for every intersecting pair.
+ */
+template <typename TFirstKey, typename TFirstPolicy, typename TSecondKey, typename TSecondPolicy, typename TCallback>
+void spatialJoin(const QuadTree<TFirstKey, TFirstPolicy>& first, const QuadTree<TSecondKey, TSecondPolicy>& second
+                 , TCallback&& callback)
+{
+    using TJoin = impl::QuadTreeJoin;
+    const auto firstRoot = TJoin::rootOf(first);
+    const auto secondRoot = TJoin::rootOf(second);
+    if (!firstRoot || !secondRoot)
+    {
+        return;
+    }
+    TJoin::Buffers<TFirstKey, TSecondKey> buffers;
+    TJoin::joinNodes(first, second, *firstRoot, *secondRoot, buffers, callback);
+}
+
+/**
+ * @brief   Finds all pairs of intersecting values of two quadtrees, the subtrees are joined
+ *          in parallel by the given execution policy.
+ *
+ * @details The node pairs are expanded level by level until there are enough tasks, then
+ *          the tasks are joined in parallel and their pairs are concatenated.
+ *
+ * @tparam  TExecutionPolicy The type of execution policy.
+ * @param   policy The execution policy.
+ * @param   first The first tree.
+ * @param   second The second tree.
+ * @return  The intersecting pairs (first value, second value).
+ */
+template <typename TExecutionPolicy, typename TFirstKey, typename TFirstPolicy, typename TSecondKey, typename TSecondPolicy>
+    requires std::is_execution_policy_v<std::remove_cvref_t<TExecutionPolicy>>
+space::collections::Vector<std::pair<TFirstKey, TSecondKey>> spatialJoin(TExecutionPolicy&& policy
+    , const QuadTree<TFirstKey, TFirstPolicy>& first, const QuadTree<TSecondKey, TSecondPolicy>& second)
+{
+    using TJoin = impl::QuadTreeJoin;
+    using TPairs = space::collections::Vector<std::pair<TFirstKey, TSecondKey>>;
+    TPairs pairs;
+    const auto firstRoot = TJoin::rootOf(first);
+    const auto secondRoot = TJoin::rootOf(second);
+    if (!firstRoot || !secondRoot)
+    {
+        return pairs;
+    }
+
+    const auto collect = [&pairs](const TFirstKey& firstValue, const TSecondKey& secondValue)
+    {
+        pairs.emplace_back(firstValue, secondValue);
+    };
+    space::collections::Vector<TJoin::Task> tasks {{*firstRoot, *secondRoot, TJoin::TaskKind::NodePair}};
+    for (bool isExpanded = true; isExpanded && std::size(tasks) < TJoin::s_minTaskCount;)
+    {
+        isExpanded = false;
+        space::collections::Vector<TJoin::Task> nextTasks;
+        for (const auto& task : tasks)
+        {
+            if (TJoin::TaskKind::NodePair != task.kind)
+            {
+                nextTasks.push_back(task);
+                continue;
+            }
+            if (TJoin::hasIntersect(first, second, task.first, task.second))
+            {
+                TJoin::joinNodeValues(first, second, task.first, task.second, collect);
+                TJoin::forEachSubtask(first, second, task.first, task.second, [&nextTasks](const TJoin::Task& subtask)
+                {
+                    nextTasks.push_back(subtask);
+                });
+                isExpanded = true;
+            }
+        }
+        tasks = std::move(nextTasks);
+    }
+
+    space::collections::Vector<TPairs> taskPairs(std::size(tasks));
+    space::collections::Vector<std::size_t> indexes(std::size(tasks));
+    std::iota(indexes.begin(), indexes.end(), std::size_t {0});
+    std::for_each(std::forward<TExecutionPolicy>(policy), indexes.begin(), indexes.end()
+        , [&first, &second, &tasks, &taskPairs](const std::size_t index)
+    {
+        const auto& task = tasks[index];
+        auto& output = taskPairs[index];
+        auto taskCollect = [&output](const TFirstKey& firstValue, const TSecondKey& secondValue)
+        {
+            output.emplace_back(firstValue, secondValue);
+        };
+        TJoin::Buffers<TFirstKey, TSecondKey> buffers;
+        TJoin::run(first, second, task, buffers, taskCollect);
+    });
+    for (const auto& output : taskPairs)
+    {
+        pairs.insert(pairs.end(), output.begin(), output.end());
+    }
+    return pairs;
+}
+
+} // namespace space
@@ -48,7 +48,7 @@ public:
 
     constexpr Square& operator=(const Square&) noexcept = default;
 
-    constexpr std::strong_ordering operator<=>(const Square<TCrt>&) const noexcept = default;
+    constexpr auto operator<=>(const Square<TCrt>&) const noexcept = default;
 
     /**
      * @brief   Initializes a new instance of the Square structure that has the specified
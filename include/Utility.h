@@ -44,6 +44,49 @@ constexpr TRetVal distance(const Point<TCrt>& first, const Point<TCrt>& second)
     return std::sqrt(xDelta * xDelta + yDelta * yDelta);
 }
 
+/**
+ * @brief   Compute the squared distance between the given orthogonal shape and the point.
+ *
+ * @details The distance is zero if the point is inside or on the edge of the shape.
+ *
+ * @tparam  TOrthogonalShape The type of orthogonal object.
+ * @tparam  TCrt The type of coordinates.
+ * @tparam  TRetVal The type of return value (by default TCrt)
+ * @param   shape The orthogonal shape.
+ * @param   point The point.
+ * @return  The computed squared distance.
+ */
+template <typename TOrthogonalShape, typename TCrt, typename TRetVal = TCrt>
+[[nodiscard]]
+constexpr TRetVal squaredDistance(const TOrthogonalShape& shape, const Point<TCrt>& point) noexcept
+{
+    const auto[x1, y1] = bottomLeftOf(shape);
+    const auto[x2, y2] = topRightOf(shape);
+    const auto[px, py] = point;
+    const auto xDelta = (px < x1) ? TRetVal(x1) - TRetVal(px) : ((x2 < px) ? TRetVal(px) - TRetVal(x2) : TRetVal {});
+    const auto yDelta = (py < y1) ? TRetVal(y1) - TRetVal(py) : ((y2 < py) ? TRetVal(py) - TRetVal(y2) : TRetVal {});
+    return xDelta * xDelta + yDelta * yDelta;
+}
+
+/**
+ * @brief   Compute the distance between the given orthogonal shape and the point.
+ *
+ * @details The distance is zero if the point is inside or on the edge of the shape.
+ *
+ * @tparam  TOrthogonalShape The type of orthogonal object.
+ * @tparam  TCrt The type of coordinates.
+ * @tparam  TRetVal The type of return value (by default TCrt)
+ * @param   shape The orthogonal shape.
+ * @param   point The point.
+ * @return  The computed distance.
+ */
+template <typename TOrthogonalShape, typename TCrt, typename TRetVal = TCrt>
+[[nodiscard]]
+constexpr TRetVal distance(const TOrthogonalShape& shape, const Point<TCrt>& point) noexcept
+{
+    return static_cast<TRetVal>(std::sqrt(squaredDistance<TOrthogonalShape, TCrt, double>(shape, point)));
+}
+
 /**
  * @brief Returns true if the given rectangles hes intersects
  *          (i.e., there is at least one pixel that is within both rectangles),
@@ -6,6 +6,9 @@
  * @copyright Copyright (c) 2021
  */
 
+#pragma once
+
+#include "Accumulator.h"
 #include "Point.h"
 
 namespace space
@@ -98,11 +101,21 @@ constexpr Vector<TCrt> operator-(const Vector<TCrt>& lhs, const Vector<TCrt>& rh
 namespace util
 {
 
+/**
+ * @brief           Returns the dot product of given vectors.
+ *
+ * @tparam TCrt     TCrt The type of coordinates.
+ * @param first     The first vector.
+ * @param second    The second vector.
+ * @return          The dot product in the accumulator type, so it doesn't overflow.
+ */
 template <typename TCrt>
 [[nodiscard]]
-constexpr TCrt dotProduct(const Vector<TCrt>& first, const Vector<TCrt>& second) noexcept
+constexpr TAccumulatorOf<TCrt> dotProduct(const Vector<TCrt>& first, const Vector<TCrt>& second) noexcept
 {
-    return first.top().x() * second.top().x() + first.top().y() * second.top().y();
+    using TAccumulator = TAccumulatorOf<TCrt>;
+    return static_cast<TAccumulator>(first.top().x()) * second.top().x()
+        + static_cast<TAccumulator>(first.top().y()) * second.top().y();
 }
 
 /**
@@ -116,7 +129,7 @@ template <typename TCrt>
 [[nodiscard]]
 constexpr TCrt absoluteValue(const Vector<TCrt>& vector) noexcept
 {
-    return std::sqrt(vector.top().x() * vector.top().x() + vector.top().y() * vector.top().y());
+    return static_cast<TCrt>(std::sqrt(static_cast<long double>(dotProduct(vector, vector))));
 }
 
 /**
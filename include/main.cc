@@ -6,3 +6,23 @@
 #include "SimplePolygon.h"
 #include "Polygon.h"
 #include "Segment.h"
+#include "SlabPool.h"
+#include "InlineStack.h"
+#include "QuadTreePolicy.h"
+#include "BoxColumns.h"
+#include "Indexable.h"
+#include "PolygonLayer.h"
+#include "PreparedPolygon.h"
+#include "EdgeBands.h"
+#include "Accumulator.h"
+#include "SegmentSweep.h"
+#include "QuadTreeSnapshot.h"
+#include "EpochDomain.h"
+#include "ConcurrentQuadTree.h"
+#include "ShardedQuadTree.h"
+#include "LinearQuadTree.h"
+#include "SpatialJoin.h"
+#include "QuadTreeStats.h"
+#include "BoundedQueue.h"
+#include "QuadTreeBuilder.h"
+#include "QueryCache.h"
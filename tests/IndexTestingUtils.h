@@ -5,7 +5,17 @@
 
 #include <random>
 #include <algorithm>
+#include <execution>
 #include <iostream>
+#include <numeric>
+#include <ranges>
+#include <filesystem>
+#include <string>
+#include <thread>
+
+#if __has_include(<unistd.h>)
+#include <unistd.h>
+#endif
 
 #include <boost/geometry/geometries/point.hpp>
 #include <boost/geometry/geometries/box.hpp>
@@ -13,7 +23,14 @@
 
 #include "Rect.h"
 #include "Square.h"
+#include "SimplePolygon.h"
 #include "QuadTree.h"
+#include "ConcurrentQuadTree.h"
+#include "LinearQuadTree.h"
+#include "ShardedQuadTree.h"
+#include "SpatialJoin.h"
+#include "QuadTreeBuilder.h"
+#include "QueryCache.h"
 #include "Utility.h"
 
 namespace test_util
@@ -126,6 +143,416 @@ void queryTest(TCrt maxPos, TCrt maxRectWidth, TCrt maxRectHeight)
     }
 }
 
+template <typename TIndex, typename TCrt, size_t Count>
+void bulkLoadTest(TCrt maxPos, TCrt maxRectWidth, TCrt maxRectHeight)
+{
+    std::vector<space::Rect<TCrt>> initialRects;
+    for (size_t i = 0; i < Count; ++i)
+    {
+        initialRects.push_back(getRandRect(maxPos, maxRectWidth, maxRectHeight));
+    }
+    const std::set<space::Rect<TCrt>> uniqueRects(initialRects.begin(), initialRects.end());
+
+    // Loading in two parts, the second part is merged into the already built tree.
+    const auto middle = initialRects.begin() + static_cast<std::ptrdiff_t>(Count / 2);
+    TIndex index {std::ranges::subrange(initialRects.begin(), middle)};
+    index.bulkLoad(std::ranges::subrange(middle, initialRects.end()));
+    ASSERT_EQ(index.bulkLoad(initialRects), 0);
+    ASSERT_EQ(index.size(), uniqueRects.size());
+
+    TIndex expectedIndex;
+    for (const auto& rect : initialRects)
+    {
+        ASSERT_TRUE(index.contains(rect));
+        expectedIndex.insert(rect);
+    }
+
+    for (size_t i = 0; i < Count; ++i)
+    {
+        space::Rect<TCrt> queryRect {getRandRect(maxPos, maxRectWidth, maxRectHeight)};
+
+        std::vector<space::Rect<TCrt>> queryRes;
+        index.query(queryRect, std::back_inserter(queryRes));
+        std::vector<space::Rect<TCrt>> expectedRes;
+        expectedIndex.query(queryRect, std::back_inserter(expectedRes));
+
+        std::ranges::sort(queryRes);
+        std::ranges::sort(expectedRes);
+        ASSERT_TRUE(queryRes == expectedRes);
+    }
+}
+
+template <typename TIndex, typename TCrt, size_t Count>
+void arbitraryOriginTest(TIndex index, space::Point<TCrt> origin, TCrt maxPos, TCrt maxRectWidth, TCrt maxRectHeight)
+{
+    const auto getRandRectAroundOrigin = [&]()
+    {
+        auto rect = getRandRect(maxPos, maxRectWidth, maxRectHeight);
+        rect.setPos({origin.x() + rect.pos().x() - maxPos / 2, origin.y() + rect.pos().y() - maxPos / 2});
+        return rect;
+    };
+
+    std::set<space::Rect<TCrt>> initialRects;
+    for (size_t i = 0; i < Count; ++i)
+    {
+        initialRects.insert(getRandRectAroundOrigin());
+    }
+
+    for (const auto& rect : initialRects)
+    {
+        ASSERT_TRUE(index.insert(rect));
+    }
+    ASSERT_EQ(index.size(), initialRects.size());
+
+    for (const auto& rect : initialRects)
+    {
+        ASSERT_TRUE(index.contains(rect));
+    }
+
+    for (size_t i = 0; i < Count; ++i)
+    {
+        const auto queryRect = getRandRectAroundOrigin();
+
+        std::vector<space::Rect<TCrt>> queryRes;
+        index.query(queryRect, std::back_inserter(queryRes));
+        std::vector<space::Rect<TCrt>> expectedRes;
+        std::ranges::copy_if(initialRects, std::back_inserter(expectedRes), [&queryRect](const auto& rect)
+        {
+            return space::util::hasIntersect(queryRect, rect);
+        });
+
+        std::ranges::sort(queryRes);
+        ASSERT_TRUE(queryRes == expectedRes);
+    }
+
+    for (const auto& rect : initialRects)
+    {
+        index.remove(rect);
+        ASSERT_FALSE(index.contains(rect));
+    }
+    ASSERT_EQ(index.size(), 0);
+}
+
+template <typename TIndex, typename TCrt, size_t Count>
+void coordinateLimitsTest(TCrt maxRectWidth, TCrt maxRectHeight)
+{
+    constexpr auto lowest = std::numeric_limits<TCrt>::lowest();
+    constexpr auto max = std::numeric_limits<TCrt>::max();
+    std::mt19937 generator {42};
+    std::uniform_int_distribution<TCrt> xDistribution {lowest, static_cast<TCrt>(max - maxRectWidth)};
+    std::uniform_int_distribution<TCrt> yDistribution {lowest, static_cast<TCrt>(max - maxRectHeight)};
+    std::uniform_int_distribution<TCrt> widthDistribution {0, maxRectWidth};
+    std::uniform_int_distribution<TCrt> heightDistribution {0, maxRectHeight};
+    const auto getRandRectInRange = [&]()
+    {
+        return space::Rect<TCrt> {{xDistribution(generator), yDistribution(generator)}
+                                  , widthDistribution(generator), heightDistribution(generator)};
+    };
+
+    // The corners of the range and of the zero-centred world make the root grow toward
+    // both ends of the coordinates.
+    std::set<space::Rect<TCrt>> initialRects {
+        space::Rect<TCrt> {{lowest, lowest}, 0, 0}
+        , space::Rect<TCrt> {{static_cast<TCrt>(max - 1), static_cast<TCrt>(max - 1)}, 1, 1}
+        , space::Rect<TCrt> {{lowest, static_cast<TCrt>(max - 1)}, 1, 1}
+        , space::Rect<TCrt> {{-1'000'000'000, -1'000'000'000}, 0, 0}
+        , space::Rect<TCrt> {{1'000'000'000, 1'000'000'000}, 0, 0}
+        , space::Rect<TCrt> {{-1'000'000'000, 1'000'000'000}, 0, 0}};
+    while (initialRects.size() < Count)
+    {
+        initialRects.insert(getRandRectInRange());
+    }
+
+    TIndex index;
+    for (const auto& rect : initialRects)
+    {
+        ASSERT_TRUE(index.insert(rect));
+    }
+    ASSERT_EQ(index.size(), initialRects.size());
+
+    for (const auto& rect : initialRects)
+    {
+        ASSERT_TRUE(index.contains(rect));
+    }
+
+    for (size_t i = 0; i < Count; ++i)
+    {
+        const auto[x, y] = getRandRectInRange().pos();
+        const auto clippedQuery = space::Rect<TCrt> {{x, y}
+            , static_cast<TCrt>(std::min<std::int64_t>(max / 4, std::int64_t {max} - x))
+            , static_cast<TCrt>(std::min<std::int64_t>(max / 4, std::int64_t {max} - y))};
+
+        std::vector<space::Rect<TCrt>> queryRes;
+        index.query(clippedQuery, std::back_inserter(queryRes));
+        std::vector<space::Rect<TCrt>> expectedRes;
+        std::ranges::copy_if(initialRects, std::back_inserter(expectedRes), [&clippedQuery](const auto& rect)
+        {
+            return space::util::hasIntersect(clippedQuery, rect);
+        });
+
+        std::ranges::sort(queryRes);
+        ASSERT_TRUE(queryRes == expectedRes);
+    }
+
+    for (const auto& rect : initialRects)
+    {
+        index.remove(rect);
+        ASSERT_FALSE(index.contains(rect));
+    }
+    ASSERT_EQ(index.size(), 0);
+}
+
+template <typename TIndex, typename TCrt, size_t Count>
+void floatingRangeTest(TCrt maxPos, TCrt maxRectSize)
+{
+    std::mt19937 generator {42};
+    std::uniform_real_distribution<TCrt> posDistribution {-maxPos, maxPos};
+    std::uniform_real_distribution<TCrt> sizeDistribution {0, maxRectSize};
+    const auto getRandRectInRange = [&]()
+    {
+        return space::Rect<TCrt> {{posDistribution(generator), posDistribution(generator)}
+                                  , sizeDistribution(generator), sizeDistribution(generator)};
+    };
+
+    // The keys are inserted in the random order, so the root grows toward both ends of the range.
+    std::set<space::Rect<TCrt>> initialRects;
+    std::vector<space::Rect<TCrt>> insertionOrder;
+    while (initialRects.size() < Count)
+    {
+        const auto rect = getRandRectInRange();
+        if (initialRects.insert(rect).second)
+        {
+            insertionOrder.push_back(rect);
+        }
+    }
+
+    TIndex index;
+    for (const auto& rect : insertionOrder)
+    {
+        ASSERT_TRUE(index.insert(rect));
+    }
+    ASSERT_EQ(index.size(), initialRects.size());
+
+    for (const auto& rect : initialRects)
+    {
+        ASSERT_TRUE(index.contains(rect));
+    }
+
+    for (size_t i = 0; i < Count / 10; ++i)
+    {
+        const auto queryRect = space::Rect<TCrt> {getRandRectInRange().pos(), maxPos / 10, maxPos / 10};
+
+        std::vector<space::Rect<TCrt>> queryRes;
+        index.query(queryRect, std::back_inserter(queryRes));
+        std::vector<space::Rect<TCrt>> expectedRes;
+        std::ranges::copy_if(initialRects, std::back_inserter(expectedRes), [&queryRect](const auto& rect)
+        {
+            return space::util::hasIntersect(queryRect, rect);
+        });
+
+        std::ranges::sort(queryRes);
+        ASSERT_TRUE(queryRes == expectedRes);
+    }
+
+    // The compacted root stays on the grid of roots, the tree grows up from it exactly.
+    std::size_t removedCount = 0;
+    for (auto it = initialRects.begin(); it != initialRects.end(); ++removedCount)
+    {
+        if (0 == removedCount % 2 || 0 > it->pos().x())
+        {
+            index.remove(*it);
+            it = initialRects.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    index.compact();
+    const space::Rect<TCrt> farRect {{-maxPos, -maxPos}, 0, 0};
+    ASSERT_TRUE(index.insert(farRect));
+    initialRects.insert(farRect);
+
+    for (const auto& rect : initialRects)
+    {
+        ASSERT_TRUE(index.contains(rect));
+        index.remove(rect);
+        ASSERT_FALSE(index.contains(rect));
+    }
+    ASSERT_EQ(index.size(), 0);
+}
+
+template <typename TIndex, typename TCrt, size_t Count>
+void batchQueryTest(TCrt maxPos, TCrt maxRectWidth, TCrt maxRectHeight)
+{
+    TIndex index;
+    for (size_t i = 0; i < Count; ++i)
+    {
+        index.insert(getRandRect(maxPos, maxRectWidth, maxRectHeight));
+    }
+
+    std::vector<space::Rect<TCrt>> queryRects;
+    for (size_t i = 0; i < Count; ++i)
+    {
+        queryRects.push_back(getRandRect(maxPos, maxRectWidth, maxRectHeight));
+    }
+
+    const auto result = index.queryBatch(queryRects);
+    const auto sequentialResult = index.queryBatch(std::execution::seq, queryRects);
+    ASSERT_EQ(result.size(), Count);
+    ASSERT_TRUE(result.offsets == sequentialResult.offsets);
+    ASSERT_TRUE(result.values == sequentialResult.values);
+
+    for (size_t i = 0; i < Count; ++i)
+    {
+        std::vector<space::Rect<TCrt>> batchRes(result[i].begin(), result[i].end());
+        std::vector<space::Rect<TCrt>> expectedRes;
+        index.query(queryRects[i], std::back_inserter(expectedRes));
+
+        std::ranges::sort(batchRes);
+        std::ranges::sort(expectedRes);
+        ASSERT_TRUE(batchRes == expectedRes);
+    }
+
+    ASSERT_EQ(index.queryBatch({}).size(), 0);
+    ASSERT_EQ(TIndex {}.queryBatch(queryRects).values.size(), 0);
+}
+
+template <typename TIndex, typename TCrt, size_t Count>
+void nearestTest(TCrt maxPos, TCrt maxRectWidth, TCrt maxRectHeight)
+{
+    std::set<space::Rect<TCrt>> initialRects;
+    TIndex index;
+    for (size_t i = 0; i < Count; ++i)
+    {
+        const auto rect = getRandRect(maxPos, maxRectWidth, maxRectHeight);
+        initialRects.insert(rect);
+        index.insert(rect);
+    }
+
+    for (const size_t k : {size_t {1}, size_t {10}, Count / 10, Count + 1})
+    {
+        const auto point = getRandPoint(maxPos);
+        std::vector<space::Rect<TCrt>> nearestRes;
+        index.nearest(point, k, std::back_inserter(nearestRes));
+
+        std::vector<double> expectedDistances;
+        for (const auto& rect : initialRects)
+        {
+            expectedDistances.push_back(space::util::squaredDistance<space::Rect<TCrt>, TCrt, double>(rect, point));
+        }
+        std::ranges::sort(expectedDistances);
+        expectedDistances.resize(std::min(k, expectedDistances.size()));
+
+        std::vector<double> distances;
+        for (const auto& rect : nearestRes)
+        {
+            distances.push_back(space::util::squaredDistance<space::Rect<TCrt>, TCrt, double>(rect, point));
+        }
+        ASSERT_TRUE(std::ranges::is_sorted(distances));
+        ASSERT_TRUE(distances == expectedDistances);
+    }
+
+    std::vector<space::Rect<TCrt>> emptyRes;
+    TIndex {}.nearest(getRandPoint(maxPos), 10, std::back_inserter(emptyRes));
+    ASSERT_TRUE(emptyRes.empty());
+}
+
+template <typename TIndex, typename TCrt, size_t Count>
+void queryRangeTest(TCrt maxPos, TCrt maxRectWidth, TCrt maxRectHeight)
+{
+    static_assert(std::ranges::input_range<decltype(std::declval<const TIndex&>().queryRange({}))>);
+    static_assert(std::ranges::view<decltype(std::declval<const TIndex&>().queryRange({}))>);
+
+    TIndex index;
+    for (size_t i = 0; i < Count; ++i)
+    {
+        index.insert(getRandRect(maxPos, maxRectWidth, maxRectHeight));
+    }
+
+    for (size_t i = 0; i < Count; ++i)
+    {
+        const auto queryRect = getRandRect(maxPos, maxRectWidth, maxRectHeight);
+
+        std::vector<space::Rect<TCrt>> expectedRes;
+        index.query(queryRect, std::back_inserter(expectedRes));
+        std::vector<space::Rect<TCrt>> rangeRes;
+        std::ranges::copy(index.queryRange(queryRect), std::back_inserter(rangeRes));
+
+        std::ranges::sort(rangeRes);
+        std::ranges::sort(expectedRes);
+        ASSERT_TRUE(rangeRes == expectedRes);
+        ASSERT_EQ(index.queryCount(queryRect), expectedRes.size());
+        ASSERT_EQ(index.queryAny(queryRect), !expectedRes.empty());
+
+        auto firstRes = index.queryRange(queryRect) | std::views::take(1);
+        ASSERT_EQ(std::ranges::distance(firstRes), expectedRes.empty() ? 0 : 1);
+    }
+
+    const TIndex emptyIndex;
+    const space::Rect<TCrt> rect {{13, 13}, 13, 13};
+    ASSERT_EQ(std::ranges::distance(emptyIndex.queryRange(rect)), 0);
+    ASSERT_FALSE(emptyIndex.queryAny(rect));
+    ASSERT_EQ(emptyIndex.queryCount(rect), 0);
+}
+
+template <typename TCrt, size_t Count>
+void indexablePolygonsTest(TCrt maxPos, TCrt maxPolygonSize)
+{
+    using TPolygon = space::SimplePolygon<TCrt>;
+    using TValue = std::pair<space::Rect<TCrt>, uint32_t>;
+
+    std::vector<TPolygon> polygons;
+    for (size_t i = 0; i < Count; ++i)
+    {
+        const auto origin = getRandPoint(maxPos);
+        typename TPolygon::TPiecewiseLinearCurve curve;
+        for (int vertex = 0; vertex < 5; ++vertex)
+        {
+            curve.push_back({origin.x() + rand(0, maxPolygonSize), origin.y() + rand(0, maxPolygonSize)});
+        }
+        polygons.emplace_back(curve);
+    }
+
+    space::QuadTree<TValue> index;
+    for (uint32_t id = 0; id < polygons.size(); ++id)
+    {
+        ASSERT_TRUE(index.insert(space::util::makeIndexable(polygons[id], id)));
+    }
+    ASSERT_EQ(index.size(), polygons.size());
+
+    for (size_t i = 0; i < Count; ++i)
+    {
+        const auto queryRect = getRandRect(maxPos, maxPolygonSize, maxPolygonSize);
+        std::vector<uint32_t> ids;
+        for (const auto& [box, id] : index.queryRange(queryRect))
+        {
+            ASSERT_TRUE(box == space::util::boundaryBoxOf(polygons[id]));
+            ids.push_back(id);
+        }
+
+        std::vector<uint32_t> expectedIds;
+        for (uint32_t id = 0; id < polygons.size(); ++id)
+        {
+            if (space::util::hasIntersect(queryRect, space::util::boundaryBoxOf(polygons[id])))
+            {
+                expectedIds.push_back(id);
+            }
+        }
+        std::ranges::sort(ids);
+        ASSERT_TRUE(ids == expectedIds);
+    }
+
+    for (uint32_t id = 0; id < polygons.size(); id += 2)
+    {
+        const auto value = space::util::makeIndexable(polygons[id], id);
+        ASSERT_TRUE(index.contains(value));
+        index.remove(value);
+        ASSERT_FALSE(index.contains(value));
+    }
+    ASSERT_EQ(index.size(), polygons.size() / 2);
+}
+
 template <typename TIndex, typename TCrt, size_t Count>
 void removeTest(TCrt maxPos, TCrt maxRectWidth, TCrt maxRectHeight)
 {
@@ -228,4 +655,895 @@ void sizeTest(TCrt maxPos, TCrt maxRectWidth, TCrt maxRectHeight)
     }
 }
 
+#ifdef SPACE_HAS_MMAP
+template <typename TIndex, typename TCrt, size_t Count>
+void snapshotTest(TCrt maxPos, TCrt maxRectWidth, TCrt maxRectHeight)
+{
+    const auto path = std::filesystem::temp_directory_path()
+        / ("quadtree_snapshot_" + std::to_string(::getpid()) + "_" + std::to_string(std::rand()) + ".bin");
+
+    TIndex index;
+    index.save(path);
+    {
+        const auto mapped = TIndex::openMapped(path);
+        ASSERT_TRUE(mapped.empty());
+        ASSERT_FALSE(mapped.queryAny(getRandRect(maxPos, maxRectWidth, maxRectHeight)));
+    }
+
+    for (size_t i = 0; i < Count; ++i)
+    {
+        index.insert(getRandRect(maxPos, maxRectWidth, maxRectHeight));
+    }
+    for (size_t i = 0; i < Count / 10; ++i)
+    {
+        index.remove(getRandRect(maxPos, maxRectWidth, maxRectHeight));
+    }
+    index.save(path);
+    const auto mapped = TIndex::openMapped(path);
+    ASSERT_EQ(index.size(), mapped.size());
+
+    for (size_t i = 0; i < Count; ++i)
+    {
+        const auto queryRect = getRandRect(maxPos, maxRectWidth, maxRectHeight);
+        std::vector<space::Rect<TCrt>> expected;
+        index.query(queryRect, std::back_inserter(expected));
+        std::vector<space::Rect<TCrt>> found;
+        mapped.query(queryRect, std::back_inserter(found));
+        std::ranges::sort(expected);
+        std::ranges::sort(found);
+        ASSERT_EQ(expected, found);
+        ASSERT_EQ(index.queryCount(queryRect), mapped.queryCount(queryRect));
+        ASSERT_EQ(index.queryAny(queryRect), mapped.queryAny(queryRect));
+        ASSERT_EQ(index.contains(queryRect), mapped.contains(queryRect));
+    }
+
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    ASSERT_THROW(static_cast<void>(TIndex::openMapped(path)), std::runtime_error);
+    std::filesystem::remove(path);
+    ASSERT_THROW(static_cast<void>(TIndex::openMapped(path)), std::system_error);
+}
+
+template <typename TPolicy, typename TCrt>
+void floatingSnapshotTest(TCrt maxPos, TCrt step)
+{
+    using TIndex = space::QuadTree<space::Rect<TCrt>, TPolicy>;
+    const auto path = std::filesystem::temp_directory_path()
+        / ("quadtree_snapshot_" + std::to_string(::getpid()) + "_" + std::to_string(std::rand()) + ".bin");
+
+    // The far key makes the root big, the dense points near the origin go down to the
+    // smallest regions, so the tree is deeper than the digits of the coordinate type.
+    TIndex index;
+    index.insert(space::Rect<TCrt> {{maxPos, maxPos}, 0, 0});
+    for (int i = 0; i < 32; ++i)
+    {
+        for (int j = 0; j < 32; ++j)
+        {
+            index.insert(space::Rect<TCrt> {{static_cast<TCrt>(i) * step, static_cast<TCrt>(j) * step}, 0, 0});
+        }
+    }
+    index.save(path);
+    const auto mapped = TIndex::openMapped(path);
+    ASSERT_EQ(index.size(), mapped.size());
+    for (int i = 0; i < 32; ++i)
+    {
+        const space::Rect<TCrt> queryRect {{static_cast<TCrt>(i) * step, 0}, step, static_cast<TCrt>(i) * step};
+        ASSERT_EQ(index.queryCount(queryRect), mapped.queryCount(queryRect));
+    }
+    ASSERT_TRUE(mapped.contains(space::Rect<TCrt> {{maxPos, maxPos}, 0, 0}));
+    std::filesystem::remove(path);
+}
+#endif // SPACE_HAS_MMAP
+
+template <typename TCrt>
+auto movedRect(const space::Rect<TCrt>& rect, TCrt maxPos, TCrt maxStep)
+{
+    auto moved = rect;
+    if (0 == rand(0, 20))
+    {
+        // The far jump, sometimes outside of the initial extent.
+        moved.pos() = getRandPoint(2 * maxPos);
+    }
+    else
+    {
+        moved.pos() = space::Point<TCrt> {moved.pos().x() + rand(-maxStep, maxStep), moved.pos().y() + rand(-maxStep, maxStep)};
+    }
+    if (0 == rand(0, 10))
+    {
+        moved.width() = rand(0, rect.width() + 2);
+    }
+    return moved;
+}
+
+template <typename TIndex, typename TCrt>
+void compareWithKeys(const TIndex& index, const std::set<space::Rect<TCrt>>& keys, TCrt maxPos, TCrt maxRectWidth, TCrt maxRectHeight)
+{
+    ASSERT_EQ(std::size(keys), index.size());
+    for (const auto& key : keys)
+    {
+        ASSERT_TRUE(index.contains(key));
+    }
+    for (size_t i = 0; i < 100; ++i)
+    {
+        const auto queryRect = getRandRect(2 * maxPos, maxRectWidth * 10, maxRectHeight * 10);
+        std::vector<space::Rect<TCrt>> found;
+        index.query(queryRect, std::back_inserter(found));
+        std::ranges::sort(found);
+        std::vector<space::Rect<TCrt>> expected;
+        std::ranges::copy_if(keys, std::back_inserter(expected), [&queryRect](const auto& key)
+        {
+            return space::util::hasIntersect(queryRect, key);
+        });
+        ASSERT_EQ(expected, found);
+    }
+}
+
+template <typename TIndex, typename TCrt, size_t Count>
+void updateTest(TCrt maxPos, TCrt maxRectWidth, TCrt maxRectHeight, TCrt maxStep)
+{
+    std::set<space::Rect<TCrt>> keys;
+    TIndex index;
+    for (size_t i = 0; i < Count; ++i)
+    {
+        const auto rect = getRandRect(maxPos, maxRectWidth, maxRectHeight);
+        ASSERT_EQ(keys.insert(rect).second, index.insert(rect));
+    }
+
+    ASSERT_FALSE(index.update(space::Rect<TCrt> {{-7, -7}, 1, 1}, space::Rect<TCrt> {{7, 7}, 1, 1}));
+    for (size_t step = 0; step < 10; ++step)
+    {
+        const std::vector<space::Rect<TCrt>> current(keys.begin(), keys.end());
+        for (const auto& key : current)
+        {
+            const auto moved = (0 == rand(0, 50)) ? *keys.begin() : movedRect(key, maxPos, maxStep);
+            const bool isExpected = (key == moved) || !keys.contains(moved);
+            ASSERT_EQ(isExpected, index.update(key, moved));
+            if (isExpected)
+            {
+                keys.erase(key);
+                keys.insert(moved);
+            }
+        }
+        compareWithKeys(index, keys, maxPos, maxRectWidth, maxRectHeight);
+    }
+}
+
+template <typename TIndex, typename TCrt, size_t Count>
+void applyUpdatesTest(TCrt maxPos, TCrt maxRectWidth, TCrt maxRectHeight, TCrt maxStep)
+{
+    std::set<space::Rect<TCrt>> keys;
+    TIndex index;
+    for (size_t i = 0; i < Count; ++i)
+    {
+        const auto rect = getRandRect(maxPos, maxRectWidth, maxRectHeight);
+        ASSERT_EQ(keys.insert(rect).second, index.insert(rect));
+    }
+
+    for (size_t step = 0; step < 10; ++step)
+    {
+        std::vector<std::pair<space::Rect<TCrt>, space::Rect<TCrt>>> updates;
+        for (const auto& key : keys)
+        {
+            if (0 != rand(0, 3))
+            {
+                updates.emplace_back(key, movedRect(key, maxPos, maxStep));
+            }
+        }
+        updates.emplace_back(space::Rect<TCrt> {{-7, -7}, 1, 1}, space::Rect<TCrt> {{7, 7}, 1, 1});
+        // The key moved onto another stored key and two keys moved onto one new key.
+        const auto first = keys.begin();
+        const space::Rect<TCrt> sharedKey {{-5, -5}, 2, 2};
+        updates.insert(updates.begin(), {{*first, *std::next(first)}, {*std::next(first, 2), sharedKey}
+                                         , {*std::next(first, 3), sharedKey}});
+        updates.push_back(updates.front());
+
+        // The updates onto a stored key or onto the new key of a preceding update are skipped,
+        // then all old keys are removed first, then the new keys are inserted.
+        size_t applied = 0;
+        std::vector<space::Rect<TCrt>> inserted;
+        std::set<space::Rect<TCrt>> removed;
+        std::set<space::Rect<TCrt>> newKeys;
+        for (const auto& [oldKey, newKey] : updates)
+        {
+            const bool isNewKeyTaken = !newKeys.insert(newKey).second || (oldKey != newKey && keys.contains(newKey));
+            if (!isNewKeyTaken && keys.contains(oldKey) && removed.insert(oldKey).second)
+            {
+                ++applied;
+                inserted.push_back(newKey);
+            }
+        }
+        for (const auto& key : removed)
+        {
+            keys.erase(key);
+        }
+        keys.insert(inserted.begin(), inserted.end());
+
+        ASSERT_EQ(applied, index.applyUpdates(updates));
+        compareWithKeys(index, keys, maxPos, maxRectWidth, maxRectHeight);
+    }
+}
+
+template <typename TIndex, typename TCrt, size_t Count>
+void pruneTest(TCrt maxPos, TCrt maxRectWidth, TCrt maxRectHeight)
+{
+    std::set<space::Rect<TCrt>> keys;
+    TIndex index;
+    for (size_t i = 0; i < Count; ++i)
+    {
+        const auto rect = getRandRect(maxPos, maxRectWidth, maxRectHeight);
+        ASSERT_EQ(keys.insert(rect).second, index.insert(rect));
+    }
+    for (const auto& key : keys)
+    {
+        index.remove(key);
+    }
+    ASSERT_TRUE(index.empty());
+    ASSERT_EQ(0, index.nodeCount());
+
+    for (const auto& key : keys)
+    {
+        ASSERT_TRUE(index.insert(key));
+    }
+    // The far keys grow up the root, the compaction lowers it back after removing them.
+    const std::vector<space::Rect<TCrt>> farKeys {space::Rect<TCrt> {{maxPos * 100, maxPos * 100}, 1, 1}
+                                                  , space::Rect<TCrt> {{maxPos * 100 + 1, maxPos * 100 + 1}, 1, 1}};
+    for (const auto& key : farKeys)
+    {
+        ASSERT_TRUE(index.insert(key));
+    }
+    const auto grownNodeCount = index.nodeCount();
+    for (const auto& key : farKeys)
+    {
+        index.remove(key);
+    }
+    for (auto it = keys.begin(); it != keys.end();)
+    {
+        if (0 == rand(0, 1))
+        {
+            index.remove(*it);
+            it = keys.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    index.compact();
+    ASSERT_LT(index.nodeCount(), grownNodeCount);
+    compareWithKeys(index, keys, maxPos, maxRectWidth, maxRectHeight);
+
+    const auto rect = getRandRect(maxPos, maxRectWidth, maxRectHeight);
+    ASSERT_EQ(keys.insert(rect).second, index.insert(rect));
+    compareWithKeys(index, keys, maxPos, maxRectWidth, maxRectHeight);
+
+    for (const auto& key : keys)
+    {
+        index.remove(key);
+    }
+    index.compact();
+    ASSERT_TRUE(index.empty());
+    ASSERT_EQ(0, index.nodeCount());
+}
+
+template <typename TIndex, typename TCrt, size_t Count>
+void concurrentTest(TCrt maxPos, TCrt maxRectWidth, TCrt maxRectHeight)
+{
+    std::set<space::Rect<TCrt>> keys;
+    TIndex index;
+    for (size_t i = 0; i < Count; ++i)
+    {
+        const auto rect = getRandRect(maxPos, maxRectWidth, maxRectHeight);
+        ASSERT_EQ(keys.insert(rect).second, index.insert(rect));
+    }
+    compareWithKeys(index, keys, maxPos, maxRectWidth, maxRectHeight);
+    for (auto it = keys.begin(); it != keys.end();)
+    {
+        if (0 == rand(0, 1))
+        {
+            ASSERT_TRUE(index.remove(*it));
+            it = keys.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    ASSERT_FALSE(index.remove(space::Rect<TCrt> {{-7, -7}, 1, 1}));
+    compareWithKeys(index, keys, maxPos, maxRectWidth, maxRectHeight);
+
+    // The writer churns the keys far from the stored ones, the readers must always see the stored keys.
+    std::vector<space::Rect<TCrt>> churnKeys;
+    for (size_t i = 0; i < Count; ++i)
+    {
+        const auto rect = getRandRect(maxPos, maxRectWidth, maxRectHeight);
+        churnKeys.push_back(space::Rect<TCrt> {{rect.pos().x() + 4 * maxPos, rect.pos().y()}, rect.width(), rect.height()});
+    }
+    std::vector<space::Rect<TCrt>> queries;
+    for (size_t i = 0; i < 100; ++i)
+    {
+        queries.push_back(getRandRect(maxPos, maxRectWidth * 10, maxRectHeight * 10));
+    }
+    std::vector<size_t> expectedCounts;
+    for (const auto& query : queries)
+    {
+        expectedCounts.push_back(static_cast<size_t>(std::ranges::count_if(keys, [&query](const auto& key)
+        {
+            return space::util::hasIntersect(query, key);
+        })));
+    }
+
+    std::atomic<bool> isWriting {true};
+    std::atomic<size_t> failureCount {0};
+    std::vector<std::thread> readers;
+    for (size_t i = 0; i < 4; ++i)
+    {
+        readers.emplace_back([&]()
+        {
+            do
+            {
+                for (size_t q = 0; q < std::size(queries); ++q)
+                {
+                    if (expectedCounts[q] != index.queryCount(queries[q]))
+                    {
+                        ++failureCount;
+                    }
+                }
+                for (const auto& key : keys)
+                {
+                    if (!index.contains(key))
+                    {
+                        ++failureCount;
+                    }
+                }
+            }
+            while (isWriting.load());
+        });
+    }
+    for (size_t step = 0; step < 3; ++step)
+    {
+        for (const auto& key : churnKeys)
+        {
+            index.insert(key);
+        }
+        for (const auto& key : churnKeys)
+        {
+            index.remove(key);
+        }
+    }
+    isWriting.store(false);
+    for (auto& reader : readers)
+    {
+        reader.join();
+    }
+    ASSERT_EQ(0, failureCount.load());
+    compareWithKeys(index, keys, maxPos, maxRectWidth, maxRectHeight);
+}
+
+template <typename TIndex, typename TCrt, size_t Count>
+void shardedTest(TCrt maxPos, TCrt maxRectWidth, TCrt maxRectHeight)
+{
+    std::vector<space::Rect<TCrt>> rects;
+    for (size_t i = 0; i < Count; ++i)
+    {
+        rects.push_back(getRandRect(maxPos, maxRectWidth, maxRectHeight));
+    }
+    rects.push_back(space::Rect<TCrt> {{-maxPos, -maxPos}, 1, 1});
+    rects.push_back(space::Rect<TCrt> {{-1, -1}, maxPos + 2, maxPos + 2});
+    const std::set<space::Rect<TCrt>> uniqueRects(rects.begin(), rects.end());
+
+    // The parallel producers insert the disjoint parts of keys.
+    TIndex index {space::Rect<TCrt> {{0, 0}, maxPos, maxPos}};
+    std::vector<std::thread> producers;
+    constexpr size_t producerCount = 4;
+    for (size_t producer = 0; producer < producerCount; ++producer)
+    {
+        producers.emplace_back([&index, &rects, producer]()
+        {
+            for (size_t i = producer; i < std::size(rects); i += producerCount)
+            {
+                index.insert(rects[i]);
+            }
+        });
+    }
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+    ASSERT_LT(0, index.overflowSize());
+    std::set<space::Rect<TCrt>> keys = uniqueRects;
+    compareWithKeys(index, keys, maxPos, maxRectWidth, maxRectHeight);
+    ASSERT_TRUE(index.queryAny(space::Rect<TCrt> {{-maxPos, -maxPos}, 1, 1}));
+
+    for (auto it = keys.begin(); it != keys.end();)
+    {
+        if (0 == rand(0, 1))
+        {
+            index.remove(*it);
+            it = keys.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    compareWithKeys(index, keys, maxPos, maxRectWidth, maxRectHeight);
+
+    TIndex loaded {space::Rect<TCrt> {{0, 0}, maxPos, maxPos}};
+    ASSERT_EQ(std::size(uniqueRects), loaded.bulkLoad(rects));
+    ASSERT_EQ(0, loaded.bulkLoad(rects));
+    compareWithKeys(loaded, uniqueRects, maxPos, maxRectWidth, maxRectHeight);
+}
+
+template <typename TIndex, typename TCrt, size_t Count>
+void shardedLimitsTest(const space::Rect<TCrt>& worldExtent)
+{
+    constexpr auto lowest = std::numeric_limits<TCrt>::lowest();
+    constexpr auto max = std::numeric_limits<TCrt>::max();
+    std::mt19937 generator {42};
+    std::uniform_int_distribution<TCrt> distribution {lowest, static_cast<TCrt>(max - 10)};
+    std::set<space::Rect<TCrt>> keys {space::Rect<TCrt> {{static_cast<TCrt>(max - 1), static_cast<TCrt>(max - 1)}, 1, 1}
+                                      , space::Rect<TCrt> {worldExtent.pos(), 0, 0}
+                                      , space::Rect<TCrt> {space::util::topRightOf(worldExtent), 0, 0}};
+    while (keys.size() < Count)
+    {
+        keys.insert(space::Rect<TCrt> {{distribution(generator), distribution(generator)}, 10, 10});
+    }
+
+    // The cells of the extent close to the width limit don't overflow the coordinates.
+    TIndex index {worldExtent};
+    for (const auto& key : keys)
+    {
+        ASSERT_TRUE(index.insert(key));
+    }
+    for (const auto& key : keys)
+    {
+        ASSERT_TRUE(index.contains(key));
+    }
+    for (const auto& window : {worldExtent, space::Rect<TCrt> {{lowest, lowest}, max, max}
+                               , space::Rect<TCrt> {{-1, -1}, max, max}})
+    {
+        std::vector<space::Rect<TCrt>> queryRes;
+        index.query(window, std::back_inserter(queryRes));
+        std::ranges::sort(queryRes);
+        std::vector<space::Rect<TCrt>> expectedRes;
+        std::ranges::copy_if(keys, std::back_inserter(expectedRes), [&window](const auto& key)
+        {
+            return space::util::hasIntersect(window, key);
+        });
+        ASSERT_TRUE(queryRes == expectedRes);
+    }
+}
+
+template <typename TPolicy, typename TCrt, size_t Count>
+void linearTest(TCrt maxPos, TCrt maxRectWidth, TCrt maxRectHeight)
+{
+    using TLinearTree = space::LinearQuadTree<space::Rect<TCrt>, TPolicy>;
+    std::vector<space::Rect<TCrt>> rects;
+    for (size_t i = 0; i < Count; ++i)
+    {
+        rects.push_back(getRandRect(maxPos, maxRectWidth, maxRectHeight));
+    }
+    const std::set<space::Rect<TCrt>> keys(rects.begin(), rects.end());
+
+    const TLinearTree emptyTree {std::vector<space::Rect<TCrt>> {}};
+    ASSERT_TRUE(emptyTree.empty());
+    ASSERT_FALSE(emptyTree.queryAny(space::Rect<TCrt> {{0, 0}, maxPos, maxPos}));
+
+    const TLinearTree linearTree {rects};
+    ASSERT_TRUE(std::ranges::is_sorted(linearTree.codes()));
+    compareWithKeys(linearTree, keys, maxPos, maxRectWidth, maxRectHeight);
+    ASSERT_FALSE(linearTree.contains(space::Rect<TCrt> {{-7, -7}, 1, 1}));
+
+    // The tree grown up by inserts has the root region different from the range one.
+    space::QuadTree<space::Rect<TCrt>, TPolicy> tree;
+    for (const auto& rect : rects)
+    {
+        tree.insert(rect);
+    }
+    const TLinearTree treeLinearTree {tree};
+    compareWithKeys(treeLinearTree, keys, maxPos, maxRectWidth, maxRectHeight);
+}
+
+template <typename TFirstPolicy, typename TSecondPolicy, typename TCrt, size_t Count>
+void spatialJoinTest(TCrt maxPos, TCrt maxRectWidth, TCrt maxRectHeight)
+{
+    using TPair = std::pair<space::Rect<TCrt>, space::Rect<TCrt>>;
+    space::QuadTree<space::Rect<TCrt>, TFirstPolicy> first;
+    space::QuadTree<space::Rect<TCrt>, TSecondPolicy> second;
+    ASSERT_TRUE(space::spatialJoin(std::execution::par, first, second).empty());
+
+    std::set<space::Rect<TCrt>> firstKeys;
+    std::set<space::Rect<TCrt>> secondKeys;
+    for (size_t i = 0; i < Count; ++i)
+    {
+        const auto firstRect = getRandRect(maxPos, maxRectWidth, maxRectHeight);
+        ASSERT_EQ(firstKeys.insert(firstRect).second, first.insert(firstRect));
+        // The second tree has the smaller keys, so the values are joined at different depths.
+        const auto secondRect = getRandRect(maxPos, maxRectWidth / 4, maxRectHeight / 4);
+        ASSERT_EQ(secondKeys.insert(secondRect).second, second.insert(secondRect));
+    }
+    ASSERT_TRUE(space::spatialJoin(std::execution::par, first
+        , space::QuadTree<space::Rect<TCrt>, TSecondPolicy> {}).empty());
+
+    std::vector<TPair> expected;
+    for (const auto& firstKey : firstKeys)
+    {
+        for (const auto& secondKey : secondKeys)
+        {
+            if (space::util::hasIntersect(firstKey, secondKey))
+            {
+                expected.emplace_back(firstKey, secondKey);
+            }
+        }
+    }
+
+    std::vector<TPair> pairs;
+    space::spatialJoin(first, second, [&pairs](const auto& firstKey, const auto& secondKey)
+    {
+        pairs.emplace_back(firstKey, secondKey);
+    });
+    std::ranges::sort(pairs);
+    ASSERT_EQ(expected, pairs);
+
+    const auto parallelPairs = space::spatialJoin(std::execution::par, first, second);
+    pairs.assign(parallelPairs.begin(), parallelPairs.end());
+    std::ranges::sort(pairs);
+    ASSERT_EQ(expected, pairs);
+}
+
+template <typename TCrt, size_t Count>
+void statsTest(TCrt maxPos, TCrt maxRectWidth, TCrt maxRectHeight)
+{
+    space::QuadTree<space::Rect<TCrt>, space::StatsQuadTreePolicy> statsTree;
+    space::QuadTree<space::Rect<TCrt>> tree;
+    ASSERT_EQ(0, statsTree.stats().nodeCount);
+    ASSERT_TRUE(statsTree.stats().nodesPerDepth.empty());
+
+    for (size_t i = 0; i < Count; ++i)
+    {
+        const auto rect = getRandRect(maxPos, maxRectWidth, maxRectHeight);
+        ASSERT_EQ(tree.insert(rect), statsTree.insert(rect));
+    }
+    const auto sumOf = [](const auto& histogram)
+    {
+        return std::accumulate(histogram.begin(), histogram.end(), std::size_t {0});
+    };
+    const auto stats = statsTree.stats();
+    ASSERT_EQ(statsTree.size(), stats.valueCount);
+    ASSERT_EQ(statsTree.nodeCount(), stats.nodeCount);
+    ASSERT_EQ(stats.nodeCount, sumOf(stats.nodesPerDepth));
+    ASSERT_EQ(stats.nodeCount, sumOf(stats.valuesPerNode));
+    ASSERT_EQ(stats.valueCount, sumOf(stats.valuesPerDepth));
+    ASSERT_EQ(1, stats.nodesPerDepth.front());
+    ASSERT_GE(stats.bytesUsed, stats.nodeCount + stats.valueCount * sizeof(space::Rect<TCrt>));
+    // Every node except the first root is created by growing the tree down or up.
+    ASSERT_EQ(stats.nodeCount, 1 + stats.counters.nodesAllocated + stats.counters.rootRegrowths);
+
+    // The tree without stats has the same structure and no counters.
+    const auto plainStats = tree.stats();
+    ASSERT_EQ(stats.nodesPerDepth, plainStats.nodesPerDepth);
+    ASSERT_EQ(stats.valuesPerNode, plainStats.valuesPerNode);
+    ASSERT_EQ(0, plainStats.counters.nodesAllocated);
+
+    statsTree.resetStats();
+    std::size_t foundCount = 0;
+    for (size_t i = 0; i < Count; ++i)
+    {
+        const auto queryRect = getRandRect(maxPos, maxRectWidth, maxRectHeight);
+        std::vector<space::Rect<TCrt>> found;
+        statsTree.query(queryRect, std::back_inserter(found));
+        foundCount += std::size(found);
+        ASSERT_EQ(std::size(found), statsTree.queryCount(queryRect));
+    }
+    const auto counters = statsTree.stats().counters;
+    ASSERT_EQ(2 * Count, counters.queries);
+    ASSERT_EQ(2 * foundCount, counters.valuesMatched);
+    ASSERT_GE(counters.nodesVisited, counters.queries);
+    ASSERT_EQ(0, counters.nodesAllocated);
+
+    for (const auto& value : tree.queryRange(space::Rect<TCrt> {{-maxPos, -maxPos}, 4 * maxPos, 4 * maxPos}))
+    {
+        statsTree.remove(value);
+    }
+    ASSERT_TRUE(statsTree.empty());
+    ASSERT_EQ(0, statsTree.stats().nodeCount);
+}
+
+template <typename TPolicy, typename TCrt, size_t Count>
+void bucketTest(TCrt maxPos, TCrt maxRectWidth, TCrt maxRectHeight)
+{
+    space::QuadTree<space::Rect<TCrt>, TPolicy> tree;
+    space::QuadTree<space::Rect<TCrt>> defaultTree;
+    std::set<space::Rect<TCrt>> keys;
+    for (size_t i = 0; i < Count; ++i)
+    {
+        const auto rect = getRandRect(maxPos, maxRectWidth, maxRectHeight);
+        ASSERT_EQ(keys.insert(rect).second, tree.insert(rect));
+        defaultTree.insert(rect);
+    }
+    compareWithKeys(tree, keys, maxPos, maxRectWidth, maxRectHeight);
+    // The keys stay in the upper nodes, so the tree is not deeper than the default one.
+    ASSERT_LE(tree.nodeCount(), defaultTree.nodeCount());
+    ASSERT_LE(std::size(tree.stats().nodesPerDepth), std::size(defaultTree.stats().nodesPerDepth));
+
+    const space::QuadTree<space::Rect<TCrt>, TPolicy> loadedTree {keys};
+    compareWithKeys(loadedTree, keys, maxPos, maxRectWidth, maxRectHeight);
+
+    for (auto it = keys.begin(); it != keys.end();)
+    {
+        if (0 == rand(0, 2))
+        {
+            tree.remove(*it);
+            it = keys.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    compareWithKeys(tree, keys, maxPos, maxRectWidth, maxRectHeight);
+    for (const auto& key : keys)
+    {
+        tree.remove(key);
+    }
+    ASSERT_TRUE(tree.empty());
+    ASSERT_EQ(0, tree.nodeCount());
+}
+
+template <typename TIndex, typename TCrt>
+void compareWithFloatingKeys(const TIndex& index, const std::set<space::Rect<TCrt>>& keys
+                             , const std::vector<space::Rect<TCrt>>& queries)
+{
+    ASSERT_EQ(std::size(keys), index.size());
+    for (const auto& key : keys)
+    {
+        ASSERT_TRUE(index.contains(key));
+    }
+    for (const auto& query : queries)
+    {
+        std::vector<space::Rect<TCrt>> found;
+        index.query(query, std::back_inserter(found));
+        std::ranges::sort(found);
+        std::vector<space::Rect<TCrt>> expected;
+        std::ranges::copy_if(keys, std::back_inserter(expected), [&query](const auto& key)
+        {
+            return space::util::hasIntersect(query, key);
+        });
+        ASSERT_EQ(expected, found);
+    }
+}
+
+template <typename TPolicy, typename TCrt, size_t Count>
+void floatingTest(TCrt origin, TCrt maxPos, TCrt maxRectSize)
+{
+    std::mt19937 engine {42};
+    std::uniform_real_distribution<TCrt> position {origin, origin + maxPos};
+    std::uniform_real_distribution<TCrt> size {0, maxRectSize};
+    const auto randRect = [&](TCrt sizeFactor)
+    {
+        // Every fourth key is a point.
+        const bool isPoint = 0 == engine() % 4;
+        return space::Rect<TCrt> {{position(engine), position(engine)}
+                                  , isPoint ? TCrt {0} : sizeFactor * size(engine)
+                                  , isPoint ? TCrt {0} : sizeFactor * size(engine)};
+    };
+
+    space::QuadTree<space::Rect<TCrt>, TPolicy> tree;
+    std::set<space::Rect<TCrt>> keys;
+    for (size_t i = 0; i < Count; ++i)
+    {
+        const auto rect = randRect(1);
+        ASSERT_EQ(keys.insert(rect).second, tree.insert(rect));
+    }
+    std::vector<space::Rect<TCrt>> queries;
+    for (size_t i = 0; i < 100; ++i)
+    {
+        queries.push_back(randRect(10));
+    }
+    compareWithFloatingKeys(tree, keys, queries);
+
+    const space::QuadTree<space::Rect<TCrt>, TPolicy> loadedTree {keys};
+    compareWithFloatingKeys(loadedTree, keys, queries);
+
+    const space::Point<TCrt> point {position(engine), position(engine)};
+    std::vector<double> expectedDistances;
+    for (const auto& key : keys)
+    {
+        expectedDistances.push_back(space::util::squaredDistance<space::Rect<TCrt>, TCrt, double>(key, point));
+    }
+    std::ranges::sort(expectedDistances);
+    expectedDistances.resize(std::min<size_t>(8, std::size(expectedDistances)));
+    std::vector<space::Rect<TCrt>> nearest;
+    tree.nearest(point, 8, std::back_inserter(nearest));
+    std::vector<double> distances;
+    for (const auto& key : nearest)
+    {
+        distances.push_back(space::util::squaredDistance<space::Rect<TCrt>, TCrt, double>(key, point));
+    }
+    ASSERT_EQ(expectedDistances, distances);
+
+    // The small fractional moves, the keys move between the neighbour nodes.
+    std::uniform_real_distribution<TCrt> step {-maxRectSize, maxRectSize};
+    for (auto it = keys.begin(); it != keys.end();)
+    {
+        if (0 != engine() % 3)
+        {
+            ++it;
+            continue;
+        }
+        const space::Rect<TCrt> moved {{it->pos().x() + step(engine), it->pos().y() + step(engine)}, it->width(), it->height()};
+        if (keys.contains(moved))
+        {
+            ++it;
+            continue;
+        }
+        ASSERT_TRUE(tree.update(*it, moved));
+        it = keys.erase(it);
+        keys.insert(moved);
+    }
+    compareWithFloatingKeys(tree, keys, queries);
+
+    for (const auto& key : keys)
+    {
+        tree.remove(key);
+    }
+    ASSERT_TRUE(tree.empty());
+    ASSERT_EQ(0, tree.nodeCount());
+}
+
+template <typename TPolicy, typename TCrt, size_t Count, size_t ProducerCount>
+void builderTest(TCrt maxPos, TCrt maxRectWidth, TCrt maxRectHeight, size_t batchSize, size_t queueCapacity)
+{
+    using TRect = space::Rect<TCrt>;
+    // The keys are generated before the threads start, the std::rand is not thread safe.
+    std::set<TRect> keys;
+    std::vector<std::vector<TRect>> producerKeys(ProducerCount);
+    for (auto& rects : producerKeys)
+    {
+        for (size_t i = 0; i < Count; ++i)
+        {
+            rects.push_back(getRandRect(maxPos, maxRectWidth, maxRectHeight));
+            keys.insert(rects.back());
+        }
+    }
+
+    space::QuadTreeBuilder<TRect, TPolicy> builder {{}, batchSize, queueCapacity};
+    std::vector<std::thread> producers;
+    for (size_t producer = 0; producer < ProducerCount; ++producer)
+    {
+        producers.emplace_back([&builder, &rects = producerKeys[producer], producer]()
+        {
+            const std::span<const TRect> all {rects};
+            for (size_t first = 0, chunk = 0; first < std::size(all); ++chunk)
+            {
+                const auto count = std::min<size_t>(1 + (chunk * 37 + producer * 11) % 300, std::size(all) - first);
+                if (0 == chunk % 2)
+                {
+                    builder.push(all.subspan(first, count));
+                }
+                else
+                {
+                    builder.push(std::vector<TRect>(all.begin() + first, all.begin() + first + count));
+                }
+                first += count;
+            }
+        });
+    }
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+    builder.flush();
+    ASSERT_EQ(std::size(keys), builder.size());
+    compareWithKeys(builder.tree(), keys, maxPos, maxRectWidth, maxRectHeight);
+
+    // The batch which is not full is loaded by finalize.
+    std::vector<TRect> tail;
+    for (size_t i = 0; i < 10; ++i)
+    {
+        tail.push_back(getRandRect(2 * maxPos, maxRectWidth, maxRectHeight));
+        keys.insert(tail.back());
+    }
+    builder.push(tail);
+    const auto tree = builder.finalize();
+    compareWithKeys(tree, keys, maxPos, maxRectWidth, maxRectHeight);
+}
+
+template <typename TCrt, size_t Count>
+void queryCacheTest(TCrt maxPos, TCrt maxRectWidth, TCrt maxRectHeight, TCrt tileSize)
+{
+    using TRect = space::Rect<TCrt>;
+    space::QuadTree<TRect> tree;
+    for (size_t i = 0; i < Count; ++i)
+    {
+        tree.insert(getRandRect(maxPos, maxRectWidth, maxRectHeight));
+    }
+    // The hot windows, the shifted copies of them are in the same tiles mostly.
+    std::vector<TRect> windows;
+    for (size_t i = 0; i < 32; ++i)
+    {
+        windows.push_back(getRandRect(maxPos, maxRectWidth * 10, maxRectHeight * 10));
+    }
+    const auto compareWithTree = [&tree](auto& cache, const TRect& window)
+    {
+        std::vector<TRect> expected;
+        tree.query(window, std::back_inserter(expected));
+        std::ranges::sort(expected);
+        std::vector<TRect> found;
+        cache.query(window, std::back_inserter(found));
+        std::ranges::sort(found);
+        ASSERT_EQ(expected, found);
+    };
+
+    space::QueryCache<TRect> cache {tree, size_t {1} << 24, tileSize};
+    for (size_t round = 0; round < 4; ++round)
+    {
+        for (const auto& window : windows)
+        {
+            compareWithTree(cache, window);
+            const TRect shifted {{window.pos().x() + 1, window.pos().y()}, window.width(), window.height()};
+            compareWithTree(cache, shifted);
+        }
+    }
+    auto stats = cache.stats();
+    ASSERT_EQ(stats.hits + stats.misses, 4 * 2 * std::size(windows));
+    ASSERT_LE(stats.misses, 2 * std::size(windows));
+    ASSERT_EQ(stats.invalidations, 0);
+    ASSERT_EQ(stats.entryCount, stats.misses);
+
+    // The tree changes invalidate the cache, the new and removed keys are seen.
+    const auto version = tree.version();
+    const TRect key {windows.front().pos(), 0, 0};
+    const bool isNew = tree.insert(key);
+    ASSERT_EQ(isNew, version != tree.version());
+    compareWithTree(cache, windows.front());
+    const TRect movedKey {{maxPos + 1, maxPos + 1}, 1, 1};
+    ASSERT_TRUE(tree.update(key, movedKey));
+    compareWithTree(cache, windows.front());
+    tree.remove(movedKey);
+    compareWithTree(cache, windows.front());
+    stats = cache.stats();
+    ASSERT_EQ(stats.invalidations, isNew ? 3 : 2);
+
+    const auto compactedVersion = tree.version();
+    tree.compact();
+    ASSERT_EQ(compactedVersion, tree.version());
+
+    // The small limit evicts the least recently used entries.
+    space::QueryCache<TRect> smallCache {tree, 4'096, tileSize};
+    for (size_t round = 0; round < 2; ++round)
+    {
+        for (const auto& window : windows)
+        {
+            compareWithTree(smallCache, window);
+        }
+    }
+    stats = smallCache.stats();
+    ASSERT_LE(stats.bytesUsed, 4'096);
+    ASSERT_GT(stats.evictions, 0);
+
+    // The tiles at the limits of coordinates are clamped to the range.
+    if constexpr (std::is_integral_v<TCrt>)
+    {
+        constexpr auto lowest = std::numeric_limits<TCrt>::lowest();
+        constexpr auto max = std::numeric_limits<TCrt>::max();
+        tree.insert(TRect {{lowest, lowest}, 0, 0});
+        tree.insert(TRect {{static_cast<TCrt>(max - 1), static_cast<TCrt>(max - 1)}, 1, 1});
+        tree.insert(TRect {{lowest, static_cast<TCrt>(max - 1)}, 1, 1});
+        space::QueryCache<TRect> limitsCache {tree, size_t {1} << 24, tileSize};
+        const std::vector<TRect> limitWindows {
+            TRect {{lowest, lowest}, 10, 10}
+            , TRect {{static_cast<TCrt>(max - 10), static_cast<TCrt>(max - 10)}, 10, 10}
+            , TRect {{lowest, static_cast<TCrt>(max - 10)}, 10, 10}
+            , TRect {{lowest, lowest}, max, max}
+            , TRect {{-1, -1}, max, max}};
+        for (size_t round = 0; round < 2; ++round)
+        {
+            for (const auto& window : limitWindows)
+            {
+                compareWithTree(limitsCache, window);
+            }
+        }
+    }
+}
+
 } // namespace test_util
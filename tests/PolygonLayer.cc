@@ -0,0 +1,132 @@
+/**
+ * @file        PolygonLayer.cc
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Tests implementation for unit tests for space::PolygonLayer.
+ * @date        14-10-2026
+ * @copyright   Copyright (c) 2026
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <execution>
+#include <numbers>
+#include <vector>
+
+#include "IndexTestingUtils.h"
+#include "PolygonLayer.h"
+
+
+namespace
+{
+
+/**
+ * @brief   Makes the random convex polygon with the vertices on the circle, in clockwise order.
+ */
+space::SimplePolygon<int32_t> getRandConvexPolygon(int32_t maxPos, int32_t maxRadius)
+{
+    const auto center = test_util::getRandPoint(maxPos);
+    const auto radius = test_util::rand(1, maxRadius);
+    const auto vertexCount = test_util::rand(3, 8);
+
+    std::vector<double> angles;
+    for (int i = 0; i < vertexCount; ++i)
+    {
+        angles.push_back(2 * std::numbers::pi * test_util::rand(0, 360) / 360.0);
+    }
+    std::ranges::sort(angles, std::ranges::greater {});
+    angles.erase(std::unique(angles.begin(), angles.end()), angles.end());
+
+    space::SimplePolygon<int32_t>::TPiecewiseLinearCurve curve;
+    for (const auto angle : angles)
+    {
+        curve.push_back({center.x() + static_cast<int32_t>(radius * std::cos(angle))
+                         , center.y() + static_cast<int32_t>(radius * std::sin(angle))});
+    }
+    return space::SimplePolygon<int32_t> {curve};
+}
+
+} // namespace
+
+TEST(space_PolygonLayer, QueryIntersecting)
+{
+    space::PolygonLayer<int32_t> layer;
+    for (int i = 0; i < 1'000; ++i)
+    {
+        ASSERT_EQ(layer.add(getRandConvexPolygon(10'000, 500)), static_cast<uint32_t>(i));
+    }
+    ASSERT_EQ(layer.size(), 1'000);
+
+    std::vector<space::SimplePolygon<int32_t>> queries;
+    for (int i = 0; i < 200; ++i)
+    {
+        queries.push_back(getRandConvexPolygon(10'000, 500));
+    }
+
+    const auto batchResult = layer.queryIntersectingBatch(queries);
+    space::PolygonLayer<int32_t>::QueryStats totalStats;
+    for (size_t i = 0; i < queries.size(); ++i)
+    {
+        std::vector<uint32_t> ids;
+        const auto stats = layer.queryIntersecting(queries[i], std::back_inserter(ids));
+        totalStats += stats;
+
+        std::vector<uint32_t> expectedIds;
+        for (uint32_t id = 0; id < layer.size(); ++id)
+        {
+            if (space::util::hasIntersect(queries[i], layer.polygon(id)))
+            {
+                expectedIds.push_back(id);
+            }
+        }
+
+        std::ranges::sort(ids);
+        ASSERT_TRUE(ids == expectedIds);
+        ASSERT_EQ(stats.matched, ids.size());
+        ASSERT_LE(stats.matched, stats.filtered);
+
+        std::vector<uint32_t> batchIds(batchResult[i].begin(), batchResult[i].end());
+        std::ranges::sort(batchIds);
+        ASSERT_TRUE(batchIds == expectedIds);
+    }
+    ASSERT_EQ(batchResult.stats.filtered, totalStats.filtered);
+    ASSERT_EQ(batchResult.stats.matched, totalStats.matched);
+}
+
+TEST(space_PolygonLayer, QueryContaining)
+{
+    space::PolygonLayer<int32_t> layer;
+    for (int i = 0; i < 1'000; ++i)
+    {
+        layer.add(getRandConvexPolygon(10'000, 500));
+    }
+
+    for (int i = 0; i < 1'000; ++i)
+    {
+        const auto point = test_util::getRandPoint(10'000);
+        std::vector<uint32_t> ids;
+        const auto stats = layer.queryContaining(point, std::back_inserter(ids));
+
+        std::vector<uint32_t> expectedIds;
+        for (uint32_t id = 0; id < layer.size(); ++id)
+        {
+            if (space::util::contains(layer.polygon(id), point))
+            {
+                expectedIds.push_back(id);
+            }
+        }
+
+        std::ranges::sort(ids);
+        ASSERT_TRUE(ids == expectedIds);
+        ASSERT_EQ(stats.matched, ids.size());
+    }
+}
+
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -11,6 +11,10 @@
 
 
 #include "IndexTestingUtils.h"
+#include "BoundedQueue.h"
+#include "BoxColumns.h"
+#include "InlineStack.h"
+#include "SlabPool.h"
 
 
 TEST(space_QuadTree, QuadTreForFoints)
@@ -44,6 +48,104 @@ TEST(space_QuadTree, QuadTreeRemove)
         1'000, 1'000'000, 1'000'000);
 }
 
+TEST(space_QuadTree, QuadTreeBulkLoad)
+{
+    using value_type = int32_t;
+    test_util::bulkLoadTest<space::QuadTree<space::Rect<value_type>>, value_type, 2'000>(1'000, 1'000, 1'000);
+    test_util::bulkLoadTest<space::QuadTree<space::Rect<value_type>>, value_type, 10'000>(1'000, 1, 1);
+    test_util::bulkLoadTest<space::QuadTree<space::Rect<value_type>>, value_type, 1'000>(
+        1'000, 1'000'000, 1'000'000);
+}
+
+TEST(space_QuadTree, QuadTreeArbitraryOrigin)
+{
+    using value_type = int32_t;
+    using index_type = space::QuadTree<space::Rect<value_type>>;
+    test_util::arbitraryOriginTest<index_type, value_type, 1'000>(index_type {}, {0, 0}, 1'000, 100, 100);
+    test_util::arbitraryOriginTest<index_type, value_type, 1'000>(index_type {}, {-5'000, 7'000}, 1'000, 1, 1);
+    test_util::arbitraryOriginTest<index_type, value_type, 1'000>(
+        index_type {}, {1'000'000'000, -1'000'000'000}, 1'000, 1'000, 1'000);
+    test_util::arbitraryOriginTest<index_type, value_type, 1'000>(
+        index_type {space::Rect<value_type> {{-500, -500}, 1'000, 1'000}}, {0, 0}, 1'000, 100, 100);
+}
+
+TEST(space_QuadTree, QuadTreeCoordinateLimits)
+{
+    using value_type = int32_t;
+    test_util::coordinateLimitsTest<space::QuadTree<space::Rect<value_type>>, value_type, 1'000>(1'000, 1'000);
+    test_util::coordinateLimitsTest<space::QuadTree<space::Rect<value_type>>, value_type, 1'000>(1'000'000'000, 1);
+    test_util::coordinateLimitsTest<space::QuadTree<space::Rect<value_type>, space::LooseQuadTreePolicy>, value_type, 1'000>(
+        1'000, 1'000);
+}
+
+TEST(space_QuadTree, QuadTreeFloatingRange)
+{
+    using value_type = float;
+    test_util::floatingRangeTest<space::QuadTree<space::Rect<value_type>>, value_type, 20'000>(3e7f, 0.0f);
+    test_util::floatingRangeTest<space::QuadTree<space::Rect<value_type>>, value_type, 10'000>(3e7f, 100.0f);
+    test_util::floatingRangeTest<space::QuadTree<space::Rect<value_type>, space::LooseQuadTreePolicy>, value_type, 10'000>(
+        3e7f, 100.0f);
+    test_util::floatingRangeTest<space::QuadTree<space::Rect<double>>, double, 10'000>(1e15, 1.0);
+}
+
+TEST(space_QuadTree, QuadTreeBatchQuery)
+{
+    using value_type = int32_t;
+    test_util::batchQueryTest<space::QuadTree<space::Rect<value_type>>, value_type, 1'000>(1'000, 100, 100);
+    test_util::batchQueryTest<space::QuadTree<space::Rect<value_type>>, value_type, 1'000>(1'000, 1, 1'000);
+    test_util::batchQueryTest<space::QuadTree<space::Rect<value_type>>, value_type, 1'000>(
+        1'000, 1'000'000, 1'000'000);
+}
+
+TEST(space_QuadTree, QuadTreeNearest)
+{
+    using value_type = int32_t;
+    test_util::nearestTest<space::QuadTree<space::Rect<value_type>>, value_type, 1'000>(1'000, 100, 100);
+    test_util::nearestTest<space::QuadTree<space::Rect<value_type>>, value_type, 10'000>(10'000, 1, 1);
+    test_util::nearestTest<space::QuadTree<space::Rect<value_type>>, value_type, 1'000>(1'000, 1'000, 1);
+}
+
+TEST(space_QuadTree, QuadTreeQueryRange)
+{
+    using value_type = int32_t;
+    test_util::queryRangeTest<space::QuadTree<space::Rect<value_type>>, value_type, 1'000>(1'000, 100, 100);
+    test_util::queryRangeTest<space::QuadTree<space::Rect<value_type>>, value_type, 1'000>(1'000, 1, 1'000);
+    test_util::queryRangeTest<space::QuadTree<space::Rect<value_type>>, value_type, 1'000>(
+        1'000, 1'000'000, 1'000'000);
+}
+
+TEST(space_QuadTree, LooseQuadTree)
+{
+    using value_type = int32_t;
+    using index_type = space::QuadTree<space::Rect<value_type>, space::LooseQuadTreePolicy>;
+    test_util::queryTest<index_type, value_type, 10'000>(1'000, 1'000, 1'000);
+    test_util::queryTest<index_type, value_type, 10'000>(1'000, 1, 1);
+    test_util::removeTest<index_type, value_type, 1'000>(1'000, 1, 1'000);
+    test_util::bulkLoadTest<index_type, value_type, 2'000>(1'000, 1'000, 1'000);
+    test_util::nearestTest<index_type, value_type, 1'000>(1'000, 100, 100);
+    test_util::queryRangeTest<index_type, value_type, 1'000>(1'000, 100, 100);
+    test_util::batchQueryTest<index_type, value_type, 1'000>(1'000, 100, 100);
+    test_util::arbitraryOriginTest<index_type, value_type, 1'000>(index_type {}, {-5'000, 7'000}, 1'000, 100, 100);
+}
+
+TEST(space_QuadTree, ColumnarQuadTree)
+{
+    using value_type = int32_t;
+    using index_type = space::QuadTree<space::Rect<value_type>, space::ColumnarQuadTreePolicy>;
+    test_util::queryTest<index_type, value_type, 10'000>(1'000, 1'000, 1'000);
+    test_util::removeTest<index_type, value_type, 1'000>(1'000, 1'000, 1);
+    test_util::bulkLoadTest<index_type, value_type, 2'000>(1'000, 1'000, 1'000);
+    test_util::queryRangeTest<index_type, value_type, 1'000>(1'000, 100, 100);
+    test_util::batchQueryTest<index_type, value_type, 1'000>(1'000, 100, 100);
+}
+
+TEST(space_QuadTree, QuadTreeIndexablePolygons)
+{
+    using value_type = int32_t;
+    test_util::indexablePolygonsTest<value_type, 1'000>(1'000, 100);
+    test_util::indexablePolygonsTest<value_type, 1'000>(1'000'000, 1'000);
+}
+
 TEST(space_QuadTree, QuadTreeActionsOnEmptyTree)
 {
     using value_type = int32_t;
@@ -68,6 +170,311 @@ TEST(space_QuadTree, QuadTreeSize)
     test_util::sizeTest<space::QuadTree<space::Rect<value_type>>, value_type, 10'000>(1'000, 1'000, 1'000);
 }
 
+TEST(space_QuadTree, QuadTreeUpdate)
+{
+    using value_type = int32_t;
+    test_util::updateTest<space::QuadTree<space::Rect<value_type>>, value_type, 2'000>(1'000, 100, 100, 10);
+    test_util::updateTest<space::QuadTree<space::Rect<value_type>>, value_type, 2'000>(100'000, 10, 10, 1'000);
+    test_util::updateTest<space::QuadTree<space::Rect<value_type>, space::LooseQuadTreePolicy>, value_type, 2'000>(
+        1'000, 100, 100, 10);
+    test_util::updateTest<space::QuadTree<space::Rect<value_type>, space::ColumnarQuadTreePolicy>, value_type, 2'000>(
+        1'000, 100, 100, 10);
+}
+
+TEST(space_QuadTree, QuadTreeApplyUpdates)
+{
+    using value_type = int32_t;
+    test_util::applyUpdatesTest<space::QuadTree<space::Rect<value_type>>, value_type, 2'000>(1'000, 100, 100, 10);
+    test_util::applyUpdatesTest<space::QuadTree<space::Rect<value_type>>, value_type, 2'000>(100'000, 10, 10, 1'000);
+    test_util::applyUpdatesTest<space::QuadTree<space::Rect<value_type>, space::LooseQuadTreePolicy>, value_type, 2'000>(
+        1'000, 100, 100, 10);
+    test_util::applyUpdatesTest<space::QuadTree<space::Rect<value_type>, space::ColumnarQuadTreePolicy>, value_type, 2'000>(
+        1'000, 100, 100, 10);
+}
+
+TEST(space_QuadTree, QuadTreePrune)
+{
+    using value_type = int32_t;
+    test_util::pruneTest<space::QuadTree<space::Rect<value_type>>, value_type, 2'000>(1'000, 100, 100);
+    test_util::pruneTest<space::QuadTree<space::Rect<value_type>>, value_type, 2'000>(100'000, 10, 10);
+    test_util::pruneTest<space::QuadTree<space::Rect<value_type>, space::LooseQuadTreePolicy>, value_type, 2'000>(
+        1'000, 100, 100);
+    test_util::pruneTest<space::QuadTree<space::Rect<value_type>, space::ColumnarQuadTreePolicy>, value_type, 2'000>(
+        1'000, 100, 100);
+}
+
+#ifdef SPACE_HAS_MMAP
+TEST(space_QuadTree, QuadTreeSnapshot)
+{
+    using value_type = int32_t;
+    test_util::snapshotTest<space::QuadTree<space::Rect<value_type>>, value_type, 10'000>(1'000, 100, 100);
+    test_util::snapshotTest<space::QuadTree<space::Rect<value_type>>, value_type, 1'000>(1'000, 1'000'000, 1'000'000);
+    test_util::snapshotTest<space::QuadTree<space::Rect<value_type>, space::LooseQuadTreePolicy>, value_type, 10'000>(
+        1'000, 100, 100);
+    test_util::floatingSnapshotTest<space::ResolutionQuadTreePolicy<std::ratio<1, 100>>, float>(500'000.0f, 0.01f);
+}
+#endif // SPACE_HAS_MMAP
+
+TEST(space_QuadTree, ConcurrentQuadTree)
+{
+    using value_type = int32_t;
+    test_util::concurrentTest<space::ConcurrentQuadTree<space::Rect<value_type>>, value_type, 2'000>(1'000, 100, 100);
+    test_util::concurrentTest<space::ConcurrentQuadTree<space::Rect<value_type>>, value_type, 2'000>(100'000, 10, 10);
+    test_util::concurrentTest<space::ConcurrentQuadTree<space::Rect<value_type>, space::LooseQuadTreePolicy>
+        , value_type, 2'000>(1'000, 100, 100);
+}
+
+TEST(space_QuadTree, ShardedQuadTree)
+{
+    using value_type = int32_t;
+    test_util::shardedTest<space::ShardedQuadTree<space::Rect<value_type>>, value_type, 2'000>(1'000, 100, 100);
+    test_util::shardedTest<space::ShardedQuadTree<space::Rect<value_type>, 2>, value_type, 2'000>(100'000, 10, 10);
+    test_util::shardedTest<space::ShardedQuadTree<space::Rect<value_type>, 8, space::LooseQuadTreePolicy>
+        , value_type, 2'000>(1'000, 100, 100);
+    test_util::shardedLimitsTest<space::ShardedQuadTree<space::Rect<value_type>, 3>, value_type, 2'000>(
+        space::Rect<value_type> {{-1'000'000'000, -1'000'000'000}, std::numeric_limits<value_type>::max()
+                                 , std::numeric_limits<value_type>::max()});
+}
+
+TEST(space_QuadTree, LinearQuadTree)
+{
+    using value_type = int32_t;
+    test_util::linearTest<space::DefaultQuadTreePolicy, value_type, 10'000>(1'000, 100, 100);
+    test_util::linearTest<space::DefaultQuadTreePolicy, value_type, 10'000>(100'000, 10, 10);
+    test_util::linearTest<space::LooseQuadTreePolicy, value_type, 10'000>(1'000, 100, 100);
+}
+
+TEST(space_QuadTree, SpatialJoin)
+{
+    using value_type = int32_t;
+    test_util::spatialJoinTest<space::DefaultQuadTreePolicy, space::DefaultQuadTreePolicy, value_type, 2'000>(
+        1'000, 100, 100);
+    test_util::spatialJoinTest<space::DefaultQuadTreePolicy, space::DefaultQuadTreePolicy, value_type, 2'000>(
+        100'000, 1'000, 1'000);
+    test_util::spatialJoinTest<space::LooseQuadTreePolicy, space::ColumnarQuadTreePolicy, value_type, 2'000>(
+        1'000, 100, 100);
+}
+
+TEST(space_QuadTree, QuadTreeStats)
+{
+    using value_type = int32_t;
+    test_util::statsTest<value_type, 2'000>(1'000, 100, 100);
+    test_util::statsTest<value_type, 2'000>(100'000, 10, 10);
+}
+
+TEST(space_QuadTree, BucketQuadTree)
+{
+    using value_type = int32_t;
+    using bucket_policy = space::BucketQuadTreePolicy<8>;
+    using depth_policy = space::BucketQuadTreePolicy<0, 22>;
+    using loose_bucket_policy = space::BucketQuadTreePolicy<16, 24, space::LooseQuadTreePolicy>;
+    test_util::bucketTest<bucket_policy, value_type, 10'000>(100'000, 1, 1);
+    test_util::bucketTest<bucket_policy, value_type, 2'000>(1'000, 100, 100);
+    test_util::bucketTest<space::BucketQuadTreePolicy<1>, value_type, 2'000>(1'000, 10, 10);
+    test_util::bucketTest<depth_policy, value_type, 10'000>(100'000, 1, 1);
+    test_util::bucketTest<loose_bucket_policy, value_type, 2'000>(1'000, 100, 100);
+    test_util::queryTest<space::QuadTree<space::Rect<value_type>, bucket_policy>, value_type, 2'000>(1'000, 100, 100);
+    test_util::removeTest<space::QuadTree<space::Rect<value_type>, bucket_policy>, value_type, 1'000>(1'000, 1, 1'000);
+    test_util::nearestTest<space::QuadTree<space::Rect<value_type>, bucket_policy>, value_type, 1'000>(1'000, 1, 1);
+    test_util::updateTest<space::QuadTree<space::Rect<value_type>, bucket_policy>, value_type, 2'000>(1'000, 100, 100, 10);
+    test_util::applyUpdatesTest<space::QuadTree<space::Rect<value_type>, bucket_policy>, value_type, 2'000>(
+        1'000, 100, 100, 10);
+    test_util::applyUpdatesTest<space::QuadTree<space::Rect<value_type>, depth_policy>, value_type, 2'000>(
+        100'000, 10, 10, 1'000);
+    test_util::pruneTest<space::QuadTree<space::Rect<value_type>, bucket_policy>, value_type, 2'000>(1'000, 100, 100);
+}
+
+TEST(space_QuadTree, FloatingCoordinates)
+{
+    using fine_policy = space::ResolutionQuadTreePolicy<std::ratio<1, 1024>>;
+    using fine_bucket_policy = space::BucketQuadTreePolicy<8, space::DefaultQuadTreePolicy::MaxDepth, fine_policy>;
+    // The projected coordinates in meters, far from the origin.
+    test_util::floatingTest<space::DefaultQuadTreePolicy, double, 10'000>(500'000.0, 10'000.0, 10.0);
+    test_util::floatingTest<space::DefaultQuadTreePolicy, float, 5'000>(0.0f, 1'000.0f, 1.0f);
+    test_util::floatingTest<space::LooseQuadTreePolicy, double, 5'000>(-1'000.0, 2'000.0, 10.0);
+    test_util::floatingTest<space::ColumnarQuadTreePolicy, float, 5'000>(0.0f, 1'000.0f, 10.0f);
+    // The keys smaller than the unit.
+    test_util::floatingTest<fine_policy, double, 5'000>(0.0, 1.0, 0.001);
+    test_util::floatingTest<fine_bucket_policy, double, 5'000>(0.0, 1.0, 0.001);
+
+    // The default resolution is the unit, the finer one splits the unit regions.
+    space::QuadTree<space::Rect<double>> coarseTree;
+    space::QuadTree<space::Rect<double>, fine_policy> fineTree;
+    for (size_t i = 0; i < 1'000; ++i)
+    {
+        const space::Rect<double> point {{0.5 + static_cast<double>(i % 32) / 64, 0.5 + static_cast<double>(i / 32) / 64}, 0, 0};
+        coarseTree.insert(point);
+        fineTree.insert(point);
+    }
+    ASSERT_LT(coarseTree.nodeCount(), 8);
+    ASSERT_LT(coarseTree.nodeCount(), fineTree.nodeCount());
+}
+
+TEST(space_QuadTree, QuadTreeBuilder)
+{
+    using value_type = int32_t;
+    test_util::builderTest<space::DefaultQuadTreePolicy, value_type, 20'000, 4>(100'000, 100, 100, 4'096, 8);
+    // The full queue and the batches of one chunk.
+    test_util::builderTest<space::DefaultQuadTreePolicy, value_type, 5'000, 3>(1'000, 10, 10, 1, 1);
+    test_util::builderTest<space::LooseQuadTreePolicy, value_type, 5'000, 2>(10'000, 1'000, 1'000, 1 << 16, 64);
+    test_util::builderTest<space::BucketQuadTreePolicy<8>, value_type, 5'000, 2>(10'000, 10, 10, 1'000, 4);
+}
+
+TEST(space_QuadTree, QueryCache)
+{
+    using value_type = int32_t;
+    test_util::queryCacheTest<value_type, 10'000>(10'000, 100, 100, 0);
+    test_util::queryCacheTest<value_type, 10'000>(10'000, 100, 100, 256);
+    test_util::queryCacheTest<value_type, 2'000>(1'000, 10, 10, 7);
+}
+
+TEST(space_SlabPool, ReuseReleasedSlots)
+{
+    space::collections::SlabPool<std::vector<int>, 4> pool;
+    const auto first = pool.create(3, 13);
+    const auto second = pool.create(1, 42);
+    ASSERT_EQ(pool.size(), 2);
+    ASSERT_EQ(pool.capacity(), 4);
+    ASSERT_EQ(pool[first], std::vector<int>(3, 13));
+
+    pool.release(first);
+    ASSERT_EQ(pool.size(), 1);
+    ASSERT_EQ(pool.create(), first);
+    ASSERT_TRUE(pool[first].empty());
+    ASSERT_EQ(pool[second], std::vector<int>(1, 42));
+
+    for (int i = 0; i < 3; ++i)
+    {
+        (void)pool.create();
+    }
+    ASSERT_EQ(pool.capacity(), 8);
+
+    pool.clear();
+    ASSERT_TRUE(pool.empty());
+    ASSERT_EQ(pool.capacity(), 0);
+}
+
+TEST(space_BoxColumns, ForEachIntersecting)
+{
+    std::vector<space::Rect<int32_t>> rects;
+    space::collections::BoxColumns<int32_t> columns;
+    for (int i = 0; i < 1'000; ++i)
+    {
+        const auto rect = test_util::getRandRect(1'000, 100, 100);
+        columns.insert(rects.size() / 2, rect);
+        rects.insert(rects.begin() + static_cast<std::ptrdiff_t>(rects.size() / 2), rect);
+    }
+    columns.erase(13);
+    rects.erase(rects.begin() + 13);
+    ASSERT_EQ(columns.size(), rects.size());
+
+    for (int i = 0; i < 100; ++i)
+    {
+        const auto queryRect = test_util::getRandRect(1'000, 100, 100);
+        std::vector<size_t> indexes;
+        columns.forEachIntersecting(queryRect, [&indexes](const size_t index)
+        {
+            indexes.push_back(index);
+            return true;
+        });
+        std::vector<size_t> expectedIndexes;
+        for (size_t index = 0; index < rects.size(); ++index)
+        {
+            if (space::util::hasIntersect(queryRect, rects[index]))
+            {
+                expectedIndexes.push_back(index);
+            }
+        }
+        ASSERT_TRUE(indexes == expectedIndexes);
+    }
+}
+
+TEST(space_BoundedQueue, PushPop)
+{
+    space::collections::BoundedQueue<std::vector<int>> queue {3};
+    ASSERT_EQ(queue.capacity(), 4);
+    ASSERT_FALSE(queue.tryPop());
+    for (int i = 0; i < 4; ++i)
+    {
+        std::vector<int> value(2, i);
+        ASSERT_TRUE(queue.tryPush(value));
+        ASSERT_TRUE(value.empty());
+    }
+    std::vector<int> extra {42};
+    ASSERT_FALSE(queue.tryPush(extra));
+    ASSERT_EQ(extra, std::vector<int> {42});
+    for (int i = 0; i < 4; ++i)
+    {
+        ASSERT_EQ(queue.tryPop(), std::vector<int>(2, i));
+    }
+    ASSERT_FALSE(queue.tryPop());
+    ASSERT_EQ(space::collections::BoundedQueue<int> {1}.capacity(), 2);
+    ASSERT_THROW(space::collections::BoundedQueue<int> {0}, std::invalid_argument);
+}
+
+TEST(space_BoundedQueue, ConcurrentPushPop)
+{
+    constexpr int producerCount = 4;
+    constexpr int valueCount = 50'000;
+    space::collections::BoundedQueue<int> queue {16};
+    std::atomic<long long> poppedSum {0};
+    std::atomic<int> poppedCount {0};
+    std::vector<std::thread> threads;
+    for (int producer = 0; producer < producerCount; ++producer)
+    {
+        threads.emplace_back([&queue]()
+        {
+            for (int i = 1; i <= valueCount; ++i)
+            {
+                for (int value = i; !queue.tryPush(value);)
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        threads.emplace_back([&queue, &poppedSum, &poppedCount]()
+        {
+            while (poppedCount.load() < producerCount * valueCount)
+            {
+                if (const auto value = queue.tryPop())
+                {
+                    poppedSum += *value;
+                    ++poppedCount;
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    ASSERT_EQ(poppedCount.load(), producerCount * valueCount);
+    ASSERT_EQ(poppedSum.load(), producerCount * (static_cast<long long>(valueCount) * (valueCount + 1) / 2));
+    ASSERT_FALSE(queue.tryPop());
+}
+
+TEST(space_InlineStack, PushPop)
+{
+    space::collections::InlineStack<int, 4> stack;
+    ASSERT_TRUE(stack.empty());
+    ASSERT_EQ(stack.capacity(), 4);
+    for (int i = 0; i < 4; ++i)
+    {
+        stack.push(i);
+    }
+    ASSERT_EQ(stack.size(), 4);
+    for (int i = 3; i >= 0; --i)
+    {
+        ASSERT_EQ(stack.top(), i);
+        stack.pop();
+    }
+    ASSERT_TRUE(stack.empty());
+}
+
 
 int main(int argc, char **argv)
 {
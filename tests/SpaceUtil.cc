@@ -9,6 +9,7 @@
 
 #include <thread>
 #include <future>
+#include <execution>
 
 #include <gtest/gtest.h>
 
@@ -19,13 +20,19 @@
 #include <boost/geometry/geometries/polygon.hpp>
 
 #include <boost/geometry/index/rtree.hpp>
+#include <boost/geometry/algorithms/correct.hpp>
+#include <boost/geometry/algorithms/covered_by.hpp>
+#include <boost/geometry/algorithms/intersects.hpp>
 
 
 #include "Rect.h"
 #include "Square.h"
 #include "SimplePolygon.h"
 #include "Polygon.h"
+#include "PreparedPolygon.h"
+#include "EdgeBands.h"
 #include "Segment.h"
+#include "SegmentSweep.h"
 #include "Utility.h"
 
 
@@ -81,6 +88,46 @@ space::SimplePolygon<TCrt> randomPolygon()
 }
 
 
+template<typename TCrt>
+space::SimplePolygon<TCrt> randomStarPolygon(size_t numOfVertex, TCrt centerX, TCrt centerY, TCrt maxRadius)
+{
+    using Poly = space::SimplePolygon<TCrt>;
+
+    typename Poly::TPiecewiseLinearCurve boundary;
+    for (size_t i = numOfVertex; i > 0; --i)
+    {
+        const auto angle = 2 * M_PI * static_cast<double>(i) / static_cast<double>(numOfVertex);
+        const auto radius = static_cast<double>(maxRadius / 2 + std::rand() % (maxRadius / 2));
+        boundary.push_back(space::Point<TCrt>{centerX + static_cast<TCrt>(radius * std::cos(angle))
+                                              , centerY + static_cast<TCrt>(radius * std::sin(angle))});
+    }
+    return Poly {boundary};
+}
+
+
+template<typename TCrt>
+space::SimplePolygon<TCrt> randomConvexPolygon(size_t numOfVertex, TCrt centerX, TCrt centerY, TCrt maxRadius)
+{
+    using Poly = space::SimplePolygon<TCrt>;
+
+    std::vector<double> angles;
+    for (size_t i = 0; i < numOfVertex; ++i)
+    {
+        angles.push_back(2 * M_PI * (std::rand() % 3600) / 3600.0);
+    }
+    std::ranges::sort(angles, std::ranges::greater {});
+
+    const auto radius = static_cast<double>(1 + std::rand() % maxRadius);
+    typename Poly::TPiecewiseLinearCurve boundary;
+    for (const auto angle : angles)
+    {
+        boundary.push_back(space::Point<TCrt>{centerX + static_cast<TCrt>(radius * std::cos(angle))
+                                              , centerY + static_cast<TCrt>(radius * std::sin(angle))});
+    }
+    return Poly {boundary};
+}
+
+
 template<typename TCrt>
 typename boost::geometry::model::polygon<boost::geometry::model::point<TCrt, 2, boost::geometry::cs::cartesian>> 
     spacePolygonToBoostPolygon(const space::SimplePolygon<TCrt>& spacePoly)
@@ -166,6 +213,18 @@ TEST(space_util, CoverSquare)
     ASSERT_FALSE (space::util::contains(rect1, rect2));
 }
 
+TEST(space_util, DistanceRectPoint)
+{
+    space::Rect<int32_t> rect {{10, 10}, 20, 10};
+    ASSERT_EQ(space::util::distance(rect, space::Point {15, 15}), 0);
+    ASSERT_EQ(space::util::distance(rect, space::Point {30, 20}), 0);
+    ASSERT_EQ(space::util::distance(rect, space::Point {5, 15}), 5);
+    ASSERT_EQ(space::util::distance(rect, space::Point {15, 27}), 7);
+    ASSERT_EQ(space::util::distance(rect, space::Point {33, 24}), 5);
+    ASSERT_EQ(space::util::squaredDistance(rect, space::Point {7, 6}), 25);
+    ASSERT_EQ(space::util::distance(space::Square<int32_t> {{0, 0}, 10}, space::Point {-3, -4}), 5);
+}
+
 TEST(space_util, IntersectsRect)
 {
     space::Rect<int32_t> rect {{50, 13}, 100, 100};
@@ -288,6 +347,8 @@ TEST(space_SimplePolygon, BoundaryBoxOfSimplePolygon)
     Poly poly {boundary};
     const auto bBox = space::util::boundaryBoxOf(poly);
     ASSERT_TRUE((bBox == Rect {{0,   0}, {124, 444}}));
+    Poly triangle {Poly::TPiecewiseLinearCurve {{0, 5}, {1, 0}, {2, 3}}};
+    ASSERT_TRUE((space::util::boundaryBoxOf(triangle) == Rect {{0, 0}, {2, 5}}));
 }
 
 TEST(space_SimplePolygon, CompareSimplePolygon)
@@ -437,6 +498,132 @@ TEST(space_SimplePolygon, hasIntersectComplex)
     }
 }
 
+TEST(space_PreparedSimplePolygon, ContainsPreparedSimplePolygon)
+{
+    using Poly = space::SimplePolygon<int32_t>;
+    using Bound = Poly::TPiecewiseLinearCurve;
+
+    const Poly poly {Bound{{2, 1}, {3, 5}, {5, 6}, {10, 6}, {12, 5}, {12, 3}, {10, 1}}};
+    const space::PreparedSimplePolygon<int32_t> prepared {poly};
+
+    ASSERT_EQ(space::util::boundaryBoxOf(prepared), space::util::boundaryBoxOf(poly));
+    ASSERT_EQ(prepared.isConvex(), space::util::isConvex(poly));
+    for (int32_t x = -2; x < 16; ++x)
+    {
+        for (int32_t y = -2; y < 10; ++y)
+        {
+            ASSERT_EQ(space::util::contains(prepared, {x, y}), space::util::contains(poly, {x, y}));
+        }
+    }
+}
+
+
+TEST(space_PreparedSimplePolygon, hasIntersectPreparedSimplePolygon)
+{
+    for (int64_t i = 0; i < 100'000; ++i)
+    {
+        space::Rect<int32_t> spaceRect1 {{std::rand() % 1000, std::rand() % 1000}, std::rand() % 1000,
+                                         std::rand() % 1000};
+        space::Rect<int32_t> spaceRect2 {{std::rand() % 1000, std::rand() % 1000}, std::rand() % 1000,
+                                         std::rand() % 1000};
+        const space::PreparedSimplePolygon<int32_t> prepared1 {rectToPolygon(spaceRect1)};
+        const space::PreparedSimplePolygon<int32_t> prepared2 {rectToPolygon(spaceRect2)};
+        ASSERT_TRUE(space::util::hasIntersect(prepared1, prepared2)
+                == boost::geometry::intersects(spaceToBoostRect(spaceRect1), spaceToBoostRect(spaceRect2)));
+    }
+
+    for (int64_t i = 0; i < 10'000; ++i)
+    {
+        const auto spacePoly = randomPolygon<int32_t>();
+        const auto spacePoly1 = randomPolygon<int32_t>();
+        const space::PreparedSimplePolygon<int32_t> prepared {spacePoly};
+        const space::PreparedSimplePolygon<int32_t> prepared1 {spacePoly1};
+
+        ASSERT_TRUE(space::util::hasIntersect(prepared, prepared));
+        ASSERT_TRUE(space::util::hasIntersect(prepared, prepared1)
+            == (space::util::hasIntersect(spacePoly, spacePoly1)
+                && space::util::hasIntersect(space::util::boundaryBoxOf(spacePoly), space::util::boundaryBoxOf(spacePoly1))));
+    }
+}
+
+
+TEST(space_SimplePolygon, IsConvexSimplePolygon)
+{
+    using Poly = space::SimplePolygon<int32_t>;
+    using Bound = Poly::TPiecewiseLinearCurve;
+
+    ASSERT_TRUE(space::util::isConvex(Poly {Bound {{0, 0}, {0, 10}, {10, 10}, {10, 0}}}));
+    ASSERT_TRUE(space::util::isConvex(Poly {Bound {{0, 0}, {10, 0}, {10, 10}, {0, 10}}}));
+    ASSERT_TRUE(space::util::isConvex(Poly {Bound {{0, 0}, {0, 5}, {0, 10}, {10, 10}, {10, 10}, {10, 0}}}));
+    ASSERT_TRUE(space::util::isConvex(Poly {Bound {{0, 0}, {5, 5}, {5, 0}}}));
+    ASSERT_FALSE(space::util::isConvex(Poly {Bound {{0, 0}, {0, 10}, {5, 5}, {10, 10}, {10, 0}}}));
+    ASSERT_FALSE(space::util::isConvex(Poly {Bound {{0, 0}, {5, 5}, {10, 10}}}));
+    ASSERT_FALSE(space::util::isConvex(Poly {Bound {{0, 0}, {10, 0}}}));
+    ASSERT_FALSE(space::util::isConvex(Poly {Bound {{0, 0}, {4, 10}, {8, 0}, {-2, 6}, {10, 6}}}));
+    ASSERT_FALSE(space::util::isConvex(Poly {}));
+}
+
+
+TEST(space_SimplePolygon, hasIntersectConvexSimplePolygon)
+{
+    for (int64_t i = 0; i < 20'000; ++i)
+    {
+        auto spacePoly = randomConvexPolygon<int32_t>(3 + std::rand() % 12, std::rand() % 1000, std::rand() % 1000, 300);
+        auto spacePoly1 = randomConvexPolygon<int32_t>(3 + std::rand() % 12, std::rand() % 1000, std::rand() % 1000, 300);
+        if (!space::util::isConvex(spacePoly) || !space::util::isConvex(spacePoly1))
+        {
+            continue;
+        }
+        if (i % 2 == 0)
+        {
+            std::ranges::reverse(spacePoly.boundaryCurve());
+        }
+
+        auto boostPoly = spacePolygonToBoostPolygon(spacePoly);
+        auto boostPoly1 = spacePolygonToBoostPolygon(spacePoly1);
+        boost::geometry::correct(boostPoly);
+        boost::geometry::correct(boostPoly1);
+
+        const space::PreparedSimplePolygon<int32_t> prepared {spacePoly};
+        const space::PreparedSimplePolygon<int32_t> prepared1 {spacePoly1};
+        ASSERT_TRUE(prepared.isConvex() && prepared1.isConvex());
+
+        const auto expected = boost::geometry::intersects(boostPoly, boostPoly1);
+        ASSERT_EQ(space::util::hasIntersect(spacePoly, spacePoly1), expected);
+        ASSERT_EQ(space::util::hasIntersect(spacePoly1, spacePoly), expected);
+        ASSERT_EQ(space::util::hasIntersect(prepared, prepared1), expected);
+    }
+}
+
+
+TEST(space_SimplePolygon, hasIntersectConcaveSimplePolygon)
+{
+    for (int64_t i = 0; i < 2'000; ++i)
+    {
+        const auto spacePoly = randomStarPolygon<int32_t>(5 + std::rand() % 40, std::rand() % 1000, std::rand() % 1000, 300);
+        const auto spacePoly1 = i % 2 == 0
+            ? randomStarPolygon<int32_t>(5 + std::rand() % 40, std::rand() % 1000, std::rand() % 1000, 300)
+            : randomConvexPolygon<int32_t>(3 + std::rand() % 12, std::rand() % 1000, std::rand() % 1000, 300);
+
+        auto boostPoly = spacePolygonToBoostPolygon(spacePoly);
+        auto boostPoly1 = spacePolygonToBoostPolygon(spacePoly1);
+        boost::geometry::correct(boostPoly);
+        boost::geometry::correct(boostPoly1);
+
+        const auto expected = boost::geometry::intersects(boostPoly, boostPoly1);
+        ASSERT_EQ(space::util::hasIntersect(spacePoly, spacePoly1), expected);
+        ASSERT_EQ(space::util::hasIntersect(space::PreparedSimplePolygon<int32_t> {spacePoly}
+                                            , space::PreparedSimplePolygon<int32_t> {spacePoly1}), expected);
+    }
+
+    using Poly = space::SimplePolygon<int32_t>;
+    using Bound = Poly::TPiecewiseLinearCurve;
+    const Poly outer {Bound {{0, 0}, {0, 100}, {50, 50}, {100, 100}, {100, 0}}};
+    ASSERT_TRUE(space::util::hasIntersect(outer, Poly {Bound {{10, 10}, {10, 20}, {20, 20}, {20, 10}}}));
+    ASSERT_FALSE(space::util::hasIntersect(outer, Poly {Bound {{45, 70}, {50, 80}, {55, 70}}}));
+}
+
+
 TEST(space_Polygon, EmptyPolygon)
 {
     using Poly = space::Polygon<int32_t>;
@@ -644,6 +831,129 @@ TEST(space_Polygon, ContainsPolygonVertexContains)
     }
 }
 
+TEST(space_EdgeBands, ContainsEdgeBands)
+{
+    for (int i = 0; i < 20; ++i)
+    {
+        const auto poly = randomStarPolygon<int32_t>(500, 500, 500, 400);
+        const space::EdgeBands<int32_t> bands {poly};
+        auto boostPoly = spacePolygonToBoostPolygon(poly);
+        boost::geometry::correct(boostPoly);
+
+        ASSERT_LE(bands.bandCount(), 500);
+        for (int32_t x = 0; x < 1000; x += 7)
+        {
+            for (int32_t y = 0; y < 1000; y += 3)
+            {
+                const auto boostPoint = boost::geometry::model::point<int32_t, 2, boost::geometry::cs::cartesian>(x, y);
+                ASSERT_EQ(bands.contains({x, y}), boost::geometry::covered_by(boostPoint, boostPoly));
+                ASSERT_EQ(bands.contains({x, y}), space::util::contains(poly, {x, y}));
+            }
+        }
+        for (const auto& vertex : poly.boundaryCurve())
+        {
+            ASSERT_TRUE(bands.contains(vertex));
+        }
+    }
+}
+
+TEST(space_PreparedPolygon, ContainsLargePreparedPolygon)
+{
+    using Poly = space::Polygon<int32_t>;
+
+    space::collections::Vector<Poly::TSimplePolygon> holes;
+    holes.push_back(randomStarPolygon<int32_t>(200, 500, 500, 100));
+    const Poly poly {randomStarPolygon<int32_t>(1'000, 500, 500, 400), holes};
+    const space::PreparedPolygon<int32_t> prepared {poly};
+
+    ASSERT_TRUE(prepared.boundary().edgeBands());
+    ASSERT_TRUE(prepared.holes()[0].edgeBands());
+    for (int32_t x = 0; x < 1000; x += 3)
+    {
+        for (int32_t y = 0; y < 1000; y += 3)
+        {
+            ASSERT_EQ(space::util::contains(prepared, {x, y}), space::util::contains(poly, {x, y}));
+        }
+    }
+}
+
+TEST(space_SimplePolygon, ContainsBatchSimplePolygon)
+{
+    for (int i = 0; i < 100; ++i)
+    {
+        const auto poly = i % 2 == 0 ? randomPolygon<int32_t>() : randomStarPolygon<int32_t>(100, 500, 500, 400);
+
+        std::vector<space::Point<int32_t>> points;
+        for (int j = 0; j < 1'000; ++j)
+        {
+            points.push_back({std::rand() % 1200 - 100, std::rand() % 1200 - 100});
+        }
+        std::ranges::copy(poly.boundaryCurve(), std::back_inserter(points));
+
+        std::vector<std::uint8_t> results(std::size(points));
+        space::util::containsBatch<int32_t>(poly, points, results);
+        for (size_t j = 0; j < std::size(points); ++j)
+        {
+            ASSERT_EQ(results[j] != 0, space::util::contains(poly, points[j]));
+        }
+    }
+
+    std::vector<std::uint8_t> results(1);
+    std::vector<space::Point<int32_t>> points(2);
+    ASSERT_THROW(space::util::containsBatch<int32_t>(randomPolygon<int32_t>(), points, results), std::out_of_range);
+}
+
+TEST(space_Polygon, ContainsBatchPolygon)
+{
+    using Poly = space::Polygon<int32_t>;
+
+    space::collections::Vector<Poly::TSimplePolygon> holes;
+    holes.push_back(randomStarPolygon<int32_t>(50, 400, 400, 100));
+    holes.push_back(randomStarPolygon<int32_t>(50, 600, 600, 100));
+    const Poly poly {randomStarPolygon<int32_t>(300, 500, 500, 400), holes};
+
+    std::vector<space::Point<int32_t>> points;
+    for (int32_t x = 0; x < 1000; x += 3)
+    {
+        for (int32_t y = 0; y < 1000; y += 3)
+        {
+            points.push_back({x, y});
+        }
+    }
+
+    std::vector<std::uint8_t> results(std::size(points));
+    space::util::containsBatch<int32_t>(poly, points, results);
+    for (size_t j = 0; j < std::size(points); ++j)
+    {
+        ASSERT_EQ(results[j] != 0, space::util::contains(poly, points[j]));
+    }
+}
+
+TEST(space_PreparedPolygon, ContainsPreparedPolygon)
+{
+    using Poly = space::Polygon<int32_t>;
+    using SimplePoly = Poly::TSimplePolygon;
+
+    SimplePoly boundary {{{2, 1}, {3, 5}, {5, 6}, {10, 6}, {12, 5}, {12, 3}, {10, 1}}};
+
+    space::collections::Vector<SimplePoly> holes;
+    holes.push_back(SimplePoly {{{4, 3}, {5, 5}, {7, 4}, { 6, 2 }}});
+    holes.push_back(SimplePoly {{{9, 2}, {9, 3}, {11, 5}, { 11, 4 }}});
+
+    const Poly poly {boundary, holes};
+    const space::PreparedPolygon<int32_t> prepared {poly};
+
+    ASSERT_EQ(std::size(prepared.holes()), 2);
+    ASSERT_EQ(space::util::boundaryBoxOf(prepared), space::util::boundaryBoxOf(poly));
+    for (int32_t x = -2; x < 16; ++x)
+    {
+        for (int32_t y = -2; y < 10; ++y)
+        {
+            ASSERT_EQ(space::util::contains(prepared, {x, y}), space::util::contains(poly, {x, y}));
+        }
+    }
+}
+
 TEST(space_Segment, SimpleSegment)
 {
     using Point = space::Point<int32_t>;
@@ -696,6 +1006,54 @@ TEST(space_Segment, hasIntersectSimpleSegment)
     ASSERT_TRUE(space::util::hasIntersect(segment, segment2));
 }
 
+TEST(space_Segment, hasIntersectLargeCoordinatesSegment)
+{
+    using Point = space::Point<int32_t>;
+    using Segment = space::Segment<int32_t>;
+
+    constexpr int32_t bound = 1'000'000'000;
+
+    ASSERT_TRUE(space::util::hasIntersect(Segment {Point {-bound, -bound}, Point {bound, bound}}
+                                          , Segment {Point {-bound, bound}, Point {bound, -bound}}));
+    ASSERT_FALSE(space::util::hasIntersect(Segment {Point {-bound, -bound}, Point {bound, bound}}
+                                           , Segment {Point {-bound, -bound + 1}, Point {bound - 1, bound}}));
+    ASSERT_EQ(space::util::impl::orientation(Point {-bound, -bound}, Point {bound, bound}, Point {bound - 1, bound})
+              , space::util::impl::orientation(space::Point<int64_t> {-bound, -bound}, space::Point<int64_t> {bound, bound}
+                                               , space::Point<int64_t> {bound - 1, bound}));
+
+    constexpr int64_t bound64 = 1'000'000'000'000'000'000;
+    using Point64 = space::Point<int64_t>;
+    ASSERT_EQ(space::util::impl::orientation(Point64 {-bound64, -bound64}, Point64 {bound64, bound64}, Point64 {bound64, bound64 - 1})
+              , space::util::impl::EOrientation::clockwise);
+    ASSERT_EQ(space::util::impl::orientation(Point64 {-bound64, -bound64}, Point64 {0, 0}, Point64 {bound64, bound64})
+              , space::util::impl::EOrientation::collinear);
+
+    using PointD = space::Point<double>;
+    ASSERT_EQ(space::util::impl::orientation(PointD {0.5, 0.5}, PointD {12.0, 12.0}, PointD {24.0, 24.0})
+              , space::util::impl::EOrientation::collinear);
+    ASSERT_NE(space::util::impl::orientation(PointD {0.5, 0.5}, PointD {12.0, 12.0}, PointD {24.0, 24.000000000000004})
+              , space::util::impl::EOrientation::collinear);
+}
+
+TEST(space_SimplePolygon, LargeCoordinatesSimplePolygon)
+{
+    using Poly = space::SimplePolygon<int32_t>;
+    using Bound = Poly::TPiecewiseLinearCurve;
+
+    constexpr int32_t bound = 1'000'000'000;
+    const Poly square {Bound {{-bound, -bound}, {-bound, bound}, {bound, bound}, {bound, -bound}}};
+    const Poly diamond {Bound {{0, -bound}, {-bound, 0}, {0, bound}, {bound, 0}}};
+
+    ASSERT_TRUE(space::util::contains(square, {0, 0}));
+    ASSERT_TRUE(space::util::contains(square, {bound, 0}));
+    ASSERT_TRUE(space::util::contains(diamond, {bound / 2, bound / 2}));
+    ASSERT_FALSE(space::util::contains(diamond, {bound / 2 + 1, bound / 2}));
+    ASSERT_TRUE(space::util::hasIntersect(square, diamond));
+
+    ASSERT_EQ(space::util::dotProduct(space::Vector<int32_t> {bound, bound}, space::Vector<int32_t> {bound, bound})
+              , 2 * static_cast<int64_t>(bound) * bound);
+}
+
 TEST(space_Segment, hasIntersect_Segment)
 {
     using SPoint = space::Point<int32_t>;
@@ -721,6 +1079,124 @@ TEST(space_Segment, hasIntersect_Segment)
 }
 
 
+TEST(space_Segment, IntersectingPairsSegment)
+{
+    using SPoint = space::Point<int32_t>;
+    using SSegment = space::Segment<int32_t>;
+    using TPair = std::pair<std::size_t, std::size_t>;
+
+    for (int32_t i = 0; i < 200; ++i)
+    {
+        std::vector<SSegment> segments;
+        const auto count = rand(0, 300);
+        const auto length = rand(1, 100);
+        for (int32_t j = 0; j < count; ++j)
+        {
+            const SPoint p {rand(0, 1000), rand(0, 1000)};
+            segments.push_back(SSegment {p, SPoint {p.x() + rand(-length, length), p.y() + rand(-length, length)}});
+        }
+
+        std::vector<TPair> expected;
+        for (std::size_t first = 0; first < std::size(segments); ++first)
+        {
+            for (std::size_t second = first + 1; second < std::size(segments); ++second)
+            {
+                if (space::util::hasIntersect(segments[first], segments[second]))
+                {
+                    expected.emplace_back(first, second);
+                }
+            }
+        }
+
+        std::vector<TPair> pairs;
+        space::util::intersectingPairs(space::collections::Span<const SSegment> {segments}, std::back_inserter(pairs));
+        std::ranges::sort(pairs);
+        ASSERT_EQ(expected, pairs);
+
+        auto parallelPairs = space::util::intersectingPairs(std::execution::par
+                                                            , space::collections::Span<const SSegment> {segments}
+                                                            , static_cast<std::size_t>(rand(1, 16)));
+        std::ranges::sort(parallelPairs);
+        ASSERT_EQ(expected, parallelPairs);
+
+        ASSERT_EQ(!expected.empty(), space::util::hasAnyIntersect(space::collections::Span<const SSegment> {segments}));
+    }
+}
+
+
+TEST(space_Segment, HasAnyIntersectSegment)
+{
+    using SPoint = space::Point<int32_t>;
+    using SSegment = space::Segment<int32_t>;
+
+    for (int32_t i = 0; i < 20'000; ++i)
+    {
+        std::vector<SSegment> segments;
+        const auto count = rand(1, 6);
+        for (int32_t j = 0; j < count; ++j)
+        {
+            segments.push_back(SSegment {SPoint {rand(0, 10), rand(0, 10)}, SPoint {rand(0, 10), rand(0, 10)}});
+        }
+
+        bool expected = false;
+        for (std::size_t first = 0; first < std::size(segments); ++first)
+        {
+            for (std::size_t second = first + 1; second < std::size(segments); ++second)
+            {
+                expected = expected || space::util::hasIntersect(segments[first], segments[second]);
+            }
+        }
+        ASSERT_EQ(expected, space::util::hasAnyIntersect(space::collections::Span<const SSegment> {segments}));
+    }
+}
+
+
+TEST(space_SimplePolygon, IsSimpleSimplePolygon)
+{
+    using SPoint = space::Point<int32_t>;
+    using Poly = space::SimplePolygon<int32_t>;
+
+    ASSERT_FALSE(space::util::isSimple(Poly {}));
+    ASSERT_TRUE(space::util::isSimple(Poly {{SPoint {0, 0}, SPoint {0, 10}, SPoint {10, 10}, SPoint {10, 0}}}));
+    ASSERT_TRUE(space::util::isSimple(Poly {{SPoint {0, 0}, SPoint {0, 5}, SPoint {0, 10}, SPoint {10, 0}}}));
+    ASSERT_FALSE(space::util::isSimple(Poly {{SPoint {0, 0}, SPoint {10, 10}, SPoint {0, 10}, SPoint {10, 0}}}));
+    ASSERT_FALSE(space::util::isSimple(Poly {{SPoint {0, 0}, SPoint {0, 10}, SPoint {0, 5}, SPoint {10, 0}}}));
+    ASSERT_FALSE(space::util::isSimple(Poly {{SPoint {0, 0}, SPoint {0, 10}, SPoint {10, 10}, SPoint {10, 10}}}));
+
+    for (int32_t i = 0; i < 1'000; ++i)
+    {
+        const auto star = randomStarPolygon<int32_t>(static_cast<size_t>(rand(3, 200)), 5000, 5000, 4000);
+        const auto poly = (i % 2 == 0) ? star : randomPolygon<int32_t>();
+        const auto& curve = poly.boundaryCurve();
+        const auto n = std::size(curve);
+
+        bool expected = n >= 3;
+        for (std::size_t first = 0; expected && first < n; ++first)
+        {
+            const space::Segment<int32_t> firstEdge {curve[first], curve[(first + 1) % n]};
+            for (std::size_t second = first + 1; expected && second < n; ++second)
+            {
+                const space::Segment<int32_t> secondEdge {curve[second], curve[(second + 1) % n]};
+                const bool isAdjacent = (second == first + 1) || (0 == first && second == n - 1);
+                if (!isAdjacent)
+                {
+                    expected = !space::util::hasIntersect(firstEdge, secondEdge);
+                    continue;
+                }
+                // The adjacent edges must have only the common vertex.
+                const auto& shared = (second == first + 1) ? curve[second] : curve[first];
+                const auto& firstOther = (firstEdge.first == shared) ? firstEdge.second : firstEdge.first;
+                const auto& secondOther = (secondEdge.first == shared) ? secondEdge.second : secondEdge.first;
+                expected = firstOther != shared && secondOther != shared
+                    && !space::util::hasIntersect(space::Segment<int32_t> {firstOther, firstOther}, secondEdge)
+                    && !space::util::hasIntersect(space::Segment<int32_t> {secondOther, secondOther}, firstEdge);
+            }
+        }
+        ASSERT_EQ(expected, space::util::isSimple(poly)) << i;
+    }
+}
+
+
 int main(int argc, char **argv)
 {
     testing::InitGoogleTest(&argc, argv);